@@ -16,6 +16,8 @@
 //
 
 using System;
+using System.Collections.Generic;
+using System.Diagnostics;
 using System.IO;
 using System.Linq;
 using System.Reflection;
@@ -28,6 +30,7 @@ using NLog;
 using NLog.Fluent;
 
 using Renfrew.Core.Properties;
+using Renfrew.Win32.Interop;
 
 using Application = System.Windows.Forms.Application;
 
@@ -40,11 +43,18 @@ namespace Renfrew.Core {
 
       private static CoreApplication _instance;
 
+      // Bounds (in ms) of the back-off used while waiting for a Dragon profile.
+      private const Int32 MinProfilePollDelay = 5;
+      private const Int32 MaxProfilePollDelay = 2000;
+
       // Main interface to dragon
       private NatSpeakService _natSpeakService;
 
       private IGrammarService _grammarService;
 
+      // The grammars that were initialized, disposed of on exit
+      private readonly List<IDisposable> _grammars = new List<IDisposable>();
+
       // System tray icon and menu
       private NotifyIcon _notifyIcon;
       private ContextMenuStrip _contextMenuStrip;
@@ -86,12 +96,34 @@ namespace Renfrew.Core {
          _contextMenuStrip.Items.Add("&Show Console", null, delegate(Object sender, EventArgs e) {
             ShowConsole();
          });
+
+         // Record injected mouse input, for looking into gesture timing.
+         if (Settings.Default.InputTraceCapacity > 0) {
+            InputTrace.Start(Settings.Default.InputTraceCapacity);
+
+            _contextMenuStrip.Items.Add("Save &Input Trace", null, delegate(Object sender, EventArgs e) {
+               SaveInputTrace();
+            });
+         }
          _contextMenuStrip.Items.Add("-");
          _contextMenuStrip.Items.Add("E&xit Mouse Plot", null, OnApplicationExit);
 
          _notifyIcon.Visible = true;
       }
 
+      private void SaveInputTrace() {
+         var path = Path.Combine(
+            Path.GetTempPath(), $"MousePlot {DateTime.Now:yyyy-MM-dd HH-mm-ss}.trace"
+         );
+
+         try {
+            var count = InputTrace.Save(path);
+            _logger.Info($"Saved {count} input events to '{path}'.");
+         } catch (Exception e) {
+            _logger.Error(e, "Could not save input trace.");
+         }
+      }
+
       public static CoreApplication Instance => _instance ?? (_instance = new CoreApplication());
 
       #endregion
@@ -103,6 +135,8 @@ namespace Renfrew.Core {
 
          _notifyIcon.Visible = false;
 
+         DisposeGrammars();
+
          CloseConsole();
 
          Application.Exit();
@@ -114,41 +148,64 @@ namespace Renfrew.Core {
       public void Stop() {
          OnApplicationExit();
       }
+
+      private void DisposeGrammars() {
+         foreach (var grammar in _grammars) {
+            try {
+               grammar.Dispose();
+            } catch (Exception e) {
+               _logger.Warn(e, $"Could not dispose of grammar '{grammar}'.");
+            }
+         }
+
+         _grammars.Clear();
+      }
       #endregion
 
-      private void InitializeGrammarsFromAssembly(Assembly assembly) {
+      private IEnumerable<GrammarManifestEntry> GetExportedGrammars(Assembly assembly) {
+         var manifestPath = GrammarManifest.GetManifestPath(assembly);
+         var manifest = GrammarManifest.Load(manifestPath);
+
+         // Prefer the manifest generated at build time, as long as it was
+         // generated from this build of the assembly.
+         if (manifest != null && manifest.IsCurrentFor(assembly) == true) {
+            _logger.Debug($"Using grammar manifest '{manifestPath}'.");
+            return manifest.Entries;
+         }
 
-         // Get a list of all of the classes marked with the GrammarExportAttribute.
-         var types = assembly.GetTypes()
-            .Select(e => new {
-               Type = e,
-               Attr = e.GetCustomAttributes<GrammarExportAttribute>().FirstOrDefault()
-            }).Where(e => e.Attr != null && e.Type.IsClass).ToList();
+         _logger.Info(
+            $"Grammar manifest for {Path.GetFileName(assembly.Location)} is " +
+            $"{(manifest == null ? "missing" : "out of date")}. Scanning assembly instead."
+         );
+
+         return GrammarManifest.FromAssembly(assembly).Entries;
+      }
+
+      private void InitializeGrammarsFromAssembly(Assembly assembly) {
+         var entries = GetExportedGrammars(assembly).ToList();
 
-         _logger.Info($"Found {types.Count} grammars in assembly.");
+         _logger.Info($"Found {entries.Count} grammars in assembly.");
 
-         // Enumerate the available types in the assembly.
-         foreach (var type in types) {
-            var a = type.Attr;
+         var loads = new List<GrammarLoadInfo>();
+         var total = Stopwatch.StartNew();
 
-            // Make sure the class extends from the Grammar base class.
-            if (type.Type.IsSubclassOf(typeof(Grammar)) == false) {
-               var fileName = Path.GetFileName(assembly.Location);
+         foreach (var entry in entries) {
+            var factory = entry.CreateFactory(assembly);
 
+            if (factory == null) {
                _logger.Warn(
-                  $"Class '{type.Type.FullName}' in {fileName} marked as exported grammar, " +
-                  $"but it does not extend {typeof(Grammar).FullName}. Ignoring."
+                  $"Grammar '{entry.Name}' ({entry.TypeName}) could not be found in " +
+                  $"{Path.GetFileName(assembly.Location)}, or can't be created. Ignoring."
                );
 
                continue;
             }
 
-            _logger.Info($"Initializing '{a.Name}'.");
+            _logger.Info($"Initializing '{entry.Name}'.");
 
             // TODO: Find a way to break a grammar's dependency on NatSpeakInterop
-            var grammar = (Grammar) Activator.CreateInstance(
-               type.Type, _grammarService
-            );
+            var grammar = factory(_grammarService);
+            var stopwatch = Stopwatch.StartNew();
 
             try {
                grammar.Initialize();
@@ -160,10 +217,41 @@ namespace Renfrew.Core {
                continue;
             }
 
-            _logger.Info($"Grammar, '{a.Name}', initialized.");
+            _grammars.Add(grammar);
+
+            var loadInfo = _grammarService.GetLoadInfo(grammar);
+
+            _logger.Info(
+               $"Grammar, '{entry.Name}', initialized in {stopwatch.ElapsedMilliseconds} ms " +
+               $"({loadInfo?.ToString() ?? "loads on demand"})."
+            );
             _logger.Debug($"Grammar's words: {String.Join(", ", grammar.WordIds.Keys)}");
 
+            if (loadInfo != null)
+               loads.Add(loadInfo);
+
+            // A grammar that can't warm up still works; its first use is just slower.
+            stopwatch.Restart();
+
+            try {
+               grammar.WarmUp();
+            } catch (Exception e) {
+               _logger.Warn(e, $"Grammar, '{entry.Name}', could not be warmed up.");
+               continue;
+            }
+
+            _logger.Info($"Grammar, '{entry.Name}', warmed up in {stopwatch.ElapsedMilliseconds} ms.");
          }
+
+         // Summarize, so that warm (archived) and cold (compiled) starts can be compared.
+         var warm = loads.Where(e => e.IsWarm == true).ToList();
+         var cold = loads.Where(e => e.IsWarm == false).ToList();
+
+         _logger.Info(
+            $"Grammars initialized in {total.ElapsedMilliseconds} ms. " +
+            $"Warm: {warm.Count} ({warm.Sum(e => e.Elapsed.TotalMilliseconds):0.0} ms), " +
+            $"Cold: {cold.Count} ({cold.Sum(e => e.Elapsed.TotalMilliseconds):0.0} ms)."
+         );
       }
 
       private void LoadGrammars() {
@@ -193,6 +281,51 @@ namespace Renfrew.Core {
          _notifyIcon.ShowBalloonTip(2000, title, message, ToolTipIcon.Info);
       }
 
+      /// <summary>
+      /// Waits until Dragon has a user profile loaded. Completes as soon as Dragon
+      /// reports the profile, and falls back to polling (with an exponential back-off)
+      /// in case the notification is missed.
+      /// </summary>
+      /// <returns>The name of the loaded profile.</returns>
+      private async Task<String> WaitForProfileAsync() {
+         var profileReady = new TaskCompletionSource<String>();
+
+         // The event is raised on Dragon's notification thread, so don't run the
+         // rest of start-up on it.
+         EventHandler<ProfileReadyEventArgs> onProfileReady = (sender, e) =>
+            Task.Run(() => profileReady.TrySetResult(e.ProfileName));
+
+         _natSpeakService.ProfileReady += onProfileReady;
+
+         try {
+            var delay = MinProfilePollDelay;
+
+            for (var notified = false;; notified = true) {
+
+               var profileName = _natSpeakService.GetCurrentUserProfileName();
+
+               if (profileName != null)
+                  return profileName;
+
+               // If a profile name could not be retrieved, then either the user
+               // hasn't selected a profile yet, or NatSpeak hasn't been started.
+               if (notified == false) {
+                  _logger.Info("Could not load profile. Waiting for Dragon...");
+                  ShowNotifyInfo("Could not load profile. Waiting for Dragon...");
+               }
+
+               var completed = await Task.WhenAny(profileReady.Task, Task.Delay(delay));
+
+               if (completed == profileReady.Task)
+                  return await profileReady.Task;
+
+               delay = Math.Min(delay * 2, MaxProfilePollDelay);
+            }
+         } finally {
+            _natSpeakService.ProfileReady -= onProfileReady;
+         }
+      }
+
       public async Task Start(NatSpeakService natSpeakService) {
          _natSpeakService = natSpeakService ?? throw new ArgumentNullException(nameof(natSpeakService));
 
@@ -211,39 +344,18 @@ namespace Renfrew.Core {
 
          _logger.Info($"Dragon Version: {_natSpeakService.GetDragonVersion()}");
 
-         String profileName;
-         String profilePath;
-
-         for (var notified = false;; notified = true) {
+         var profileName = await WaitForProfileAsync();
 
-            profileName = _natSpeakService.GetCurrentUserProfileName();
-
-            // If a profile name could not be retrieved, then either the user
-            // hasn't selected a profile yet, or NatSpeak hasn't been started.
-            if (profileName == null) {
-
-               if (notified == false) {
-                  _logger.Info("Could not load profile. Will try again.");
-                  ShowNotifyInfo("Could not load profile. Will try again.");
-               }
-
-               // Wait for a bit.
-               await Task.Delay(2000);
-
-               // Try again...
-               continue;
-            }
-
-            // Get the file-system location of the user's profile (for informational purposes).
-            profilePath = _natSpeakService.GetUserDirectory(profileName);
-
-            // Profile found.
-            break;
-         }
+         // Get the file-system location of the user's profile (for informational purposes).
+         var profilePath = _natSpeakService.GetUserDirectory(profileName);
 
          _logger.Info($"Dragon Profile Loaded: {profileName}");
          _logger.Info($"Dragon Profile Path: {profilePath}");
 
+         // Keep the engine's grammar archives with the profile they were built for.
+         if (profilePath != null)
+            _grammarService.ArchiveDirectory = Path.Combine(profilePath, "MousePlot");
+
          LoadGrammars();
 
          CloseConsole();
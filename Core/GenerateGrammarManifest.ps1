@@ -0,0 +1,49 @@
+# Project Renfrew
+# Copyright(C) 2024 Stephen Workman (workman.stephen@gmail.com)
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.If not, see<http://www.gnu.org/licenses/>.
+#
+
+# Generates the grammar manifest (e.g. Core.grammars) for an assembly. The assemblies
+# are x86 and depend on mixed-mode ones, so this has to run in a 32-bit PowerShell
+# rather than inside MSBuild. Any error fails the build.
+
+param(
+   [Parameter(Mandatory = $true)]
+   [String] $AssemblyPath
+)
+
+$ErrorActionPreference = 'Stop'
+
+if ([IntPtr]::Size -ne 4) {
+   throw "The grammar manifest has to be generated by a 32-bit PowerShell."
+}
+
+$AssemblyPath = (Resolve-Path $AssemblyPath).Path
+$directory = Split-Path -Parent $AssemblyPath
+
+# Load Grammar.dll from the output directory (not a copy from elsewhere), so that the
+# manifest types match the ones the assembly was built against.
+[void] [Reflection.Assembly]::LoadFrom((Join-Path $directory 'Grammar.dll'))
+
+$assembly = [Reflection.Assembly]::LoadFrom($AssemblyPath)
+$manifest = [Renfrew.Grammar.GrammarManifest]::FromAssembly($assembly)
+
+if ($manifest.Entries.Count -eq 0) {
+   throw "No exported grammars were found in $AssemblyPath."
+}
+
+$manifest.Save([Renfrew.Grammar.GrammarManifest]::GetManifestPath($AssemblyPath))
+
+Write-Host "Wrote a manifest of $($manifest.Entries.Count) grammar(s) for $AssemblyPath."
@@ -17,7 +17,6 @@
 
 using System;
 using System.Windows.Media;
-using System.Windows.Threading;
 
 namespace Renfrew.Core.Grammars.MousePlot {
    /// <summary>
@@ -29,9 +28,9 @@ namespace Renfrew.Core.Grammars.MousePlot {
       }
 
       public override void Rotate(double angle) {
-         Dispatcher.BeginInvoke(DispatcherPriority.Send, new Action(() => {
+         Run(() => {
             ((RotateTransform) RenderTransform).Angle = angle;
-         })).Wait();
+         });
       }
    }
 }
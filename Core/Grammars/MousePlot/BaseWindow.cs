@@ -18,89 +18,151 @@
 using System;
 using System.Drawing;
 using System.IO;
+using System.Threading;
 using System.Windows;
+using System.Windows.Interop;
 using System.Windows.Threading;
 
+using Renfrew.Utility;
+
 namespace Renfrew.Core.Grammars.MousePlot {
    public abstract class BaseWindow : Window, IWindow {
       private readonly String DefaultColourName = "Yellow";
 
+      // The window's position and size, published by the UI thread whenever they
+      // change, so that other threads can read them without waiting on it.
+      private volatile WindowGeometry _geometry = WindowGeometry.Empty;
+
+      // Reads of the geometry (each one a dispatcher round trip that's no longer made)
+      private static Int64 _geometryReads = 0;
+
       public BaseWindow() {
 
       }
 
+      /// <summary>
+      /// The number of times the geometry of any window has been read, across all
+      /// threads, since start-up.
+      /// </summary>
+      public static Int64 GeometryReads => Interlocked.Read(ref _geometryReads);
+
+      /// <summary>
+      /// The window's position and size, as last set. Safe to read from any thread.
+      /// </summary>
+      public WindowGeometry Geometry {
+         get {
+            Interlocked.Increment(ref _geometryReads);
+            return _geometry;
+         }
+      }
+
+      protected override void OnPropertyChanged(DependencyPropertyChangedEventArgs e) {
+         base.OnPropertyChanged(e);
+
+         if (e.Property == LeftProperty || e.Property == TopProperty ||
+             e.Property == WidthProperty || e.Property == HeightProperty) {
+            _geometry = new WindowGeometry(base.Left, base.Top, base.Width, base.Height);
+         }
+      }
+
+      // Keep our overlays out of the zoom window's magnified image, so that they
+      // needn't be hidden (or cropped out) while zooming.
+      protected override void OnSourceInitialized(EventArgs e) {
+         base.OnSourceInitialized(e);
+
+         Magnifier.AddOverlay(new WindowInteropHelper(this).Handle);
+      }
+
+      protected override void OnClosed(EventArgs e) {
+         Magnifier.RemoveOverlay(new WindowInteropHelper(this).Handle);
+
+         base.OnClosed(e);
+      }
+
+      /// <summary>
+      /// Runs the action on the UI thread and waits for it, or just runs it if this
+      /// is the UI thread (e.g. while an <see cref="OverlayTransaction"/> is applied).
+      /// </summary>
+      protected void Run(Action action) {
+         if (Dispatcher.CheckAccess() == true) {
+            action();
+            return;
+         }
+
+         Dispatcher.BeginInvoke(DispatcherPriority.Send, action).Wait();
+      }
+
       #region Builtins
       public new virtual void Close() {
-         Dispatcher.BeginInvoke(DispatcherPriority.Send, new Action(() => {
+         Run(() => {
             base.Hide();
-         })).Wait();
+         });
       }
 
       public new void Focus() {
-         Dispatcher.BeginInvoke(DispatcherPriority.Send, new Action(() => {
+         Run(() => {
             base.Focus();
             Activate();
-         })).Wait();
+         });
       }
 
       public new double Height {
-         get {
-            return (double)Dispatcher.Invoke(DispatcherPriority.Send, new Func<double>(() => base.Height));
-         }
+         get => Geometry.Height;
          protected set => base.Height = value;
       }
 
       public new double Left {
-         get {
-            return (double)Dispatcher.Invoke(DispatcherPriority.Send, new Func<double>(() => base.Left));
-         }
+         get => Geometry.Left;
          protected set => base.Left = value;
       }
 
       public new virtual void Show() {
-         Dispatcher.BeginInvoke(DispatcherPriority.Send, new Action(() => {
+         Run(() => {
             base.Show();
-         })).Wait();
+         });
       }
 
       public new virtual void ShowDialog() {
-         Dispatcher.BeginInvoke(DispatcherPriority.Send, new Action(() => {
+         Run(() => {
             base.ShowDialog();
-         })).Wait();
+         });
       }
 
       public new double Top {
-         get {
-            return (double)Dispatcher.Invoke(DispatcherPriority.Send, new Func<double>(() => base.Top));
-         }
+         get => Geometry.Top;
          protected set => base.Top = value;
       }
 
       public new double Width {
-         get {
-            return (double)Dispatcher.Invoke(DispatcherPriority.Send, new Func<double>(() => base.Width));
-         }
+         get => Geometry.Width;
          protected set => base.Width = value;
       }
       #endregion
 
       public virtual void Move(double x, double y) {
-         Dispatcher.BeginInvoke(DispatcherPriority.Send, new Action(() => {
+         Run(() => {
             Left = x;
             Top = y;
-         })).Wait();
+         });
       }
 
       public virtual void SetColour(GridColour colour) {
-         Dispatcher.BeginInvoke(DispatcherPriority.Send, new Action(() => {
+         Run(() => {
             try {
                SetColour(colour.ToString());
             } catch (IOException) {
                SetColour(DefaultColourName);
             }
-         })).Wait();
+
+            OnColourChanged();
+         });
       }
 
+      /// <summary>
+      /// Called on the UI thread once the theme's resources have been swapped.
+      /// </summary>
+      protected virtual void OnColourChanged() { }
+
       private void SetColour(String c) {
          var merged = this.Resources.MergedDictionaries;
 
@@ -117,5 +179,33 @@ namespace Renfrew.Core.Grammars.MousePlot {
       public virtual void SetScreenBounds(Rectangle rectangle) { }
 
       public virtual void Rotate(double angle) { }
+
+      public virtual void WarmUp() {
+         Run(() => {
+            if (IsLoaded == true)
+               return;
+
+            var state = WindowState;
+            var showActivated = ShowActivated;
+
+            // Show it (without taking the focus) beyond the top-left of the desktop, so
+            // that it's built, laid out and rendered without being seen.
+            WindowState = WindowState.Normal;
+            ShowActivated = false;
+
+            Left = SystemParameters.VirtualScreenLeft - base.Width - 100;
+            Top = SystemParameters.VirtualScreenTop - base.Height - 100;
+
+            base.Show();
+
+            // Let the Loaded handlers (and the first render) run before hiding it again
+            Dispatcher.Invoke(DispatcherPriority.Loaded, new Action(() => { }));
+
+            base.Hide();
+
+            WindowState = state;
+            ShowActivated = showActivated;
+         });
+      }
    }
 }
@@ -17,7 +17,6 @@
 
 using System;
 using System.Drawing;
-using System.Windows.Threading;
 
 namespace Renfrew.Core.Grammars.MousePlot {
    public partial class CellWindow : BaseWindow, IWindow {
@@ -32,10 +31,10 @@ namespace Renfrew.Core.Grammars.MousePlot {
 
          var r = Rectangle.Intersect(_screenBounds, new Rectangle((Int32) Left, (Int32) Top, 108, 108));
 
-         Dispatcher.BeginInvoke(DispatcherPriority.Send, new Action(() => {
+         Run(() => {
             Width = r.Width + 4;
             Height = r.Height + 4;
-         })).Wait();
+         });
       }
    }
 }
@@ -28,5 +28,10 @@ namespace Renfrew.Core.Grammars.MousePlot {
       IScreen[] AllScreens { get; }
       Rectangle Bounds { get; }
       IScreen PrimaryScreen { get; }
+
+      /// <summary>
+      /// The DPI scale of the screen (1.0 at 96 DPI).
+      /// </summary>
+      Double Scale { get; }
    }
 }
@@ -35,5 +35,11 @@ namespace Renfrew.Core.Grammars.MousePlot {
       void SetScreenBounds(Rectangle rectangle);
 
       void Rotate(double angle);
+
+      /// <summary>
+      /// Builds the window (its template, theme and content) without showing it, so
+      /// that it shows as quickly the first time as it does afterwards.
+      /// </summary>
+      void WarmUp();
    }
 }
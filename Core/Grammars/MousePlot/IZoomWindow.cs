@@ -16,6 +16,7 @@
 //
 
 using System;
+using System.Collections.Generic;
 using System.Drawing;
 
 namespace Renfrew.Core.Grammars.MousePlot {
@@ -23,5 +24,10 @@ namespace Renfrew.Core.Grammars.MousePlot {
       void SetScaleMultiplier(double multiplier);
       void SetSource(Int32 x, Int32 y, Int32 width, Int32 height);
       void SetSource(Rectangle sourceRectangle);
+
+      /// <summary>
+      /// Marks the targets found in the source (in screen pixels), numbered from 1.
+      /// </summary>
+      void SetTargets(IReadOnlyList<Rectangle> targets);
    }
 }
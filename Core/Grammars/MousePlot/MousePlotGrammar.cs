@@ -19,40 +19,66 @@ using System;
 using System.Collections.Generic;
 using System.Diagnostics;
 using System.Drawing;
-using System.Drawing.Drawing2D;
 using System.Linq;
-using System.Runtime.InteropServices;
+using System.Threading.Tasks;
 using System.Windows.Forms;
+using System.Windows.Threading;
+
+using NLog;
 
 using Cursor = System.Windows.Forms.Cursor;
 
 namespace Renfrew.Core.Grammars.MousePlot {
    using Grammar;
    using NatSpeakInterop;
+   using Properties;
    using Win32.Interop;
 
    [GrammarExport("Mouse Plot", "A replacement for \"Mouse Grid\".")]
    public class MousePlotGrammar : Grammar {
+      private static Logger _logger = LogManager.GetCurrentClassLogger();
 
       private IScreen _currentScreen;
       private Size _cellSize = new Size(100, 100);
 
-      private bool _firstLoad = true;
+      // Whether the plot window has been built yet (by being warmed up or shown)
+      private bool _isPlotWindowWarm = false;
 
       private IWindow _plotWindow;
+
+      // When plotting on every screen at once, makes the plot window for a monitor
+      // (numbered from 1). Otherwise null, and the one plot window is moved between
+      // screens.
+      private Func<Int32, IWindow> _plotWindowFactory;
+
+      // The plot windows made so far, and the bounds of the screens the first of them
+      // are on. Windows are only made (or moved) when the screens change.
+      private List<IWindow> _screenPlotWindows = new List<IWindow>();
+      private Rectangle[] _screenPlotBounds = new Rectangle[0];
+
       private IWindow _cellWindow;
       private IWindow _markArrowWindow;
 
       private IZoomWindow _zoomWindow;
 
+      private ITargetFinder _targetFinder;
+
+      // The targets found in the zoomed cell, in screen pixels
+      private IReadOnlyList<Rectangle> _targets = new Rectangle[0];
+
       private Point _currentCell = Point.Empty;
 
-      // TODO: Add support for determining this from windows and setting it by configuration.
-      private readonly double _displayScaleMultiplier = 1;
+      private double DisplayScaleMultiplier =>
+         _currentScreen.Scale;
 
-      private readonly uint _scrollWheelDelta = 300;
+      private bool IsPlottingAllScreens =>
+         _plotWindowFactory != null;
 
-      private Bitmap _bitmap;
+      // The plot windows in use: one per screen, or the one that's moved between them
+      private IEnumerable<IWindow> PlotWindows =>
+         IsPlottingAllScreens == true ? _screenPlotWindows.Take(_screenPlotBounds.Length) : new[] { _plotWindow };
+
+      private readonly uint _scrollWheelDelta = 300;
 
       private bool _isZoomed = false;
 
@@ -130,13 +156,11 @@ namespace Renfrew.Core.Grammars.MousePlot {
       };
       #endregion
 
-      [DllImport("user32.dll", SetLastError = true)]
-      private static extern uint SendInput(uint cInputs, IntPtr pInputs, int cbSize);
-
       // For Testing
       public MousePlotGrammar(IGrammarService grammarService, IScreen screen,
                               IWindow plotWindow, IZoomWindow zoomWindow, IWindow cellWindow,
-                              IWindow markArrowWindow)
+                              IWindow markArrowWindow, ITargetFinder targetFinder = null,
+                              Func<Int32, IWindow> plotWindowFactory = null)
          : base(grammarService) {
 
          _currentScreen   = screen;
@@ -144,17 +168,21 @@ namespace Renfrew.Core.Grammars.MousePlot {
          _zoomWindow      = zoomWindow;
          _cellWindow      = cellWindow;
          _markArrowWindow = markArrowWindow;
+         _targetFinder    = targetFinder;
+
+         _plotWindowFactory = plotWindowFactory;
       }
 
       public MousePlotGrammar(IGrammarService grammarService)
          : this(grammarService, new TestableScreen().PrimaryScreen,
               new PlotWindow(), new ZoomWindow(), new CellWindow(),
-              new ArrowWindow()) {
+              new ArrowWindow(), new ScreenTargetFinder(),
+              Settings.Default.PlotAllScreens == true ? (n => new PlotWindow(n)) : (Func<Int32, IWindow>) null) {
 
       }
 
       public override void Dispose() {
-         throw new NotImplementedException();
+         Unload();
       }
 
       public override void Initialize() {
@@ -176,33 +204,39 @@ namespace Renfrew.Core.Grammars.MousePlot {
                p => p.Say("Drag").Do(Drag),
                p => p.Say("Mark").Do(Mark),
 
+               // The monitor can be given with the cell, e.g. "Monitor Two Alpha Bravo"
                p => p
                   .SayOneOf("Monitor", "Screen")
                   .SayOneOf(_numbersList.Keys)
-                     .Do(spokenWords => SwitchScreen( _numbersList[spokenWords.Last()] )),
+                     .Do(spokenWords => SwitchScreen( _numbersList[spokenWords.Last()] ))
+                  .OptionallyWithRule("plot_cell"),
 
                p => p
                   .SayOneOf(_colourList)
                      .Do(spokenWords => SetColour(spokenWords.First())),
 
-               p => p
+               p => p.WithRule("plot_cell")
+            )
+         );
+
+         // A cell of the plot grid, then one of the zoomed cell, and what to do there
+         AddRule("plot_cell", e => e
+            .SayOneOf(alphaWords)
+            .SayOneOf(alphaWords)
+               .Do(spokenWords => MoveCursor(spokenWords.Last(), spokenWords.First()))
+            .OptionallyOneOf(
+               o => o.WithRule("mouse_click"),
+               o => o
                   .SayOneOf(alphaWords)
                   .SayOneOf(alphaWords)
                      .Do(spokenWords => MoveCursor(spokenWords.Last(), spokenWords.First()))
                   .OptionallyOneOf(
-                     o => o.WithRule("mouse_click"),
-                     o => o
-                        .SayOneOf(alphaWords)
-                        .SayOneOf(alphaWords)
-                           .Do(spokenWords => MoveCursor(spokenWords.Last(), spokenWords.First()))
-                        .OptionallyOneOf(
-                           q => q.WithRule("mouse_click"),
-                           q => o.Say("Drag").Do(Drag),
-                           q => o.Say("Mark").Do(Mark)
-                        ),
-                     o => o.Say("Drag").Do(Drag),
-                     o => o.Say("Mark").Do(Mark)
-                  )
+                     q => q.WithRule("mouse_click"),
+                     q => o.Say("Drag").Do(Drag),
+                     q => o.Say("Mark").Do(Mark)
+                  ),
+               o => o.Say("Drag").Do(Drag),
+               o => o.Say("Mark").Do(Mark)
             )
          );
 
@@ -222,6 +256,32 @@ namespace Renfrew.Core.Grammars.MousePlot {
             .Do(spokenWords => NudgeCursor(spokenWords.ToArray()))
          );
 
+         // Moving to the targets found in the zoomed cell
+         AddRule("mouse_target", e => e
+            .OneOf(
+               p => p
+                  .Say("Target")
+                  .SayOneOf(_numbersList.Where(n => n.Value <= 9).Select(n => n.Key))
+                     .Do(spokenWords => MoveToTarget(_numbersList[spokenWords.Last()])),
+               p => p.Say("Snap").Do(Snap)
+            )
+         );
+
+         // Moves the mouse steadily until told to stop
+         AddRule("mouse_move", e => e
+            .Say("Keep")
+            .Say("Moving")
+            .SayOneOf("Up", "Down", "Left", "Right")
+               .Do(spokenWords => KeepMoving(spokenWords.Last()))
+         );
+
+         // Interrupts a drag (or anything else the mouse is doing)
+         AddRule("mouse_stop", e => e
+            .Say("Mouse")
+            .Say("Stop")
+               .Do(StopMouse)
+         );
+
          AddRule("scroll", e => e
             .SayOneOf("Scroll", "Troll")
             .Optionally(p => p
@@ -230,15 +290,33 @@ namespace Renfrew.Core.Grammars.MousePlot {
             .Do(spokenWords => ScrollMouse(spokenWords.ToArray()))
          );
 
-         // Load grammar into the grammar service
-         Load();
-         
+         // Load grammar into the grammar service. When loading lazily, only a trigger
+         // made of the opening words is given to Dragon up front. Longer commands
+         // (e.g. "Plot Alpha Bravo Click") work once the grammar has been loaded.
+         if (Settings.Default.LazyGrammarLoading == true) {
+            LoadOnDemand(e => e
+               .OneOf(
+                  p => p.Say("Plot"),
+                  p => p.Say("Keep").Say("Moving").SayOneOf("Up", "Down", "Left", "Right"),
+                  p => p.Say("Mouse").Say("Stop"),
+                  p => p.SayOneOf("Scroll", "Troll")
+               ),
+               Settings.Default.GrammarIdleTimeout
+            );
+         } else {
+            Load();
+         }
+
          ActivateRule("mouse_plot");
+         ActivateRule("mouse_move");
+         ActivateRule("mouse_stop");
          ActivateRule("scroll");
       }
 
       private void ReactivateDefaultRules() {
          ReactivateRule("mouse_plot");
+         ReactivateRule("mouse_move");
+         ReactivateRule("mouse_stop");
          ReactivateRule("scroll");
       }
 
@@ -277,17 +355,23 @@ namespace Renfrew.Core.Grammars.MousePlot {
       }
 
       private void ClickMouse(MouseButtons buttons, Int32 times) {
-         for (int i = 0; i < times; i++)
-            Mouse.Click(buttons);
+         PlayGesture(new Gesture().Click(buttons, times));
       }
 
       private void CloseWindows() {
-         _zoomWindow.Close();
-         _cellWindow.Close();
-         _plotWindow.Close();
-         _markArrowWindow.Close();
+         BeginOverlays()
+            .Close(_zoomWindow)
+            .Close(_cellWindow)
+            .Close(PlotWindows)
+            .Close(_markArrowWindow)
+            .Commit();
+
+         Mouse.ClearClampRegion();
+
+         _targets = new Rectangle[0];
 
          DeactivateRule("mouse_nudge");
+         DeactivateRule("mouse_target");
 
          // Due to a problem with Dragon 15, rules we want to remain active
          // need to be explicitly re-activated when another is de-activated.
@@ -332,35 +416,43 @@ namespace Renfrew.Core.Grammars.MousePlot {
 
          Console.WriteLine($"Dragging from ({_dragAnchor.X}, {_dragAnchor.Y}) to ({x}, {y})");
 
-         Mouse.Animate(x, y, _dragAnchor.X, _dragAnchor.Y, 50);
-         Mouse.Down(MouseButtons.Left);
-
-         Mouse.Animate(_dragAnchor.X, _dragAnchor.Y, x, y);
-         Mouse.Up(MouseButtons.Left);
+         var gesture = new Gesture()
+            .Animate(x, y, _dragAnchor.X, _dragAnchor.Y, Settings.Default.DragApproachDuration)
+            .Down(MouseButtons.Left)
+            .Animate(
+               _dragAnchor.X, _dragAnchor.Y, x, y,
+               Settings.Default.DragDuration, MouseEasing.EaseInOut
+            )
+            .Up(MouseButtons.Left);
 
-         CloseWindows();
+         // The drag is played on the input thread, so that recognition isn't held
+         // up while it runs, and so that it can be stopped part way through.
+         PlayGesture(gesture)
+            .ContinueWith(t => _markArrowWindow.Close());
 
          _isZoomed = false;
       }
 
       public Int32 GetCellXCoord(Int32 x) {
-         var i = GetXScreenOffset(x);
+         var i = _cellSize.Width * x;
+         var width = ScaleToWindow(_currentScreen.Bounds.Width);
 
          // Integer truncation will have the desired effect
-         if (i > _currentScreen.Bounds.Right)
-            i = _currentScreen.Bounds.Left + (_currentScreen.Bounds.Width / _cellSize.Width) * _cellSize.Width;
+         if (i > width)
+            i = (width / _cellSize.Width) * _cellSize.Width;
 
-         return i;
+         return _currentScreen.Bounds.Left + i;
       }
 
       public Int32 GetCellYCoord(Int32 y) {
-         var i = GetYScreenOffset(y);
+         var i = _cellSize.Height * y;
+         var height = ScaleToWindow(_currentScreen.Bounds.Height);
 
          // Integer truncation will have the desired effect
-         if (i > _currentScreen.Bounds.Bottom)
-            i = _currentScreen.Bounds.Top + (_currentScreen.Bounds.Height / _cellSize.Height) * _cellSize.Height;
+         if (i > height)
+            i = (height / _cellSize.Height) * _cellSize.Height;
 
-         return i;
+         return _currentScreen.Bounds.Top + i;
       }
 
       public Int32 GetCoordinateOrdinal(String c) {
@@ -376,21 +468,21 @@ namespace Renfrew.Core.Grammars.MousePlot {
       }
 
       public Int32 GetMouseXCoord(Int32 x) {
-         x = GetXScreenOffset(x) + (_cellSize.Width / 2);
+         x = ToScreenX(GetXScreenOffset(x) + (_cellSize.Width / 2));
 
-         if (x > _currentScreen.Bounds.Right)
+         if (x >= _currentScreen.Bounds.Right)
             x = _currentScreen.Bounds.Right - 1;
 
-         return ScaleToScreen(x);
+         return x;
       }
 
       public Int32 GetMouseYCoord(Int32 y) {
-         y = GetYScreenOffset(y) + (_cellSize.Height / 2);
+         y = ToScreenY(GetYScreenOffset(y) + (_cellSize.Height / 2));
 
-         if (y > _currentScreen.Bounds.Bottom)
+         if (y >= _currentScreen.Bounds.Bottom)
             y = _currentScreen.Bounds.Bottom - 1;
 
-         return ScaleToScreen(y);
+         return y;
       }
 
       public Int32 GetXScreenOffset(Int32 x) =>
@@ -417,14 +509,63 @@ namespace Renfrew.Core.Grammars.MousePlot {
          if (x > 8) x = 8;
 
          var subCellWidth = _cellSize.Width / 9;
-         return ScaleToScreen(_currentCell.X + (subCellWidth * x) + (subCellWidth / 2));
+         return ToScreenX(_currentCell.X + (subCellWidth * x) + (subCellWidth / 2));
       }
 
       public Int32 GetZoomedMouseYCoord(Int32 y) {
          if (y > 8) y = 8;
 
          var subCellHeight = _cellSize.Height / 9;
-         return ScaleToScreen(_currentCell.Y + (subCellHeight * y) + (subCellHeight / 2));
+         return ToScreenY(_currentCell.Y + (subCellHeight * y) + (subCellHeight / 2));
+      }
+
+      /// <summary>
+      /// Gets the centre of a target in the zoomed cell.
+      /// </summary>
+      /// <param name="number">The target's number (from 1).</param>
+      /// <returns>The centre, in screen pixels, or null if there's no such target.</returns>
+      public Point? GetTargetCentre(Int32 number) {
+         if (number < 1 || number > _targets.Count)
+            return null;
+
+         var target = _targets[number - 1];
+
+         return new Point(target.X + target.Width / 2, target.Y + target.Height / 2);
+      }
+
+      /// <summary>
+      /// Gets the target closest to a point (any inside it count as closest), going
+      /// by the centres when the point is inside more than one, or as close to each.
+      /// </summary>
+      /// <returns>The target's number (from 1), or 0 if there are no targets.</returns>
+      public Int32 GetNearestTarget(Point point) {
+         var nearest = 0;
+         var nearestDistance = Int64.MaxValue;
+         var nearestCentreDistance = Int64.MaxValue;
+
+         for (var i = 0; i < _targets.Count; i++) {
+            var target = _targets[i];
+
+            Int64 dx = Math.Max(Math.Max(target.Left - point.X, point.X - (target.Right - 1)), 0);
+            Int64 dy = Math.Max(Math.Max(target.Top - point.Y, point.Y - (target.Bottom - 1)), 0);
+
+            var centre = GetTargetCentre(i + 1).Value;
+
+            Int64 cx = centre.X - point.X;
+            Int64 cy = centre.Y - point.Y;
+
+            var distance = dx * dx + dy * dy;
+            var centreDistance = cx * cx + cy * cy;
+
+            if (distance < nearestDistance ||
+                (distance == nearestDistance && centreDistance < nearestCentreDistance)) {
+               nearest = i + 1;
+               nearestDistance = distance;
+               nearestCentreDistance = centreDistance;
+            }
+         }
+
+         return nearest;
       }
 
       public void Mark() {
@@ -450,13 +591,13 @@ namespace Renfrew.Core.Grammars.MousePlot {
 
          // Position and rotate the "mark" arrow
 
-         if (offsetX + _markArrowWindow.Width >= _currentScreen.Bounds.Right) {
-            offsetX = x - (Int32) _markArrowWindow.Width;
+         if (offsetX + ScaleToScreen(_markArrowWindow.Width) >= _currentScreen.Bounds.Right) {
+            offsetX = x - ScaleToScreen((Int32) _markArrowWindow.Width);
             angle = 90;
          }
 
-         if (offsetY + _markArrowWindow.Height >= _currentScreen.Bounds.Bottom) {
-            offsetY = y - (Int32) _markArrowWindow.Height;
+         if (offsetY + ScaleToScreen(_markArrowWindow.Height) >= _currentScreen.Bounds.Bottom) {
+            offsetY = y - ScaleToScreen((Int32) _markArrowWindow.Height);
 
             if (offsetX == x) {
                angle = -90;
@@ -465,10 +606,11 @@ namespace Renfrew.Core.Grammars.MousePlot {
             }
          }
 
-         _markArrowWindow.Rotate(angle);
-         _markArrowWindow.Move(ScaleToWindow(offsetX), ScaleToWindow(offsetY));
-
-         _markArrowWindow.Show();
+         BeginOverlays()
+            .Rotate(_markArrowWindow, angle)
+            .Move(_markArrowWindow, ToWindowX(offsetX), ToWindowY(offsetY))
+            .Show(_markArrowWindow)
+            .Commit();
       }
 
       public void MoveCursor(String x, String y) {
@@ -493,10 +635,30 @@ namespace Renfrew.Core.Grammars.MousePlot {
 
          Zoom(x, y);
          ActivateRule("mouse_nudge");
+         ActivateRule("mouse_target");
 
          Mouse.SetPosition(mouseX, mouseY);
       }
 
+      public void MoveToTarget(Int32 number) {
+         var centre = GetTargetCentre(number);
+
+         if (centre == null)
+            return;
+
+         Mouse.SetPosition(centre.Value.X, centre.Value.Y);
+      }
+
+      // Moves to the middle of the target nearest the pointer
+      private void Snap() {
+         var nearest = GetNearestTarget(Cursor.Position);
+
+         if (nearest == 0)
+            return;
+
+         MoveToTarget(nearest);
+      }
+
       public void NudgeCursor(String[] spokenWords) {
          String direction = spokenWords[0];
          String countStr = null;
@@ -509,48 +671,50 @@ namespace Renfrew.Core.Grammars.MousePlot {
          if (countStr != null)
             count = _numbersList[countStr];
 
-         var x = Cursor.Position.X;
-         var y = Cursor.Position.Y;
-
-         for (int i = 0; i < count; i++) {
-            switch (direction) {
-               case "Up":
-                  y--;
-                  break;
-               case "Down":
-                  y++;
-                  break;
-               case "Left":
-                  x--;
-                  break;
-               case "Right":
-                  x++;
-                  break;
-            }
-         }
+         // The pointer is kept inside the "cell" by the clamp region set in Zoom.
+         var d = GetDirection(direction);
+
+         Mouse.Nudge(d.X * count, d.Y * count);
+      }
 
-         // Keep the pointer from leaving the "cell" window
+      private void KeepMoving(String direction) {
+         var velocity = Settings.Default.MouseMoveVelocity;
+         var d = GetDirection(direction);
 
-         var borderThickness = 4;
+         Mouse.StartMoving(d.X * velocity, d.Y * velocity);
+      }
 
-         var left   = ScaleToScreen(_cellWindow.Left + borderThickness);
-         var top    = ScaleToScreen(_cellWindow.Top + borderThickness);
-         var right  = ScaleToScreen(left + _cellWindow.Width - borderThickness * 2 - 1);
-         var bottom = ScaleToScreen(top + _cellWindow.Height - borderThickness * 2 - 1);
+      private static Point GetDirection(String direction) {
+         switch (direction) {
+            case "Up":
+               return new Point(0, -1);
+            case "Down":
+               return new Point(0, 1);
+            case "Left":
+               return new Point(-1, 0);
+            case "Right":
+               return new Point(1, 0);
+            default:
+               return new Point(0, 0);
+         }
+      }
 
-         if (x >= right)
-            x = (Int32) right;
-         else if (x < left)
-            x = (Int32) left;
+      // Queues the gesture without waiting for it, so a failure is logged here
+      // rather than going unobserved.
+      private Task PlayGesture(Gesture gesture) {
+         var task = InputThread.Default.Enqueue(gesture);
 
-         if (y >= bottom)
-            y = (Int32) bottom;
-         else if (y < top)
-            y = (Int32) top;
+         task.ContinueWith(
+            t => _logger.Warn(t.Exception.InnerException, "Could not play a gesture."),
+            TaskContinuationOptions.OnlyOnFaulted
+         );
 
-         // Move the pointer
+         return task;
+      }
 
-         Mouse.SetPosition(x, y);
+      private void StopMouse() {
+         InputThread.Default.Cancel();
+         Mouse.StopMoving();
       }
 
       private void ScrollMouse(String[] spokenWords) {
@@ -569,66 +733,202 @@ namespace Renfrew.Core.Grammars.MousePlot {
 
          var direction = (actionWord == "Scroll") ? MouseScrollDirection.Down : MouseScrollDirection.Up;
 
-         for (int i = 0; i < count; i++) {
-            Mouse.Scroll(direction, _scrollWheelDelta);
-         }
+         Mouse.Scroll(direction, (UInt32) count * _scrollWheelDelta, Settings.Default.ScrollDuration);
       }
 
       private void SetColour(String colourName) {
          if (Enum.TryParse(colourName, out GridColour colour) == false)
             colour = GridColour.Yellow;
 
-         _plotWindow.SetColour(colour);
-         _zoomWindow.SetColour(colour);
-         _cellWindow.SetColour(colour);
-         _markArrowWindow.SetColour(colour);
+         BeginOverlays()
+            .SetColour(PlotWindows, colour)
+            .SetColour(_zoomWindow, colour)
+            .SetColour(_cellWindow, colour)
+            .SetColour(_markArrowWindow, colour)
+            .Commit();
+      }
+
+      // Starts describing a change to the overlay windows, to be applied in one go
+      // on their UI thread. Windows that aren't WPF windows (i.e. mocks) are changed
+      // on the calling thread.
+      private OverlayTransaction BeginOverlays() =>
+         new OverlayTransaction((_plotWindow as DispatcherObject)?.Dispatcher);
+
+      public override void InvokeRule(IEnumerable<String> spokenWords) {
+         var words = spokenWords?.ToList();
+         var reads = BaseWindow.GeometryReads;
+
+         base.InvokeRule(words);
+
+         // Each read used to be a blocking round trip to the windows' dispatcher
+         var saved = BaseWindow.GeometryReads - reads;
+
+         if (saved > 0)
+            _logger.Trace($"'{String.Join(" ", words)}' saved {saved} dispatcher round trip(s).");
       }
 
       public void ShowPlotWindow() {
          ActivateRule("post_plot");
          MakeGrammarExclusive();
 
-         _zoomWindow.Close();
-         _cellWindow.Close();
+         var stopwatch = Stopwatch.StartNew();
 
-         _plotWindow.Show();
+         if (IsPlottingAllScreens == true) {
+            if (UpdateScreenPlotWindows() == true)
+               ParkPlotWindows();
 
-         // Force the plot window onto the primary display if this is the first
-         // time that the window is being shown since application start.
-         if (_firstLoad == true) {
-            _plotWindow.Move(0, 0);
-            _firstLoad = false;
+            // Cells are on the primary screen unless a monitor is named
+            _currentScreen = _currentScreen.PrimaryScreen;
          }
 
+         BeginOverlays()
+            .Close(_zoomWindow)
+            .Close(_cellWindow)
+            .Show(PlotWindows)
+            .Commit();
+
+         _logger.Debug(
+            $"Plot window shown in {stopwatch.Elapsed.TotalMilliseconds:0.0} ms " +
+            $"({(_isPlotWindowWarm == true ? "warm" : "cold")})."
+         );
+
+         _isPlotWindowWarm = true;
          _isZoomed = false;
       }
 
-      private void SwitchScreen(Int32 screenNumber) {
-         screenNumber--;
+      // Looks for targets in the given part of the screen. Finding none is better
+      // than failing to zoom, so errors are only logged.
+      private IReadOnlyList<Rectangle> FindTargets(Rectangle area) {
+         if (_targetFinder == null)
+            return new Rectangle[0];
 
-         if (screenNumber >= Screen.AllScreens.Length)
-            return;
+         var stopwatch = Stopwatch.StartNew();
+
+         try {
+            var targets = _targetFinder.Find(area);
+
+            _logger.Debug(
+               $"Found {targets.Count} target(s) in {stopwatch.Elapsed.TotalMilliseconds:0.0} ms."
+            );
+
+            return targets;
+         } catch (Exception e) {
+            _logger.Warn(e, "Could not look for targets.");
+            return new Rectangle[0];
+         }
+      }
+
+      public override void WarmUp() {
+         if (IsPlottingAllScreens == true)
+            UpdateScreenPlotWindows();
+
+         var windows = PlotWindows.Concat(new[] { _zoomWindow, _cellWindow, _markArrowWindow }).ToList();
+
+         foreach (var window in windows) {
+            var stopwatch = Stopwatch.StartNew();
+
+            window.WarmUp();
+
+            _logger.Debug(
+               $"{window.GetType().Name} warmed up in {stopwatch.Elapsed.TotalMilliseconds:0.0} ms."
+            );
+         }
+
+         // Park the plot windows on their displays (warming up moves them off the
+         // desktop), so that they're maximized there when they're first shown.
+         ParkPlotWindows();
+
+         _isPlotWindowWarm = true;
+      }
+
+      // Makes sure there's a plot window for each screen (up to 9, as monitors are
+      // named by a single digit), when plotting on every screen.
+      // Returns whether anything changed, i.e. the windows need parking.
+      private bool UpdateScreenPlotWindows() {
+         var bounds = _currentScreen.AllScreens.Take(9).Select(e => e.Bounds).ToArray();
+
+         if (bounds.SequenceEqual(_screenPlotBounds) == true)
+            return false;
+
+         var transaction = BeginOverlays();
+
+         // Hide the windows of screens that have gone
+         foreach (var window in _screenPlotWindows.Skip(bounds.Length))
+            transaction.Close(window);
+
+         while (_screenPlotWindows.Count < bounds.Length) {
+            _screenPlotWindows.Add(CreatePlotWindow(_screenPlotWindows.Count + 1));
+            _isPlotWindowWarm = false;
+         }
+
+         for (var i = 0; i < bounds.Length; i++)
+            transaction.SetScreenBounds(_screenPlotWindows[i], bounds[i]);
+
+         transaction.Commit();
 
-         _currentScreen = _currentScreen.AllScreens[screenNumber];
+         _screenPlotBounds = bounds;
 
-         _plotWindow.Move(_currentScreen.Bounds.Left, _currentScreen.Bounds.Top);
-         _plotWindow.Show();
+         _logger.Debug($"Plotting on {bounds.Length} screen(s).");
+
+         return true;
       }
 
-      private void TakeScreenshot(Int32 x, Int32 y, Int32 width, Int32 height) {
-         if (_bitmap != null) {
-            _bitmap.Dispose();
+      // Windows have to be made on the thread they're used on
+      private IWindow CreatePlotWindow(Int32 monitor) {
+         var dispatcher = (_plotWindow as DispatcherObject)?.Dispatcher;
+
+         if (dispatcher == null || dispatcher.CheckAccess() == true)
+            return _plotWindowFactory(monitor);
+
+         return dispatcher.Invoke(() => _plotWindowFactory(monitor));
+      }
+
+      // Moves each plot window to its screen
+      private void ParkPlotWindows() {
+         if (IsPlottingAllScreens == false) {
+            _plotWindow.Move(_currentScreen.Bounds.Left, _currentScreen.Bounds.Top);
+            return;
          }
 
-         _bitmap = new Bitmap(width, height);
+         var transaction = BeginOverlays();
+
+         for (var i = 0; i < _screenPlotBounds.Length; i++)
+            transaction.Move(_screenPlotWindows[i], _screenPlotBounds[i].Left, _screenPlotBounds[i].Top);
+
+         transaction.Commit();
+      }
+
+      public void SwitchScreen(Int32 screenNumber) {
+         screenNumber--;
+
+         var screens = _currentScreen.AllScreens;
+
+         if (screenNumber < 0 || screenNumber >= screens.Length)
+            return;
 
-         // Take the screenshot
-         using (var g = Graphics.FromImage(_bitmap)) {
-            g.InterpolationMode = InterpolationMode.NearestNeighbor;
-            g.PixelOffsetMode = PixelOffsetMode.None;
+         _currentScreen = screens[screenNumber];
 
-            g.CopyFromScreen(x, y, 0, 0, _bitmap.Size);
+         // The next cell is on the plot grid of the new screen, not in the zoomed cell
+         if (_isZoomed == true) {
+            BeginOverlays()
+               .Close(_zoomWindow)
+               .Close(_cellWindow)
+               .Commit();
+
+            Mouse.ClearClampRegion();
+
+            _targets = new Rectangle[0];
+            _isZoomed = false;
          }
+
+         // Every screen has its own plot window already
+         if (IsPlottingAllScreens == true)
+            return;
+
+         BeginOverlays()
+            .Move(_plotWindow, _currentScreen.Bounds.Left, _currentScreen.Bounds.Top)
+            .Show(_plotWindow)
+            .Commit();
       }
 
       public void Zoom(String x, String y) {
@@ -637,56 +937,81 @@ namespace Renfrew.Core.Grammars.MousePlot {
          var cellX  = GetCellXCoord(GetCoordinateOrdinal(x));
          var cellY  = GetCellYCoord(GetCoordinateOrdinal(y));
 
-         _plotWindow.Close();
-
          // Position the zoom window so it appears
          // on the current screen in its entirety.
          Int32 offsetX = (_cellSize.Width / 4) * 3;
          Int32 offsetY = (_cellSize.Height / 4) * 3;
 
-         if (mouseX + offsetX + ScaleToScreen(_zoomWindow.Width) >= _currentScreen.Bounds.Right)
+         if (mouseX + ScaleToScreen(offsetX + _zoomWindow.Width) >= _currentScreen.Bounds.Right)
             offsetX = -offsetX - (Int32) _zoomWindow.Width;
 
-         if (mouseY + offsetY + ScaleToScreen(_zoomWindow.Height) >= _currentScreen.Bounds.Bottom)
+         if (mouseY + ScaleToScreen(offsetY + _zoomWindow.Height) >= _currentScreen.Bounds.Bottom)
             offsetY = -offsetY - (Int32) _zoomWindow.Height;
 
-         _cellWindow.Move(cellX-4, cellY-4);
-         _cellWindow.Show();
+         // Keep nudges inside the cell
+         Mouse.SetClampRegion(
+            ToScreenX(cellX),
+            ToScreenY(cellY),
+            ToScreenX(cellX + _cellSize.Width),
+            ToScreenY(cellY + _cellSize.Height)
+         );
+
+         _zoomWindow.SetScaleMultiplier(DisplayScaleMultiplier);
 
-         _zoomWindow.SetScaleMultiplier(_displayScaleMultiplier);
-         _zoomWindow.SetSource(
-            ScaleToScreen(cellX),
-            ScaleToScreen(cellY),
+         var source = new Rectangle(
+            ToScreenX(cellX),
+            ToScreenY(cellY),
             ScaleToScreen(_cellSize.Width),
             ScaleToScreen(_cellSize.Height)
          );
 
-         _zoomWindow.SetScreenBounds(_currentScreen.Bounds);
-         _cellWindow.SetScreenBounds(_currentScreen.Bounds);
-
-         _zoomWindow.Move(
-            ScaleToWindow(mouseX) + offsetX,
-            ScaleToWindow(mouseY) + offsetY
-         );
-         _zoomWindow.Show();
+         // Our overlays are left out of the copy of the screen that's searched, so
+         // this can be done while they're up.
+         _targets = FindTargets(source);
+
+         BeginOverlays()
+            .Move(_cellWindow, cellX - 4, cellY - 4)
+            .Show(_cellWindow)
+            .SetSource(_zoomWindow, source.X, source.Y, source.Width, source.Height)
+            .SetTargets(_zoomWindow, _targets)
+            .SetScreenBounds(_zoomWindow, _currentScreen.Bounds)
+            .SetScreenBounds(_cellWindow, _currentScreen.Bounds)
+            .Move(_zoomWindow, ToWindowX(mouseX) + offsetX, ToWindowY(mouseY) + offsetY)
+            .Show(_zoomWindow)
+            .Commit();
 
          _isZoomed = true;
       }
 
       private int ScaleToScreen(int value) {
-         return (int)(value * _displayScaleMultiplier);
+         return (int)(value * DisplayScaleMultiplier);
       }
 
       private double ScaleToScreen(double value) {
-         return value * _displayScaleMultiplier;
+         return value * DisplayScaleMultiplier;
       }
 
       private int ScaleToWindow(int value) {
-         return (int)(value / _displayScaleMultiplier);
+         return (int)(value / DisplayScaleMultiplier);
       }
 
       private double ScaleToWindow(double value) {
-         return value / _displayScaleMultiplier;
+         return value / DisplayScaleMultiplier;
       }
+
+      // Plot coordinates are the screen's origin, in physical pixels, plus an
+      // offset in DIPs, so only the offset is scaled going to and from the screen.
+
+      private int ToScreenX(int x) =>
+         _currentScreen.Bounds.Left + ScaleToScreen(x - _currentScreen.Bounds.Left);
+
+      private int ToScreenY(int y) =>
+         _currentScreen.Bounds.Top + ScaleToScreen(y - _currentScreen.Bounds.Top);
+
+      private int ToWindowX(int x) =>
+         _currentScreen.Bounds.Left + ScaleToWindow(x - _currentScreen.Bounds.Left);
+
+      private int ToWindowY(int y) =>
+         _currentScreen.Bounds.Top + ScaleToWindow(y - _currentScreen.Bounds.Top);
    }
 }
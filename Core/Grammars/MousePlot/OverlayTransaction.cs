@@ -0,0 +1,114 @@
+﻿// Project Renfrew
+// Copyright(C) 2024 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+using System;
+using System.Collections.Generic;
+using System.Drawing;
+using System.Windows.Threading;
+
+namespace Renfrew.Core.Grammars.MousePlot {
+
+   /// <summary>
+   /// Describes the next state of the overlay windows (which are shown, where they
+   /// are, what's magnified, the colour), and applies it all at once: one work item
+   /// on the UI thread, so one layout pass and one wait, rather than one of each for
+   /// every call. The steps are applied in the order they were added.
+   /// </summary>
+   public sealed class OverlayTransaction {
+      private readonly Dispatcher _dispatcher;
+      private readonly List<Action> _steps = new List<Action>();
+
+      /// <param name="dispatcher">
+      /// The windows' dispatcher, or null to apply the steps on the calling thread
+      /// (e.g. for windows that aren't real windows).
+      /// </param>
+      public OverlayTransaction(Dispatcher dispatcher) {
+         _dispatcher = dispatcher;
+      }
+
+      public OverlayTransaction Close(IWindow window) =>
+         Add(window, window.Close);
+
+      public OverlayTransaction Close(IEnumerable<IWindow> windows) =>
+         ForEach(windows, e => Close(e));
+
+      public OverlayTransaction Move(IWindow window, double x, double y) =>
+         Add(window, () => window.Move(x, y));
+
+      public OverlayTransaction Rotate(IWindow window, double angle) =>
+         Add(window, () => window.Rotate(angle));
+
+      public OverlayTransaction SetColour(IWindow window, GridColour colour) =>
+         Add(window, () => window.SetColour(colour));
+
+      public OverlayTransaction SetColour(IEnumerable<IWindow> windows, GridColour colour) =>
+         ForEach(windows, e => SetColour(e, colour));
+
+      public OverlayTransaction SetScreenBounds(IWindow window, Rectangle bounds) =>
+         Add(window, () => window.SetScreenBounds(bounds));
+
+      public OverlayTransaction SetSource(IZoomWindow window, Int32 x, Int32 y, Int32 width, Int32 height) =>
+         Add(window, () => window.SetSource(x, y, width, height));
+
+      public OverlayTransaction SetTargets(IZoomWindow window, IReadOnlyList<Rectangle> targets) =>
+         Add(window, () => window.SetTargets(targets));
+
+      public OverlayTransaction Show(IWindow window) =>
+         Add(window, window.Show);
+
+      public OverlayTransaction Show(IEnumerable<IWindow> windows) =>
+         ForEach(windows, e => Show(e));
+
+      /// <summary>
+      /// Applies the steps, and waits until they have been.
+      /// </summary>
+      public void Commit() {
+         if (_steps.Count == 0)
+            return;
+
+         if (_dispatcher == null || _dispatcher.CheckAccess() == true) {
+            Apply();
+            return;
+         }
+
+         _dispatcher.BeginInvoke(DispatcherPriority.Send, new Action(Apply)).Wait();
+      }
+
+      private OverlayTransaction Add(IWindow window, Action step) {
+         if (window == null)
+            throw new ArgumentNullException(nameof(window));
+
+         _steps.Add(step);
+         return this;
+      }
+
+      private OverlayTransaction ForEach(IEnumerable<IWindow> windows, Action<IWindow> add) {
+         if (windows == null)
+            throw new ArgumentNullException(nameof(windows));
+
+         foreach (var window in windows)
+            add(window);
+
+         return this;
+      }
+
+      private void Apply() {
+         foreach (var step in _steps)
+            step();
+      }
+   }
+}
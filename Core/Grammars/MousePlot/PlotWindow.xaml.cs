@@ -16,57 +16,122 @@
 //
 
 using System;
-using System.Drawing;
 using System.Windows;
-using System.Windows.Controls;
-using System.Windows.Threading;
+using System.Windows.Media;
 
-using Brushes = System.Windows.Media.Brushes;
-using FontFamily = System.Windows.Media.FontFamily;
+using Renfrew.Utility;
+using Renfrew.Win32.Interop;
+
+using Rectangle = System.Drawing.Rectangle;
 
 namespace Renfrew.Core.Grammars.MousePlot {
    /// <summary>
    /// Interaction logic for PlotWindow.xaml
    /// </summary>
    public partial class PlotWindow : BaseWindow, IWindow {
-      public PlotWindow() {
+
+      private readonly GridRenderer _gridRenderer;
+
+      // The screen the window is kept on, if it's been given one
+      private Rectangle _screenBounds = Rectangle.Empty;
+
+      public PlotWindow()
+         : this(0) {
+
+      }
+
+      /// <param name="monitor">
+      /// The number of the monitor (1 - 9) to put before every label, or 0 for none.
+      /// </param>
+      public PlotWindow(Int32 monitor) {
+         if (monitor < 0 || monitor > 9)
+            throw new ArgumentOutOfRangeException(nameof(monitor));
+
+         // 100 x 100 cells, with dashed lines along their top and left edges, each
+         // labelled with its row and column. The shadow matches WPF's DropShadowEffect
+         // with a depth of 2 (at 315 degrees) and the default blur radius.
+         _gridRenderer = new GridRenderer(new GridOptions {
+            CellSize = 100,
+            DashLength = 11,
+            LabelOffset = 2,
+            LabelSize = 98,
+            LabelOpacity = 0.7,
+            LabelPrefix = monitor > 0 ? (Char) ('0' + monitor) : '\0',
+            FontFamily = "Consolas",
+            FontSize = 48,
+            ShadowOffset = 1.41,
+            ShadowBlur = 5,
+            ShadowOpacity = 1,
+         });
+
          InitializeComponent();
+
+         Closed += (s, args) => _gridRenderer.Dispose();
       }
 
       private void Canvas_Loaded(Object sender, RoutedEventArgs e) {
+         UpdateGrid();
+      }
 
-         for (int i = 0; i < 36; i++) {
-            for (int j = 0; j < 36; j++) {
-               if (i == 0 && j == 0)
-                  continue;
+      private void Canvas_SizeChanged(Object sender, SizeChangedEventArgs e) {
+         UpdateGrid();
+      }
+
+      protected override void OnColourChanged() {
+         UpdateGrid();
+      }
+
+      // Shows the grid for the current size, colour and DPI. The renderer keeps the
+      // bitmaps it draws, so this is usually just a lookup. Must be called on the UI
+      // thread.
+      private void UpdateGrid() {
+         var source = PresentationSource.FromVisual(this);
+
+         if (source == null)
+            return;
 
-               var label = new Label {
-                  Style = Resources["DigitLabel"] as Style,
-                  Content = $"{GetDigitValue(j)}{GetDigitValue(i)}",
-                  Margin = new Thickness(2 + i * 100, 2 + j * 100, 0, 0),
-               };
+         var colour = (Resources["BaseThemeColor"] as SolidColorBrush)?.Color ?? Colors.Yellow;
 
-               //label.MouseEnter += Label_MouseEnter;
-               //label.MouseLeave += Label_MouseLeave;
+         _grid.Source = _gridRenderer.Render(
+            mainCanvas.ActualWidth, mainCanvas.ActualHeight,
+            colour, Colors.Black,
+            source.CompositionTarget.TransformToDevice.M11
+         );
+      }
+
+      public override void WarmUp() {
 
-               mainCanvas.Children.Add(label);
+         // Warm up at the size it's maximized to, so that the full-screen grid is
+         // drawn (and cached) too.
+         Run(() => {
+            if (_screenBounds.IsEmpty == true) {
+               Width = SystemParameters.PrimaryScreenWidth;
+               Height = SystemParameters.PrimaryScreenHeight;
+               return;
             }
-         }
+
+            var scale = ScreenTopology.GetScale(
+               _screenBounds.Left + _screenBounds.Width / 2, _screenBounds.Top + _screenBounds.Height / 2
+            );
+
+            Width = _screenBounds.Width / scale;
+            Height = _screenBounds.Height / scale;
+         });
+
+         base.WarmUp();
       }
 
-      private String GetDigitValue(int i) {
-         if (i < 10)
-            return ((char)('0' + i)).ToString();
-         return ((char)('A' + i - 10)).ToString();
+      public override void SetScreenBounds(Rectangle rectangle) {
+         _screenBounds = rectangle;
       }
 
       public override void Move(Double x, Double y) {
-         Dispatcher.BeginInvoke(DispatcherPriority.Send, new Action(() => {
+         Run(() => {
             WindowState = WindowState.Normal;
             Left = x;
             Top = y;
             WindowState = WindowState.Maximized;
-         })).Wait();
+         });
       }
    }
 }
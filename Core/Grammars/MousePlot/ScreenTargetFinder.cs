@@ -0,0 +1,43 @@
+﻿// Project Renfrew
+// Copyright(C) 2024 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+
+using System;
+using System.Collections.Generic;
+using System.Drawing;
+using System.Linq;
+
+using Renfrew.Utility;
+
+namespace Renfrew.Core.Grammars.MousePlot {
+
+   /// <summary>
+   /// Finds targets in a copy of the screen (see <see cref="TargetFinder"/>).
+   /// </summary>
+   public class ScreenTargetFinder : ITargetFinder, IDisposable {
+      private readonly TargetFinder _finder = new TargetFinder();
+
+      public IReadOnlyList<Rectangle> Find(Rectangle area) =>
+         _finder.Find(area.X, area.Y, area.Width, area.Height)
+            .Select(e => new Rectangle(e.X, e.Y, e.Width, e.Height))
+            .ToList();
+
+      public void Dispose() {
+         _finder.Dispose();
+      }
+   }
+}
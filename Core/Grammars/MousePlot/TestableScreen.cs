@@ -21,11 +21,22 @@ using System.Linq;
 using System.Runtime.InteropServices;
 using System.Windows.Forms;
 
+using Microsoft.Win32;
+
+using Renfrew.Win32.Interop;
+
 namespace Renfrew.Core.Grammars.MousePlot {
    public class TestableScreen : IScreen {
 
+      // Screen wrappers are cached until the display settings change.
+      private static IScreen[] _allScreens;
+
       private Screen _screen;
 
+      static TestableScreen() {
+         SystemEvents.DisplaySettingsChanged += (s, e) => _allScreens = null;
+      }
+
       public TestableScreen() {
          _screen = Screen.PrimaryScreen;
       }
@@ -35,12 +46,15 @@ namespace Renfrew.Core.Grammars.MousePlot {
       }
 
       public IScreen[] AllScreens =>
-         Screen.AllScreens.Select(e => (IScreen) new TestableScreen(e)).ToArray();
+         _allScreens ?? (_allScreens = Screen.AllScreens.Select(e => (IScreen) new TestableScreen(e)).ToArray());
 
       public Rectangle Bounds =>
          _screen.Bounds;
 
       public IScreen PrimaryScreen =>
          new TestableScreen(Screen.PrimaryScreen);
+
+      public Double Scale =>
+         ScreenTopology.GetScale(Bounds.Left + Bounds.Width / 2, Bounds.Top + Bounds.Height / 2);
    }
 }
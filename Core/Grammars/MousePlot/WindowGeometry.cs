@@ -0,0 +1,46 @@
+﻿// Project Renfrew
+// Copyright(C) 2024 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+using System;
+
+namespace Renfrew.Core.Grammars.MousePlot {
+
+   /// <summary>
+   /// A window's position and size at one point in time. Never changed once created,
+   /// so it can be handed between threads without locking.
+   /// </summary>
+   public sealed class WindowGeometry {
+      public static readonly WindowGeometry Empty =
+         new WindowGeometry(Double.NaN, Double.NaN, Double.NaN, Double.NaN);
+
+      public WindowGeometry(double left, double top, double width, double height) {
+         Left = left;
+         Top = top;
+         Width = width;
+         Height = height;
+      }
+
+      public double Left { get; }
+      public double Top { get; }
+
+      public double Width { get; }
+      public double Height { get; }
+
+      public override String ToString() =>
+         $"{Left}, {Top} ({Width} x {Height})";
+   }
+}
@@ -16,13 +16,17 @@
 //
 
 using System;
+using System.Collections.Generic;
 using System.Drawing;
+using System.Globalization;
 using System.Runtime.InteropServices;
-using System.Threading;
 using System.Windows;
 using System.Windows.Controls;
 using System.Windows.Controls.Primitives;
-using System.Windows.Threading;
+using System.Windows.Media;
+
+using NLog;
+
 using Renfrew.Utility;
 
 namespace Renfrew.Core.Grammars.MousePlot {
@@ -30,14 +34,41 @@ namespace Renfrew.Core.Grammars.MousePlot {
    /// Interaction logic for ZoomWindow.xaml
    /// </summary>
    public partial class ZoomWindow : BaseWindow, IZoomWindow {
+      private static Logger _logger = LogManager.GetCurrentClassLogger();
+
+      // How much the cell is enlarged by. The grid drawn over the zoom window
+      // (9 x 9 sub-cells) is laid out for this size.
+      private const double Magnification = 3.0;
+
+      // The size of the grid drawn over the magnifier
+      private const double GridSize = 312;
+
+      // 9 x 9 sub-cells with dotted lines, labelled with their row and column. The
+      // "shadow" is a copy of the grid in the theme's contrasting colour, one unit
+      // down and to the right, so that it can be read over anything.
+      private readonly GridRenderer _gridRenderer = new GridRenderer(new GridOptions {
+         CellSize = 33.3333,
+         LineOffset = 5,
+         DashLength = 1,
+         Cells = 9,
+         LabelOffset = 5,
+         LabelSize = 33.3333,
+         LabelOpacity = 0.5,
+         FontFamily = "Consolas",
+         FontSize = 15,
+         ShadowOffset = 1,
+         ShadowOpacity = 1,
+      });
 
       private Magnifier _magnifier;
-      private Timer _timer;
+      private RefreshScheduler _scheduler;
       private Rectangle _sourceRectangle;
       private double _scaleMultiplier = 1;
 
       private Rectangle _screenBounds = Rectangle.Empty;
 
+      private IReadOnlyList<Rectangle> _targets = new Rectangle[0];
+
       [DllImport("user32.dll", SetLastError = true)]
       private static extern int SetWindowPos(IntPtr hWnd, IntPtr hwndInsertAfter, int x, int y, int cx, int cy, int wFlags);
 
@@ -48,71 +79,97 @@ namespace Renfrew.Core.Grammars.MousePlot {
       }
 
       private void Window_Loaded(Object sender, RoutedEventArgs e) {
-         for (int i = 0; i < 9; i++) {
-            for (int j = 0; j < 9; j++) {
+         UpdateGrid();
 
-               var label = new Label {
-                  Style = Resources["ZoomDigitLabel"] as Style,
-                  Content = $"{GetDigitValue(j)}{GetDigitValue(i)}",
-
-                  Margin = new Thickness(5 + i * 33.3333, 5 + j * 33.3333, 0, 0),
-               };
+         _magnifierSurface.Child = _magnifier;
+         _magnifier.Initialize(_scaleMultiplier);
+         _magnifier.SetMagnification(Magnification);
 
-               var rearLabel = new Label {
-                  Style = Resources["ZoomRearDigitLabel"] as Style,
-                  Content = $"{GetDigitValue(j)}{GetDigitValue(i)}",
+         _popup.Focus();
 
-                  Margin = new Thickness(5 + i * 33.3333, 5 + j * 33.3333, 0, 0),
-               };
+         // Only refresh the magnifier while it can be seen
+         _scheduler = new RefreshScheduler(_magnifier);
 
-               _mainCanvas.Children.Add(label);
-               _rearCanvas.Children.Add(rearLabel);
+         IsVisibleChanged += (s, args) => {
+            if ((bool) args.NewValue == true) {
+               _scheduler.Resume();
+               return;
             }
-         }
 
+            _scheduler.Suspend();
 
-         _magnifierSurface.Child = _magnifier;
-         _magnifier.Initialize(_scaleMultiplier);
+            var statistics = _scheduler.Statistics;
 
-         _popup.Focus();
+            _logger.Debug(
+               $"Magnifier: {statistics.Updates} updates in {statistics.Frames} frames, " +
+               $"{statistics.AverageFrameTime:F2} ms/frame, {statistics.AverageUpdateTime:F2} ms/update, " +
+               $"{statistics.CpuUsage:P1} CPU"
+            );
+         };
 
-         _timer = new Timer(state => {
+         Closed += (s, args) => {
+            _scheduler.Dispose();
+            _gridRenderer.Dispose();
+         };
 
-            if (_screenBounds.IsEmpty == false) {
-               var r = Rectangle.Intersect(_screenBounds, _sourceRectangle);
+         UpdateSource();
 
-               Dispatcher.BeginInvoke(DispatcherPriority.Send, new Action(() => {
-                  _magnifierSurface.Height = r.Height * 3 / _scaleMultiplier;
-                  _magnifierSurface.Width = r.Width * 3 / _scaleMultiplier;
-               }));
-            }
-
-            _magnifier.Update(
-               _sourceRectangle.X, _sourceRectangle.Y,
-               _sourceRectangle.Width, _sourceRectangle.Height - 30
-            );
+         if (IsVisible == true)
+            _scheduler.Resume();
+      }
 
-            _timer.Change(1, Timeout.Infinite);
-         }, null, 1, Timeout.Infinite);
+      protected override void OnColourChanged() {
+         UpdateGrid();
       }
 
-      private String GetDigitValue(int i) {
-         if (i < 10)
-            return ((char)('0' + i)).ToString();
-         return ((char)('A' + i - 10)).ToString();
+      // Shows the grid in the current colours. Must be called on the UI thread.
+      private void UpdateGrid() {
+         var source = PresentationSource.FromVisual(this);
+
+         if (source == null)
+            return;
+
+         var colour = (Resources["BaseThemeColor"] as SolidColorBrush)?.Color ?? Colors.Yellow;
+         var contrast = (Resources["BaseThemeContrastColor"] as SolidColorBrush)?.Color ?? Colors.Black;
+
+         _grid.Source = _gridRenderer.Render(
+            GridSize, GridSize, colour, contrast,
+            source.CompositionTarget.TransformToDevice.M11
+         );
       }
 
       public override void Close() {
          base.Close();
 
          // Hide the overlaid grid (popup)
-         Dispatcher.BeginInvoke(DispatcherPriority.Send, new Action(() => {
+         Run(() => {
             _popup.IsOpen = false;
-         })).Wait();
+         });
+      }
+
+      public override void WarmUp() {
+
+         // Popups are kept on the screen, so don't let the grid show while the
+         // window is being warmed up off it.
+         Run(() => {
+            _popup.IsOpen = false;
+         });
+
+         base.WarmUp();
       }
 
       public void SetScaleMultiplier(double multiplier) {
-         _scaleMultiplier = multiplier;
+         Run(() => {
+            if (_scaleMultiplier == multiplier)
+               return;
+
+            // The magnifier is sized when the window is loaded (which can happen
+            // while warming up, before a screen is chosen), so it's resized here.
+            _scaleMultiplier = multiplier;
+            _magnifier.SetScaleMultiplier(multiplier);
+
+            UpdateSource();
+         });
       }
 
       public void SetSource(Int32 x, Int32 y, Int32 width, Int32 height) {
@@ -120,18 +177,92 @@ namespace Renfrew.Core.Grammars.MousePlot {
       }
 
       public void SetSource(Rectangle sourceRectangle) {
-         _sourceRectangle = sourceRectangle;
+         Run(() => {
+            _sourceRectangle = sourceRectangle;
+            UpdateSource();
+         });
+      }
+
+      public void SetTargets(IReadOnlyList<Rectangle> targets) {
+         Run(() => {
+            _targets = targets ?? new Rectangle[0];
+            UpdateTargets();
+         });
       }
 
       public override void SetScreenBounds(Rectangle rectangle) {
-         _screenBounds = rectangle;
+         Run(() => {
+            _screenBounds = rectangle;
+            UpdateSource();
+         });
+      }
+
+      // Sizes the magnifier to the part of the source that's on the screen, and
+      // passes the source on to the scheduler. Must be called on the UI thread.
+      private void UpdateSource() {
+         if (_screenBounds.IsEmpty == false) {
+            var r = Rectangle.Intersect(_screenBounds, _sourceRectangle);
+
+            _magnifierSurface.Height = r.Height * Magnification / _scaleMultiplier;
+            _magnifierSurface.Width = r.Width * Magnification / _scaleMultiplier;
+         }
+
+         _scheduler?.SetSource(
+            _sourceRectangle.X, _sourceRectangle.Y,
+            _sourceRectangle.Width, _sourceRectangle.Height
+         );
+
+         UpdateTargets();
+      }
+
+      // Outlines and numbers the targets where they are in the magnified image. Uses
+      // the theme's colours, so they change with the grid. Must be called on the UI
+      // thread.
+      private void UpdateTargets() {
+         _targetLayer.Children.Clear();
+
+         var scale = Magnification / _scaleMultiplier;
+
+         for (var i = 0; i < _targets.Count; i++) {
+            var target = _targets[i];
+
+            var left = (target.X - _sourceRectangle.X) * scale;
+            var top = (target.Y - _sourceRectangle.Y) * scale;
+
+            var box = new System.Windows.Shapes.Rectangle {
+               Width = target.Width * scale,
+               Height = target.Height * scale,
+               StrokeThickness = 2,
+               RadiusX = 3,
+               RadiusY = 3,
+            };
+            box.SetResourceReference(System.Windows.Shapes.Shape.StrokeProperty, "BaseThemeColor");
+
+            var label = new TextBlock {
+               Text = (i + 1).ToString(CultureInfo.InvariantCulture),
+               FontFamily = new System.Windows.Media.FontFamily("Consolas"),
+               FontSize = 15,
+               FontWeight = FontWeights.Bold,
+               Padding = new Thickness(3, 0, 3, 0),
+            };
+            label.SetResourceReference(TextBlock.BackgroundProperty, "BaseThemeColor");
+            label.SetResourceReference(TextBlock.ForegroundProperty, "BaseThemeContrastColor");
+
+            Canvas.SetLeft(box, left);
+            Canvas.SetTop(box, top);
+            Canvas.SetLeft(label, left);
+            Canvas.SetTop(label, top);
+
+            _targetLayer.Children.Add(box);
+            _targetLayer.Children.Add(label);
+         }
       }
 
       public override void Show() {
          base.Show();
 
          // Show the overlaid grid (popup)
-         Dispatcher.BeginInvoke(DispatcherPriority.Send, new Action(() => {
+         Run(() => {
 
             // Use absolute coordinates. Relative ones seem to behave oddly on some systems.
             _popup.Placement = PlacementMode.Absolute;
@@ -143,7 +274,7 @@ namespace Renfrew.Core.Grammars.MousePlot {
             // Show the popup (the grid).
             _popup.IsOpen = true;
 
-         })).Wait();
+         });
 
       }
    }
@@ -22,6 +22,7 @@ using System.Linq;
 namespace Renfrew.Grammar.Dragon {
    using Elements;
    using Exceptions;
+   using FluentApi;
 
    public class RuleDefinitionFactory {
       private readonly RuleDirectiveFactory _ruleDirectiveFactory;
@@ -51,13 +52,24 @@ namespace Renfrew.Grammar.Dragon {
          return tmp;
       }
 
-      public IEnumerable<IEnumerable<RuleDirective>> CreateDefinitionTables(Grammar grammar) {
+      public IEnumerable<IEnumerable<RuleDirective>> CreateDefinitionTables(Grammar grammar) =>
+         CreateDefinitionTables(grammar.Rules, grammar.RuleIds, grammar.WordIds);
+
+      /// <summary>
+      /// Creates the definition tables for a subset of a grammar's rules, using
+      /// the given (possibly renumbered) rule and word ids.
+      /// </summary>
+      public IEnumerable<IEnumerable<RuleDirective>> CreateDefinitionTables(
+         IEnumerable<IRule> rules,
+         IReadOnlyDictionary<String, UInt32> ruleIds,
+         IReadOnlyDictionary<String, UInt32> wordIds) {
+
          var ruleDirectives = new List<IEnumerable<RuleDirective>>();
 
-         _wordLookup = grammar.WordIds;
-         _ruleLookup = grammar.RuleIds;
+         _wordLookup = wordIds;
+         _ruleLookup = ruleIds;
 
-         foreach (var rule in grammar.Rules)
+         foreach (var rule in rules)
             ruleDirectives.Add( CreateDefinitionTable(rule.Elements) );
 
          return ruleDirectives;
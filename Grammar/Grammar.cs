@@ -22,6 +22,7 @@ using System.Diagnostics;
 using System.Linq;
 using System.Linq.Expressions;
 using System.Text.RegularExpressions;
+using System.Threading;
 
 using Renfrew.Grammar.Elements;
 using Renfrew.Grammar.Exceptions;
@@ -45,6 +46,21 @@ namespace Renfrew.Grammar {
 
       private readonly Dictionary<String, UInt32> _activeRules;
 
+      // Load-on-demand state (see LoadOnDemand)
+      private readonly Object _loadLock = new Object();
+
+      private TriggerGrammar _triggerGrammar;
+      private Timer _idleTimer;
+      private TimeSpan _idleTimeout;
+      private DateTime _lastUsed;
+
+      // The context of the thread that owns the engine's objects (the one the grammar
+      // was loaded on). The idle timer unloads the grammar there, not on its own thread.
+      private SynchronizationContext _synchronizationContext;
+
+      private bool _isLoaded = false;
+      private bool _isExclusive = false;
+
       protected Grammar(IGrammarService grammarService)
          : this(new RuleFactory(), grammarService) {
 
@@ -68,10 +84,16 @@ namespace Renfrew.Grammar {
       }
 
       public void ActivateRule(String name) {
-         _grammarService.ActivateRule(this, IntPtr.Zero, name);
+         lock (_loadLock) {
+
+            // While a load-on-demand grammar is unloaded, just remember which
+            // rules should be activated once it's loaded again.
+            if (IsInEngine == true)
+               _grammarService.ActivateRule(this, IntPtr.Zero, name);
 
-         if (_activeRules.ContainsKey(name) == false)
-            _activeRules.Add(name, _ruleIds[name]);
+            if (_activeRules.ContainsKey(name) == false)
+               _activeRules.Add(name, _ruleIds[name]);
+         }
       }
 
       public void AddRule(String name, IRule rule) {
@@ -104,10 +126,13 @@ namespace Renfrew.Grammar {
          AddRule(name, ruleFunc?.Invoke(RuleFactory.Create()));
 
       public void DeactivateRule(String name) {
-         _grammarService.DeactivateRule(this, name);
+         lock (_loadLock) {
+            if (IsInEngine == true)
+               _grammarService.DeactivateRule(this, name);
 
-         if (_activeRules.ContainsKey(name) == true)
-            _activeRules.Remove(name);
+            if (_activeRules.ContainsKey(name) == true)
+               _activeRules.Remove(name);
+         }
       }
 
       public abstract void Dispose();
@@ -127,15 +152,145 @@ namespace Renfrew.Grammar {
       public abstract void Initialize();
 
       protected void Load() {
-         _grammarService.LoadGrammar(this);
+         lock (_loadLock) {
+            _grammarService.LoadGrammar(this);
+            _isLoaded = true;
+         }
+      }
+
+      /// <summary>
+      /// Loads only a small trigger rule into the engine, instead of the whole grammar.
+      /// The grammar is loaded the first time the trigger is recognized (the trigger's
+      /// words are then invoked against the grammar's active rules), and unloaded again
+      /// once it has gone unused for <paramref name="idleTimeout"/>. Only one of the two
+      /// is in the engine at a time.
+      /// </summary>
+      /// <param name="trigger">The trigger rule. It's made of words only (it can't refer
+      /// to the grammar's rules), and each of its phrases must also be a whole phrase of
+      /// one of the grammar's initially active rules, such as the opening word of a
+      /// command that takes optional words after it.</param>
+      /// <param name="idleTimeout">How long the grammar stays loaded while unused.</param>
+      protected void LoadOnDemand(Func<IRule, IRule> trigger, TimeSpan idleTimeout) {
+         if (trigger == null)
+            throw new ArgumentNullException(nameof(trigger));
+
+         if (idleTimeout <= TimeSpan.Zero)
+            throw new ArgumentOutOfRangeException(nameof(idleTimeout));
+
+         lock (_loadLock) {
+            if (_isLoaded == true || _triggerGrammar != null)
+               throw new InvalidOperationException("Grammar has already been loaded.");
+
+            _idleTimeout = idleTimeout;
+            _idleTimer = new Timer(e => OnIdleTimer());
+            _synchronizationContext = SynchronizationContext.Current;
+
+            _triggerGrammar = new TriggerGrammar(_grammarService, this, trigger);
+            _triggerGrammar.Initialize();
+         }
+      }
+
+      /// <summary>
+      /// Called when the trigger of a load-on-demand grammar is recognized.
+      /// </summary>
+      internal void InvokeFromTrigger(IEnumerable<String> spokenWords) {
+         lock (_loadLock) {
+            if (_isLoaded == false) {
+               Debug.WriteLine($"Loading {GetType().Name} on demand.");
+
+               _grammarService.LoadGrammar(this);
+               _isLoaded = true;
+
+               foreach (var name in _activeRules.Keys)
+                  _grammarService.ActivateRule(this, IntPtr.Zero, name);
+
+               if (_isExclusive == true)
+                  _grammarService.SetExclusiveGrammar(this, true);
+
+               // The grammar's own rules will take it from here.
+               _triggerGrammar.Detach();
+            }
+         }
+
+         InvokeRule(spokenWords);
+      }
+
+      private void OnIdleTimer() {
+         if (_synchronizationContext == null) {
+            UnloadIfIdle();
+            return;
+         }
+
+         _synchronizationContext.Post(e => UnloadIfIdle(), null);
+      }
+
+      private void UnloadIfIdle() {
+         lock (_loadLock) {
+            if (_isLoaded == false || _idleTimer == null)
+               return;
+
+            // Don't pull the grammar out from under an interaction that's still in progress.
+            if (_isExclusive == true) {
+               ResetIdleTimer();
+               return;
+            }
+
+            // The grammar may have been used while the unload was waiting for its thread.
+            var idle = DateTime.UtcNow - _lastUsed;
+
+            if (idle < _idleTimeout) {
+               _idleTimer.Change(_idleTimeout - idle, Timeout.InfiniteTimeSpan);
+               return;
+            }
+
+            Debug.WriteLine($"Unloading idle {GetType().Name}.");
+
+            _grammarService.UnloadGrammar(this);
+            _isLoaded = false;
+
+            _triggerGrammar.Attach();
+         }
+      }
+
+      private void ResetIdleTimer() {
+         _lastUsed = DateTime.UtcNow;
+         _idleTimer?.Change(_idleTimeout, Timeout.InfiniteTimeSpan);
+      }
+
+      /// <summary>
+      /// Takes the grammar (and the trigger of a load-on-demand grammar) out of the
+      /// engine, and stops its idle timer. Meant for <see cref="Dispose"/>.
+      /// </summary>
+      protected void Unload() {
+         lock (_loadLock) {
+            _idleTimer?.Dispose();
+            _idleTimer = null;
+
+            if (_isLoaded == true) {
+               _grammarService.UnloadGrammar(this);
+               _isLoaded = false;
+            }
+
+            _triggerGrammar?.Unload();
+         }
       }
 
       protected void MakeGrammarExclusive() {
-         _grammarService.SetExclusiveGrammar(this, true);
+         lock (_loadLock) {
+            if (IsInEngine == true)
+               _grammarService.SetExclusiveGrammar(this, true);
+
+            _isExclusive = true;
+         }
       }
 
       protected void MakeGrammarNotExclusive() {
-         _grammarService.SetExclusiveGrammar(this, false);
+         lock (_loadLock) {
+            if (IsInEngine == true)
+               _grammarService.SetExclusiveGrammar(this, false);
+
+            _isExclusive = false;
+         }
       }
 
       protected void RemoveRule(String name) {
@@ -149,7 +304,7 @@ namespace Renfrew.Grammar {
 
       }
 
-      private IEnumerable<String> GetWordsFromRule(IRule rule) {
+      internal IEnumerable<String> GetWordsFromRule(IRule rule) {
          return GetWordsFromRuleElements(rule.Elements.Elements);
       }
 
@@ -170,11 +325,14 @@ namespace Renfrew.Grammar {
          }
       }
 
-      public void InvokeRule(IEnumerable<String> spokenWords) {
+      public virtual void InvokeRule(IEnumerable<String> spokenWords) {
 
          if (spokenWords == null)
             throw new ArgumentNullException(nameof(spokenWords));
 
+         // Keep load-on-demand grammars loaded while they're in use.
+         ResetIdleTimer();
+
          // Make sure there is at least one rule activated
          if (_activeRules.Any() == false)
             throw new NoActiveRulesException();
@@ -339,11 +497,40 @@ namespace Renfrew.Grammar {
          ActivateRule(name);
       }
 
+      /// <summary>
+      /// Called once the grammar has been initialized, to build anything that would
+      /// otherwise make its first use slow (e.g. windows). Does nothing by default.
+      /// </summary>
+      public virtual void WarmUp() { }
+
+      /// <summary>
+      /// Whether the grammar is (or should be treated as being) loaded into the engine.
+      /// Grammars that aren't loaded on demand always are.
+      /// </summary>
+      private bool IsInEngine => _triggerGrammar == null || _isLoaded == true;
+
       protected RuleFactory RuleFactory { get; private set; }
 
       public IReadOnlyDictionary<String, UInt32> RuleIds => _ruleIds;
 
+      /// <summary>
+      /// Gets the names of the rules that the elements refer to (but not the rules
+      /// that those rules refer to).
+      /// </summary>
+      internal static IEnumerable<String> GetReferencedRules(IEnumerable<IElement> elements) {
+         foreach (var element in elements) {
+            if (element is IRuleElement) {
+               yield return element.ToString();
+            } else if (element is IElementContainer) {
+               foreach (var ruleName in GetReferencedRules((element as IElementContainer).Elements))
+                  yield return ruleName;
+            }
+         }
+      }
+
       // Expose internally for serialization
+      internal IRule GetRule(String name) => _rules[name];
+
       internal IReadOnlyList<IRule> Rules =>
          _rulesById.OrderBy(e => e.Key).Select(e => e.Value).ToList();
 
@@ -0,0 +1,215 @@
+﻿// Project Renfrew
+// Copyright(C) 2024 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Linq.Expressions;
+using System.Reflection;
+using System.Xml.Linq;
+
+using NLog;
+
+using Renfrew.NatSpeakInterop;
+
+namespace Renfrew.Grammar {
+
+   /// <summary>
+   /// A list of the grammars exported by an assembly. The manifest is generated at
+   /// build time (by Core's GenerateGrammarManifest.ps1), so that grammars can
+   /// be created at start-up without scanning every type in the assembly.
+   /// </summary>
+   public class GrammarManifest {
+
+      private static Logger _logger = LogManager.GetCurrentClassLogger();
+
+      public const String FileExtension = ".grammars";
+
+      private readonly List<GrammarManifestEntry> _entries;
+
+      public GrammarManifest(Guid moduleVersionId, IEnumerable<GrammarManifestEntry> entries) {
+         if (entries == null)
+            throw new ArgumentNullException(nameof(entries));
+
+         ModuleVersionId = moduleVersionId;
+         _entries = entries.ToList();
+      }
+
+      public IReadOnlyList<GrammarManifestEntry> Entries => _entries;
+
+      /// <summary>
+      /// The id of the build of the assembly that the manifest was generated from.
+      /// </summary>
+      public Guid ModuleVersionId { get; }
+
+      /// <summary>
+      /// Builds a manifest by scanning the given assembly for exported grammars.
+      /// </summary>
+      public static GrammarManifest FromAssembly(Assembly assembly) {
+         if (assembly == null)
+            throw new ArgumentNullException(nameof(assembly));
+
+         var entries = new List<GrammarManifestEntry>();
+
+         // Get a list of all of the classes marked with the GrammarExportAttribute.
+         var types = assembly.GetTypes()
+            .Select(e => new {
+               Type = e,
+               Attr = e.GetCustomAttributes<GrammarExportAttribute>().FirstOrDefault()
+            }).Where(e => e.Attr != null && e.Type.IsClass);
+
+         foreach (var type in types) {
+
+            // Make sure the class extends from the Grammar base class.
+            if (type.Type.IsSubclassOf(typeof(Grammar)) == false) {
+               var fileName = Path.GetFileName(assembly.Location);
+
+               _logger.Warn(
+                  $"Class '{type.Type.FullName}' in {fileName} marked as exported grammar, " +
+                  $"but it does not extend {typeof(Grammar).FullName}. Ignoring."
+               );
+
+               continue;
+            }
+
+            entries.Add(new GrammarManifestEntry(
+               type.Attr.Name, type.Attr.Description, type.Type.FullName
+            ));
+         }
+
+         return new GrammarManifest(assembly.ManifestModule.ModuleVersionId, entries);
+      }
+
+      /// <summary>
+      /// Gets the path of the manifest file that belongs to the given assembly.
+      /// </summary>
+      public static String GetManifestPath(Assembly assembly) {
+         if (assembly == null)
+            throw new ArgumentNullException(nameof(assembly));
+
+         return GetManifestPath(assembly.Location);
+      }
+
+      public static String GetManifestPath(String assemblyPath) =>
+         Path.ChangeExtension(assemblyPath, FileExtension);
+
+      /// <summary>
+      /// Checks whether the manifest was generated from this exact build of the assembly.
+      /// </summary>
+      public bool IsCurrentFor(Assembly assembly) {
+         if (assembly == null)
+            throw new ArgumentNullException(nameof(assembly));
+
+         return ModuleVersionId == assembly.ManifestModule.ModuleVersionId;
+      }
+
+      /// <summary>
+      /// Reads a manifest from disk.
+      /// </summary>
+      /// <returns>The manifest, or null if it doesn't exist or can't be read.</returns>
+      public static GrammarManifest Load(String path) {
+         if (File.Exists(path) == false)
+            return null;
+
+         try {
+            var root = XDocument.Load(path).Root;
+
+            var entries = root.Elements("Grammar").Select(e => new GrammarManifestEntry(
+               (String) e.Attribute("Name"),
+               (String) e.Attribute("Description") ?? String.Empty,
+               (String) e.Attribute("Type")
+            ));
+
+            return new GrammarManifest(Guid.Parse((String) root.Attribute("ModuleVersionId")), entries);
+         } catch (Exception e) {
+            _logger.Warn(e, $"Could not read grammar manifest '{path}'.");
+            return null;
+         }
+      }
+
+      public void Save(String path) {
+         var document = new XDocument(
+            new XElement("GrammarManifest",
+               new XAttribute("ModuleVersionId", ModuleVersionId),
+               _entries.Select(e => new XElement("Grammar",
+                  new XAttribute("Name", e.Name),
+                  new XAttribute("Description", e.Description),
+                  new XAttribute("Type", e.TypeName)
+               ))
+            )
+         );
+
+         document.Save(path);
+      }
+   }
+
+   public class GrammarManifestEntry {
+      private Assembly _factoryAssembly;
+      private Func<IGrammarService, Grammar> _factory;
+
+      public GrammarManifestEntry(String name, String description, String typeName) {
+         if (String.IsNullOrWhiteSpace(typeName) == true)
+            throw new ArgumentException("Value cannot be null or whitespace.", nameof(typeName));
+
+         Name = name ?? typeName;
+         Description = description ?? String.Empty;
+         TypeName = typeName;
+      }
+
+      public String Name { get; }
+      public String Description { get; }
+      public String TypeName { get; }
+
+      /// <summary>
+      /// Creates a delegate that constructs the grammar directly, rather than
+      /// going through <see cref="Activator"/> or reflection for every instance.
+      /// The delegate is compiled once per entry and reused.
+      /// </summary>
+      /// <returns>The factory, or null if the type is missing or can't be constructed.</returns>
+      public Func<IGrammarService, Grammar> CreateFactory(Assembly assembly) {
+         if (assembly == null)
+            throw new ArgumentNullException(nameof(assembly));
+
+         if (_factory != null && _factoryAssembly == assembly)
+            return _factory;
+
+         var type = assembly.GetType(TypeName, false);
+
+         if (type == null || type.IsAbstract == true || type.IsSubclassOf(typeof(Grammar)) == false)
+            return null;
+
+         var constructor = type.GetConstructor(new[] { typeof(IGrammarService) });
+
+         if (constructor == null)
+            return null;
+
+         var grammarService = Expression.Parameter(typeof(IGrammarService), "grammarService");
+
+         _factory = Expression.Lambda<Func<IGrammarService, Grammar>>(
+            Expression.Convert(Expression.New(constructor, grammarService), typeof(Grammar)),
+            grammarService
+         ).Compile();
+         _factoryAssembly = assembly;
+
+         return _factory;
+      }
+
+      public override String ToString() =>
+         $"{Name} ({TypeName})";
+   }
+}
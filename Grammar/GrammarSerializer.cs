@@ -25,6 +25,7 @@ using System.Text;
 using NLog;
 
 using Renfrew.Grammar.Dragon;
+using Renfrew.Grammar.Elements;
 using Renfrew.Grammar.FluentApi;
 using Renfrew.NatSpeakInterop;
 
@@ -44,17 +45,42 @@ namespace Renfrew.Grammar {
       private const UInt32 SRCKCFG_IMPORTRULES = 5;
       #endregion
 
+      #region Partitioning
+      /// <summary>
+      /// A set of rules that have to be loaded together, along with the words they use.
+      /// </summary>
+      private class RuleGroup {
+         public RuleGroup() {
+            RuleNames = new HashSet<String>(StringComparer.CurrentCultureIgnoreCase);
+            Words = new HashSet<String>(StringComparer.CurrentCultureIgnoreCase);
+         }
+
+         public HashSet<String> RuleNames { get; }
+         public HashSet<String> Words { get; }
+
+         public Int32 CountWordsWith(RuleGroup other) =>
+            Words.Count + other.Words.Count(e => Words.Contains(e) == false);
+
+         public void Merge(RuleGroup other) {
+            RuleNames.UnionWith(other.RuleNames);
+            Words.UnionWith(other.Words);
+         }
+      }
+      #endregion
+
       public GrammarSerializer() {
 
       }
 
-      private byte[] BuildRulesChunk(Grammar grammar) {
+      private byte[] BuildRulesChunk(IEnumerable<IRule> rules,
+                                     IReadOnlyDictionary<String, UInt32> ruleIds,
+                                     IReadOnlyDictionary<String, UInt32> wordIds) {
          var memoryStream = new MemoryStream();
          var stream = new BinaryWriter(memoryStream);
 
          var definitionFactory = new RuleDefinitionFactory(new RuleDirectiveFactory());
 
-         var tables = definitionFactory.CreateDefinitionTables(grammar);
+         var tables = definitionFactory.CreateDefinitionTables(rules, ruleIds, wordIds);
 
          Int32 ruleNumber = 1;
          foreach (var table in tables) {
@@ -115,6 +141,65 @@ namespace Renfrew.Grammar {
          }
       }
 
+      private GrammarPartition CreatePartition(Grammar grammar, RuleGroup group) {
+
+         // Renumber the rules and words from 1, keeping their original order.
+         var ruleIds = new Dictionary<String, UInt32>(StringComparer.CurrentCultureIgnoreCase);
+         var wordIds = new Dictionary<String, UInt32>(StringComparer.CurrentCultureIgnoreCase);
+
+         foreach (var rule in grammar.RuleIds.OrderBy(e => e.Value)) {
+            if (group.RuleNames.Contains(rule.Key) == true)
+               ruleIds.Add(rule.Key, (UInt32) ruleIds.Count + 1);
+         }
+
+         foreach (var word in grammar.WordIds.OrderBy(e => e.Value)) {
+            if (group.Words.Contains(word.Key) == true)
+               wordIds.Add(word.Key, (UInt32) wordIds.Count + 1);
+         }
+
+         var bytes = Serialize(
+            ruleIds, wordIds, ruleIds.OrderBy(e => e.Value).Select(e => grammar.GetRule(e.Key))
+         );
+
+         return new GrammarPartition(ruleIds.Keys, bytes, wordIds.Count);
+      }
+
+      /// <summary>
+      /// Groups the grammar's rules so that rules that refer to each other (directly
+      /// or not) always end up in the same group.
+      /// </summary>
+      private IEnumerable<RuleGroup> GetRuleGroups(Grammar grammar) {
+         var parents = grammar.RuleIds.Values.ToDictionary(e => e, e => e);
+
+         UInt32 Find(UInt32 id) {
+            while (parents[id] != id)
+               id = parents[id] = parents[parents[id]];
+
+            return id;
+         }
+
+         foreach (var rule in grammar.RuleIds) {
+            foreach (var ruleName in Grammar.GetReferencedRules(grammar.GetRule(rule.Key).Elements.Elements)) {
+               if (grammar.RuleIds.TryGetValue(ruleName, out var referencedId) == true)
+                  parents[Find(referencedId)] = Find(rule.Value);
+            }
+         }
+
+         return grammar.RuleIds
+            .OrderBy(e => e.Value)
+            .GroupBy(e => Find(e.Value))
+            .Select(rules => {
+               var group = new RuleGroup();
+
+               foreach (var rule in rules) {
+                  group.RuleNames.Add(rule.Key);
+                  group.Words.UnionWith(grammar.GetWordsFromRule(grammar.GetRule(rule.Key)));
+               }
+
+               return group;
+            }).ToList();
+      }
+
       private Int32 GetPaddedStringLength(String s) {
          var numBytes = Encoding.Unicode.GetByteCount(s) + 2;
          var diff = numBytes % sizeof(Int32);
@@ -126,7 +211,62 @@ namespace Renfrew.Grammar {
          return numBytes;
       }
 
+      /// <summary>
+      /// Splits the grammar along rule boundaries, so that no part uses more than
+      /// <paramref name="maxWords"/> words. Rules that refer to each other are never
+      /// split up.
+      /// </summary>
+      /// <param name="grammar">The grammar to split.</param>
+      /// <param name="maxWords">The most words a single engine grammar can have. Zero means no limit.</param>
+      public IList<GrammarPartition> Partition(IGrammar grammar, UInt32 maxWords) {
+         if (grammar == null)
+            throw new ArgumentNullException(nameof(grammar));
+
+         var g = grammar as Grammar;
+
+         // Most grammars fit, and are serialized exactly as before.
+         if (maxWords == 0 || g.WordIds.Count <= maxWords) {
+            return new List<GrammarPartition> {
+               new GrammarPartition(g.RuleIds.Keys, Serialize(g), g.WordIds.Count)
+            };
+         }
+
+         var bins = new List<RuleGroup>();
+
+         // First-fit decreasing
+         foreach (var group in GetRuleGroups(g).OrderByDescending(e => e.Words.Count)) {
+            if (group.Words.Count > maxWords) {
+               _logger.Warn(
+                  $"Rule(s) {String.Join(", ", group.RuleNames)} in {grammar} use {group.Words.Count} " +
+                  $"words, which is more than the engine allows ({maxWords}) and can't be split up."
+               );
+            }
+
+            var bin = bins.FirstOrDefault(e => e.CountWordsWith(group) <= maxWords);
+
+            if (bin == null)
+               bins.Add(group);
+            else
+               bin.Merge(group);
+         }
+
+         _logger.Info($"Split {grammar} ({g.WordIds.Count} words) into {bins.Count} engine grammars.");
+
+         return bins.Select(e => CreatePartition(g, e)).ToList();
+      }
+
       public byte[] Serialize(IGrammar grammar) {
+         if (grammar == null)
+            throw new ArgumentNullException(nameof(grammar));
+
+         var g = grammar as Grammar;
+
+         return Serialize(g.RuleIds, g.WordIds, g.Rules);
+      }
+
+      private byte[] Serialize(IReadOnlyDictionary<String, UInt32> ruleIds,
+                               IReadOnlyDictionary<String, UInt32> wordIds,
+                               IEnumerable<IRule> rules) {
          var memoryStream = new MemoryStream();
          var stream = new BinaryWriter(memoryStream);
 
@@ -140,7 +280,7 @@ namespace Renfrew.Grammar {
          stream.Write(SRCKCFG_EXPORTRULES);
 
          // Rule/Word chunks have the same format
-         bytes = BuildWordsChunk(grammar.RuleIds);
+         bytes = BuildWordsChunk(ruleIds);
          stream.Write(bytes.Length); // Chunk Size
          stream.Write(bytes);        // Chunk
 
@@ -148,7 +288,7 @@ namespace Renfrew.Grammar {
          stream.Write(SRCKCFG_WORDS);
 
          // Rule/Word chunks have the same format
-         bytes = BuildWordsChunk(grammar.WordIds);
+         bytes = BuildWordsChunk(wordIds);
          stream.Write(bytes.Length); // Chunk Size
          stream.Write(bytes);        // Chunk
 
@@ -156,7 +296,7 @@ namespace Renfrew.Grammar {
          stream.Write(SRCKCFG_RULES);
 
          // This chunk has its own special format
-         bytes = BuildRulesChunk(grammar as Grammar);
+         bytes = BuildRulesChunk(rules, ruleIds, wordIds);
          stream.Write(bytes.Length); // Chunk Size
          stream.Write(bytes);        // Chunk
 
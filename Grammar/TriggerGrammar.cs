@@ -0,0 +1,81 @@
+﻿// Project Renfrew
+// Copyright(C) 2017 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+using System;
+using System.Collections.Generic;
+using System.Linq;
+
+using Renfrew.Grammar.FluentApi;
+using Renfrew.NatSpeakInterop;
+
+namespace Renfrew.Grammar {
+
+   /// <summary>
+   /// Stands in for a load-on-demand grammar while it isn't loaded. Holds only the
+   /// owner's trigger words, hands recognitions over to the owner, and is taken out
+   /// of the engine while the owner is loaded.
+   /// </summary>
+   internal sealed class TriggerGrammar : Grammar {
+
+      public const String RuleName = "trigger";
+
+      private readonly Grammar _owner;
+      private readonly Func<IRule, IRule> _trigger;
+
+      public TriggerGrammar(IGrammarService grammarService, Grammar owner, Func<IRule, IRule> trigger)
+         : base(grammarService) {
+
+         _owner = owner ?? throw new ArgumentNullException(nameof(owner));
+         _trigger = trigger ?? throw new ArgumentNullException(nameof(trigger));
+      }
+
+      public override void Dispose() { }
+
+      public override void Initialize() {
+         AddRule(RuleName, _trigger);
+
+         // Referring to the owner's rules would copy most of the owner into the
+         // trigger, which defeats the point of loading it on demand.
+         if (GetReferencedRules(GetRule(RuleName).Elements.Elements).Any() == true)
+            throw new InvalidOperationException("A trigger can only be made of words, not rules.");
+
+         Attach();
+      }
+
+      /// <summary>
+      /// Puts the trigger (back) into the engine.
+      /// </summary>
+      public void Attach() {
+         Load();
+         ActivateRule(RuleName);
+      }
+
+      /// <summary>
+      /// Takes the trigger out of the engine while the owner is loaded.
+      /// </summary>
+      public void Detach() {
+         Unload();
+      }
+
+      public override void InvokeRule(IEnumerable<String> spokenWords) {
+         _owner.InvokeFromTrigger(spokenWords);
+      }
+
+      public override String ToString() =>
+         $"{_owner} (Trigger)";
+   }
+}
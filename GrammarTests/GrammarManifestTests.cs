@@ -0,0 +1,141 @@
+﻿// Project Renfrew
+// Copyright(C) 2024 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+using System;
+using System.IO;
+using System.Linq;
+using System.Reflection;
+
+using Moq;
+
+using NUnit.Framework;
+
+using Renfrew.Grammar;
+using Renfrew.NatSpeakInterop;
+
+namespace GrammarTests {
+   [TestFixture]
+   public class GrammarManifestTests {
+
+      #region Test Grammars
+      [GrammarExport("Exported Test Grammar", "Used by the manifest tests.")]
+      public class ExportedTestGrammar : Grammar {
+         public ExportedTestGrammar(IGrammarService grammarService)
+            : base(grammarService) {
+
+         }
+
+         public override void Dispose() { }
+
+         public override void Initialize() { }
+      }
+
+      [GrammarExport("Not A Grammar")]
+      public class NotAGrammar {
+
+      }
+      #endregion
+
+      private Assembly _assembly;
+      private String _path;
+
+      [SetUp]
+      public void SetUp() {
+         _assembly = Assembly.GetExecutingAssembly();
+         _path = Path.Combine(Path.GetTempPath(), Guid.NewGuid() + GrammarManifest.FileExtension);
+      }
+
+      [TearDown]
+      public void TearDown() {
+         if (File.Exists(_path))
+            File.Delete(_path);
+      }
+
+      [Test]
+      public void ShouldOnlyListExportedGrammars() {
+         var manifest = GrammarManifest.FromAssembly(_assembly);
+
+         Assert.That(
+            manifest.Entries.Select(e => e.TypeName),
+            Has.Member(typeof(ExportedTestGrammar).FullName)
+         );
+         Assert.That(
+            manifest.Entries.Select(e => e.TypeName),
+            Has.No.Member(typeof(NotAGrammar).FullName)
+         );
+      }
+
+      [Test]
+      public void ShouldRoundTripThroughFile() {
+         var manifest = GrammarManifest.FromAssembly(_assembly);
+
+         manifest.Save(_path);
+
+         var loaded = GrammarManifest.Load(_path);
+
+         Assert.That(loaded, Is.Not.Null);
+         Assert.That(loaded.ModuleVersionId, Is.EqualTo(manifest.ModuleVersionId));
+         Assert.That(loaded.IsCurrentFor(_assembly), Is.True);
+
+         var entry = loaded.Entries.Single(e => e.TypeName == typeof(ExportedTestGrammar).FullName);
+
+         Assert.That(entry.Name, Is.EqualTo("Exported Test Grammar"));
+         Assert.That(entry.Description, Is.EqualTo("Used by the manifest tests."));
+      }
+
+      [Test]
+      public void ShouldBeStaleForADifferentBuild() {
+         var manifest = new GrammarManifest(Guid.NewGuid(), Enumerable.Empty<GrammarManifestEntry>());
+
+         Assert.That(manifest.IsCurrentFor(_assembly), Is.False);
+      }
+
+      [Test]
+      public void MissingManifestShouldLoadAsNull() {
+         Assert.That(GrammarManifest.Load(_path), Is.Null);
+      }
+
+      [Test]
+      public void FactoryShouldCreateGrammar() {
+         var entry = new GrammarManifestEntry("Test", null, typeof(ExportedTestGrammar).FullName);
+
+         var factory = entry.CreateFactory(_assembly);
+
+         Assert.That(factory, Is.Not.Null);
+         Assert.That(
+            factory(new Mock<IGrammarService>().Object),
+            Is.InstanceOf<ExportedTestGrammar>()
+         );
+      }
+
+      [Test]
+      public void FactoryShouldBeCompiledOncePerEntry() {
+         var entry = new GrammarManifestEntry("Test", null, typeof(ExportedTestGrammar).FullName);
+
+         Assert.That(entry.CreateFactory(_assembly), Is.SameAs(entry.CreateFactory(_assembly)));
+      }
+
+      [Test]
+      public void FactoryShouldBeNullForUnknownOrInvalidTypes() {
+         var missing = new GrammarManifestEntry("Missing", null, "GrammarTests.DoesNotExist");
+         var invalid = new GrammarManifestEntry("Invalid", null, typeof(NotAGrammar).FullName);
+
+         Assert.That(missing.CreateFactory(_assembly), Is.Null);
+         Assert.That(invalid.CreateFactory(_assembly), Is.Null);
+      }
+   }
+}
@@ -0,0 +1,99 @@
+﻿// Project Renfrew
+// Copyright(C) 2024 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+using System;
+using System.Linq;
+
+using Moq;
+
+using NUnit.Framework;
+
+using Renfrew.Grammar;
+using Renfrew.NatSpeakInterop;
+
+namespace GrammarTests {
+   [TestFixture]
+   public class GrammarPartitionTests {
+
+      #region TestGrammar
+      private class TestGrammar : Grammar {
+
+         public TestGrammar(IGrammarService grammarService)
+            : base(grammarService) {
+
+         }
+
+         public override void Dispose() { }
+
+         public override void Initialize() {
+            AddRule("outer", r => r.Say("One").Say("Two").WithRule("inner"));
+            AddRule("inner", r => r.SayOneOf("Three", "Four"));
+            AddRule("colours", r => r.SayOneOf("Red", "Green", "Blue"));
+            AddRule("animals", r => r.SayOneOf("Cat", "Dog"));
+         }
+      }
+      #endregion
+
+      private TestGrammar _grammar;
+      private GrammarSerializer _serializer;
+
+      [SetUp]
+      public void SetUp() {
+         _grammar = new TestGrammar(new Mock<IGrammarService>().Object);
+         _grammar.Initialize();
+
+         _serializer = new GrammarSerializer();
+      }
+
+      [Test]
+      public void GrammarWithinLimitShouldNotBeSplit() {
+         var partitions = _serializer.Partition(_grammar, 0);
+
+         Assert.That(partitions, Has.Count.EqualTo(1));
+         Assert.That(partitions[0].Bytes, Is.EqualTo(_serializer.Serialize(_grammar)));
+         Assert.That(partitions[0].RuleNames, Is.EquivalentTo(_grammar.RuleIds.Keys));
+      }
+
+      [Test]
+      public void PartitionsShouldRespectWordLimit() {
+         var partitions = _serializer.Partition(_grammar, 5);
+
+         Assert.That(partitions, Has.Count.GreaterThan(1));
+         Assert.That(partitions.Select(e => e.WordCount), Has.All.LessThanOrEqualTo(5));
+         Assert.That(
+            partitions.SelectMany(e => e.RuleNames),
+            Is.EquivalentTo(_grammar.RuleIds.Keys)
+         );
+      }
+
+      [Test]
+      public void ReferencedRulesShouldStayTogether() {
+         var partitions = _serializer.Partition(_grammar, 4);
+
+         var outer = partitions.Single(e => e.ContainsRule("outer"));
+
+         Assert.That(outer.ContainsRule("inner"), Is.True);
+      }
+
+      [Test]
+      public void EveryPartitionShouldBeSerialized() {
+         var partitions = _serializer.Partition(_grammar, 5);
+
+         Assert.That(partitions.Select(e => e.Bytes.Length), Has.All.GreaterThan(0));
+      }
+   }
+}
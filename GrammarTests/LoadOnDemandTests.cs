@@ -0,0 +1,155 @@
+﻿// Project Renfrew
+// Copyright(C) 2024 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+using System;
+using System.Collections.Generic;
+using System.Linq;
+
+using Moq;
+
+using NUnit.Framework;
+
+using Renfrew.Grammar;
+using Renfrew.NatSpeakInterop;
+
+namespace GrammarTests {
+   [TestFixture]
+   public class LoadOnDemandTests {
+
+      #region TestGrammar
+      private class TestGrammar : Grammar {
+
+         public TestGrammar(IGrammarService grammarService)
+            : base(grammarService) {
+
+         }
+
+         public Int32 Invocations { get; private set; }
+         public String Name { get; private set; }
+
+         public override void Dispose() {
+            Unload();
+         }
+
+         public override void Initialize() {
+            AddRule("start", r => r
+               .Say("Hello").Do(() => Invocations++)
+               .OptionallyWithRule("name")
+            );
+            AddRule("name", r => r.SayOneOf("World", "There").Do(spokenWords => Name = spokenWords.Last()));
+            AddRule("other", r => r.Say("Goodbye").Do(() => { }));
+
+            LoadOnDemand(r => r.Say("Hello"), TimeSpan.FromMinutes(5));
+
+            ActivateRule("start");
+         }
+      }
+      #endregion
+
+      private Mock<IGrammarService> _grammarServiceMock;
+      private List<IGrammar> _loadedGrammars;
+
+      private TestGrammar _grammar;
+
+      [SetUp]
+      public void SetUp() {
+         _loadedGrammars = new List<IGrammar>();
+
+         _grammarServiceMock = new Mock<IGrammarService>(MockBehavior.Loose);
+         _grammarServiceMock
+            .Setup(e => e.LoadGrammar(It.IsAny<IGrammar>()))
+            .Callback<IGrammar>(g => _loadedGrammars.Add(g));
+
+         _grammar = new TestGrammar(_grammarServiceMock.Object);
+         _grammar.Initialize();
+      }
+
+      [Test]
+      public void ShouldOnlyLoadTriggerUpFront() {
+         Assert.That(_loadedGrammars, Has.Count.EqualTo(1));
+         Assert.That(_loadedGrammars[0], Is.Not.SameAs(_grammar));
+
+         _grammarServiceMock.Verify(
+            e => e.ActivateRule(_grammar, It.IsAny<IntPtr>(), It.IsAny<String>()), Times.Never
+         );
+      }
+
+      [Test]
+      public void TriggerShouldLoadGrammarAndInvokeRule() {
+         var trigger = _loadedGrammars[0];
+
+         trigger.InvokeRule(new[] { "Hello" });
+
+         Assert.That(_loadedGrammars, Has.Member(_grammar));
+         Assert.That(_grammar.Invocations, Is.EqualTo(1));
+
+         _grammarServiceMock.Verify(e => e.ActivateRule(_grammar, IntPtr.Zero, "start"), Times.Once);
+      }
+
+      [Test]
+      public void TriggerShouldOnlyHoldItsOwnWords() {
+         var trigger = (Grammar) _loadedGrammars[0];
+
+         Assert.That(trigger.RuleIds.Keys, Is.EquivalentTo(new[] { "trigger" }));
+      }
+
+      [Test]
+      public void TriggerShouldBeOutOfTheEngineWhileGrammarIsLoaded() {
+         var trigger = _loadedGrammars[0];
+
+         trigger.InvokeRule(new[] { "Hello" });
+
+         _grammarServiceMock.Verify(e => e.UnloadGrammar(trigger), Times.Once);
+         _grammarServiceMock.Verify(e => e.UnloadGrammar(_grammar), Times.Never);
+
+         // The loaded grammar handles whole utterances itself
+         _grammar.InvokeRule(new[] { "Hello", "World" });
+
+         Assert.That(_grammar.Invocations, Is.EqualTo(2));
+         Assert.That(_grammar.Name, Is.EqualTo("World"));
+      }
+
+      [Test]
+      public void DisposeShouldUnloadGrammarAndTrigger() {
+         var trigger = _loadedGrammars[0];
+
+         trigger.InvokeRule(new[] { "Hello" });
+
+         _grammar.Dispose();
+
+         _grammarServiceMock.Verify(e => e.UnloadGrammar(_grammar), Times.Once);
+         _grammarServiceMock.Verify(e => e.UnloadGrammar(trigger), Times.Once);
+      }
+
+      [Test]
+      public void RuleChangesWhileUnloadedShouldOnlyBeRecorded() {
+         _grammar.DeactivateRule("start");
+         _grammar.ActivateRule("other");
+         _grammar.ActivateRule("start");
+
+         _grammarServiceMock.Verify(
+            e => e.ActivateRule(_grammar, It.IsAny<IntPtr>(), It.IsAny<String>()), Times.Never
+         );
+         _grammarServiceMock.Verify(e => e.DeactivateRule(_grammar, It.IsAny<String>()), Times.Never);
+
+         _loadedGrammars[0].InvokeRule(new[] { "Hello" });
+
+         _grammarServiceMock.Verify(e => e.ActivateRule(_grammar, IntPtr.Zero, "start"), Times.Once);
+         _grammarServiceMock.Verify(e => e.ActivateRule(_grammar, IntPtr.Zero, "other"), Times.Once);
+      }
+   }
+}
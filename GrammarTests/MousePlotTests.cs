@@ -16,6 +16,7 @@
 //
 
 using System;
+using System.Collections.Generic;
 using System.Drawing;
 
 using Moq;
@@ -39,6 +40,8 @@ namespace GrammarTests {
       [SetUp]
       public void SetUp() {
          _screenMock = new Mock<IScreen>(MockBehavior.Strict);
+         _screenMock.Setup(e => e.Scale).Returns(1.0);
+
          _plotWindowMock  = new Mock<IWindow>();
          _zoomWindowMock  = new Mock<IZoomWindow>();
          _cellWindowMock  = new Mock<IWindow>();
@@ -339,7 +342,7 @@ namespace GrammarTests {
 
 
       [Test]
-      public void ShouldOpenZoomWindowAndCloseMainPlotWindow() {
+      public void ShouldOpenZoomWindowAndLeaveMainPlotWindowOpen() {
          // Arrange
          _screenMock.Setup(e => e.Bounds).Returns(
             new Rectangle(0, 0, 1920, 1080)
@@ -352,7 +355,7 @@ namespace GrammarTests {
          _grammar.Zoom("One", "One");
 
          // Assert
-         _plotWindowMock.Verify(e => e.Close(), Times.Once);
+         _plotWindowMock.Verify(e => e.Close(), Times.Never);
 
          //_zoomWindowMock.Verify(e => e.SetImage(It.IsAny<Bitmap>()), Times.Once);
          _zoomWindowMock.Verify(e => e.Move(225, 225), Times.Once);
@@ -362,6 +365,168 @@ namespace GrammarTests {
          _cellWindowMock.Verify(e => e.Show(), Times.Once);
       }
 
+      [Test]
+      public void OverlayTransactionShouldApplyStepsInOrderOnCommit() {
+         var steps = new List<String>();
+
+         _cellWindowMock.Setup(e => e.Move(1, 2)).Callback(() => steps.Add("Move"));
+         _cellWindowMock.Setup(e => e.Show()).Callback(() => steps.Add("Show"));
+
+         var transaction = new OverlayTransaction(null)
+            .Show(_cellWindowMock.Object)
+            .Move(_cellWindowMock.Object, 1, 2);
+
+         Assert.That(steps, Is.Empty);
+
+         transaction.Commit();
+
+         Assert.That(steps, Is.EqualTo(new[] { "Show", "Move" }));
+      }
+
+      [Test]
+      public void WarmUpShouldBuildEveryWindowAndParkPlotWindowOnPrimaryScreen() {
+         _screenMock.Setup(e => e.Bounds).Returns(
+            new Rectangle(0, 0, 1920, 1080)
+         );
+
+         _grammar.WarmUp();
+
+         _plotWindowMock.Verify(e => e.WarmUp(), Times.Once);
+         _zoomWindowMock.Verify(e => e.WarmUp(), Times.Once);
+         _cellWindowMock.Verify(e => e.WarmUp(), Times.Once);
+         _arrowWindowMock.Verify(e => e.WarmUp(), Times.Once);
+
+         _plotWindowMock.Verify(e => e.Move(0, 0), Times.Once);
+         _plotWindowMock.Verify(e => e.Show(), Times.Never);
+      }
+
+      // Two 1920 x 1080 screens, side by side, with a plot window each
+      private MousePlotGrammar CreateAllScreensGrammar(Dictionary<Int32, Mock<IWindow>> plotWindows) {
+         var secondScreenMock = new Mock<IScreen>(MockBehavior.Strict);
+         var screens = new[] { _screenMock.Object, secondScreenMock.Object };
+
+         _screenMock.Setup(e => e.Bounds).Returns(new Rectangle(0, 0, 1920, 1080));
+         _screenMock.Setup(e => e.AllScreens).Returns(screens);
+         _screenMock.Setup(e => e.PrimaryScreen).Returns(_screenMock.Object);
+
+         secondScreenMock.Setup(e => e.Bounds).Returns(new Rectangle(1920, 0, 1920, 1080));
+         secondScreenMock.Setup(e => e.Scale).Returns(1.0);
+         secondScreenMock.Setup(e => e.AllScreens).Returns(screens);
+         secondScreenMock.Setup(e => e.PrimaryScreen).Returns(_screenMock.Object);
+
+         return new MousePlotGrammar(
+            grammarService:    new Mock<IGrammarService>().Object,
+            screen:            _screenMock.Object,
+            plotWindow:        _plotWindowMock.Object,
+            zoomWindow:        _zoomWindowMock.Object,
+            cellWindow:        _cellWindowMock.Object,
+            markArrowWindow:   _arrowWindowMock.Object,
+            plotWindowFactory: monitor => (plotWindows[monitor] = new Mock<IWindow>()).Object
+         );
+      }
+
+      [Test]
+      public void WarmUpShouldParkAPlotWindowOnEveryScreenWhenPlottingAllScreens() {
+         var plotWindows = new Dictionary<Int32, Mock<IWindow>>();
+         var grammar = CreateAllScreensGrammar(plotWindows);
+
+         grammar.WarmUp();
+
+         Assert.That(plotWindows.Keys, Is.EquivalentTo(new[] { 1, 2 }));
+
+         plotWindows[1].Verify(e => e.SetScreenBounds(new Rectangle(0, 0, 1920, 1080)), Times.Once);
+         plotWindows[1].Verify(e => e.WarmUp(), Times.Once);
+         plotWindows[1].Verify(e => e.Move(0, 0), Times.Once);
+
+         plotWindows[2].Verify(e => e.SetScreenBounds(new Rectangle(1920, 0, 1920, 1080)), Times.Once);
+         plotWindows[2].Verify(e => e.WarmUp(), Times.Once);
+         plotWindows[2].Verify(e => e.Move(1920, 0), Times.Once);
+
+         _plotWindowMock.Verify(e => e.WarmUp(), Times.Never);
+      }
+
+      [Test]
+      public void NamingAMonitorShouldZoomOnItsScreenWithoutMovingPlotWindows() {
+         var plotWindows = new Dictionary<Int32, Mock<IWindow>>();
+         var grammar = CreateAllScreensGrammar(plotWindows);
+
+         grammar.WarmUp();
+         grammar.SwitchScreen(2);
+         grammar.Zoom("One", "One");
+
+         plotWindows[1].Verify(e => e.Move(It.IsAny<double>(), It.IsAny<double>()), Times.Once);
+         plotWindows[2].Verify(e => e.Move(It.IsAny<double>(), It.IsAny<double>()), Times.Once);
+
+         _cellWindowMock.Verify(e => e.Move(2016.0, 96.0), Times.Once);
+      }
+
+      [Test]
+      public void ZoomShouldLookForTargetsInTheCellAndShowThem() {
+         _screenMock.Setup(e => e.Bounds).Returns(
+            new Rectangle(0, 0, 1920, 1080)
+         );
+
+         var targets = new[] {
+            new Rectangle(110, 120, 30, 10),
+            new Rectangle(150, 170, 12, 12),
+         };
+
+         var targetFinderMock = new Mock<ITargetFinder>();
+         targetFinderMock.Setup(e => e.Find(new Rectangle(100, 100, 100, 100))).Returns(targets);
+
+         var grammar = new MousePlotGrammar(
+            grammarService:  new Mock<IGrammarService>().Object,
+            screen:          _screenMock.Object,
+            plotWindow:      _plotWindowMock.Object,
+            zoomWindow:      _zoomWindowMock.Object,
+            cellWindow:      _cellWindowMock.Object,
+            markArrowWindow: _arrowWindowMock.Object,
+            targetFinder:    targetFinderMock.Object
+         );
+
+         grammar.Zoom("One", "One");
+
+         _zoomWindowMock.Verify(e => e.SetTargets(targets), Times.Once);
+
+         Assert.That(grammar.GetTargetCentre(1), Is.EqualTo(new Point(125, 125)));
+         Assert.That(grammar.GetTargetCentre(2), Is.EqualTo(new Point(156, 176)));
+         Assert.That(grammar.GetTargetCentre(3), Is.Null);
+         Assert.That(grammar.GetTargetCentre(0), Is.Null);
+      }
+
+      [Test]
+      [TestCase(100, 100, 1)]
+      [TestCase(120, 125, 1)] // <-- Inside the first
+      [TestCase(155, 160, 2)]
+      [TestCase(199, 199, 2)]
+      public void ShouldSnapToNearestTarget(Int32 x, Int32 y, Int32 expected) {
+         _screenMock.Setup(e => e.Bounds).Returns(
+            new Rectangle(0, 0, 1920, 1080)
+         );
+
+         var targetFinderMock = new Mock<ITargetFinder>();
+         targetFinderMock.Setup(e => e.Find(It.IsAny<Rectangle>())).Returns(new[] {
+            new Rectangle(110, 120, 30, 10),
+            new Rectangle(150, 170, 12, 12),
+         });
+
+         var grammar = new MousePlotGrammar(
+            grammarService:  new Mock<IGrammarService>().Object,
+            screen:          _screenMock.Object,
+            plotWindow:      _plotWindowMock.Object,
+            zoomWindow:      _zoomWindowMock.Object,
+            cellWindow:      _cellWindowMock.Object,
+            markArrowWindow: _arrowWindowMock.Object,
+            targetFinder:    targetFinderMock.Object
+         );
+
+         Assert.That(grammar.GetNearestTarget(new Point(x, y)), Is.EqualTo(0));
+
+         grammar.Zoom("One", "One");
+
+         Assert.That(grammar.GetNearestTarget(new Point(x, y)), Is.EqualTo(expected));
+      }
+
 
       [Test]
       [TestCase("Zero", "Zero",  0,    0)]
@@ -395,5 +560,58 @@ namespace GrammarTests {
          _zoomWindowMock.Verify(e => e.Move(zoomx, zoomy), Times.Once);
       }
 
+      [Test]
+      public void ShouldScaleZoomSourceByScreenScale() {
+         // Arrange
+         _screenMock.Setup(e => e.Bounds).Returns(
+            new Rectangle(0, 0, 1920, 1080)
+         );
+         _screenMock.Setup(e => e.Scale).Returns(1.5);
+
+         _zoomWindowMock.Setup(e => e.Width).Returns(300);
+         _zoomWindowMock.Setup(e => e.Height).Returns(300);
+
+         // Act
+         _grammar.Zoom("One", "One");
+
+         // Assert
+         _zoomWindowMock.Verify(e => e.SetScaleMultiplier(1.5), Times.Once);
+         _zoomWindowMock.Verify(e => e.SetSource(150, 150, 150, 150), Times.Once);
+      }
+
+      [Test]
+      [TestCase(0, 1995)]
+      [TestCase(1, 2145)]
+      [TestCase(12, 3795)]
+      [TestCase(13, 3839)] // <-- Beyond the edge of the screen
+      public void ShouldScaleMouseXCoordFromOriginOfScaledSecondaryScreen(Int32 x, Int32 expected) {
+         _screenMock.Setup(e => e.Bounds).Returns(
+            new Rectangle(1920, 0, 1920, 1080)
+         );
+         _screenMock.Setup(e => e.Scale).Returns(1.5);
+
+         Assert.That(_grammar.GetMouseXCoord(x), Is.EqualTo(expected));
+      }
+
+      [Test]
+      public void ShouldScaleZoomSourceFromOriginOfScaledSecondaryScreen() {
+         // Arrange
+         _screenMock.Setup(e => e.Bounds).Returns(
+            new Rectangle(1920, 0, 1920, 1080)
+         );
+         _screenMock.Setup(e => e.Scale).Returns(1.5);
+
+         _zoomWindowMock.Setup(e => e.Width).Returns(300);
+         _zoomWindowMock.Setup(e => e.Height).Returns(300);
+
+         // Act
+         _grammar.Zoom("One", "One");
+
+         // Assert
+         _zoomWindowMock.Verify(e => e.SetSource(2070, 150, 150, 150), Times.Once);
+         _zoomWindowMock.Verify(e => e.Move(2145, 225), Times.Once);
+         _cellWindowMock.Verify(e => e.Move(2016.0, 96.0), Times.Once);
+      }
+
    }
 }
@@ -0,0 +1,70 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include "CpuFeatures.h"
+
+#if defined(_MSC_VER) && defined(RENFREW_X86)
+   #include <intrin.h>
+#endif
+
+using namespace Renfrew::Utility;
+
+static bool SupportsSse2() {
+#if defined(_M_X64) || defined(__x86_64__)
+   return true;
+#elif defined(_MSC_VER) && defined(RENFREW_X86)
+   int info[4];
+   __cpuid(info, 1);
+
+   return (info[3] & (1 << 26)) != 0;
+#elif defined(RENFREW_X86)
+   return __builtin_cpu_supports("sse2");
+#else
+   return false;
+#endif
+}
+
+static bool SupportsAvx2() {
+#if defined(_MSC_VER) && defined(RENFREW_X86)
+   int info[4];
+   __cpuid(info, 1);
+
+   // The OS has to save the YMM registers, too
+   bool osxsave = (info[2] & (1 << 27)) != 0;
+   bool avx = (info[2] & (1 << 28)) != 0;
+
+   if (osxsave == false || avx == false || (_xgetbv(0) & 0x6) != 0x6)
+      return false;
+
+   __cpuidex(info, 7, 0);
+
+   return (info[1] & (1 << 5)) != 0;
+#elif defined(RENFREW_X86)
+   return __builtin_cpu_supports("avx2");
+#else
+   return false;
+#endif
+}
+
+SimdLevel Renfrew::Utility::DetectSimdLevel() {
+   static const SimdLevel level =
+      SupportsAvx2() == true ? SimdLevel::Avx2 :
+      SupportsSse2() == true ? SimdLevel::Sse2 :
+      SimdLevel::Scalar;
+
+   return level;
+}
@@ -0,0 +1,53 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+// Plain C++ (no Windows or CLR dependencies), so that it can be built and
+// tested on its own.
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+   #define RENFREW_X86
+
+   // Marks functions that use the instruction set, so that they can be compiled
+   // without enabling it for the whole file (MSVC doesn't need telling).
+   #if defined(_MSC_VER)
+      #define RENFREW_TARGET_SSE2
+      #define RENFREW_TARGET_AVX2
+   #else
+      #define RENFREW_TARGET_SSE2 __attribute__((target("sse2")))
+      #define RENFREW_TARGET_AVX2 __attribute__((target("avx2")))
+   #endif
+#endif
+
+namespace Renfrew::Utility {
+
+   /// <summary>
+   /// The widest SIMD instruction set used by the image kernels. Later values
+   /// include the earlier ones.
+   /// </summary>
+   enum class SimdLevel {
+      Scalar,
+      Sse2,
+      Avx2
+   };
+
+   /// <summary>
+   /// Gets the best level the processor (and OS) supports. Worked out once.
+   /// </summary>
+   SimdLevel DetectSimdLevel();
+}
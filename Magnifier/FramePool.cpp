@@ -0,0 +1,147 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include "FramePool.h"
+
+using namespace Renfrew::Utility;
+
+// Rows are padded out to a multiple of this many pixels (32 bytes)
+static const int rowAlignment = 8;
+
+Frame::Frame(int width, int height) {
+   _width = width;
+   _height = height;
+   _stride = (width + rowAlignment - 1) / rowAlignment * rowAlignment;
+
+   // Over-allocate so the first row can be aligned, too
+   std::size_t size = static_cast<std::size_t>(_stride) * height + rowAlignment;
+
+   _storage.reset(new std::uint32_t[size]);
+
+   auto address = reinterpret_cast<std::uintptr_t>(_storage.get());
+   auto misalignment = address % (rowAlignment * sizeof(std::uint32_t));
+
+   _pixels = _storage.get() +
+      (misalignment == 0 ? 0 : (rowAlignment * sizeof(std::uint32_t) - misalignment) / sizeof(std::uint32_t));
+}
+
+std::uint32_t *Frame::Pixels() const {
+   return _pixels;
+}
+
+int Frame::Width() const {
+   return _width;
+}
+
+int Frame::Height() const {
+   return _height;
+}
+
+int Frame::Stride() const {
+   return _stride;
+}
+
+ImageView Frame::View() const {
+   return ImageView { _pixels, _width, _height, _stride };
+}
+
+ConstImageView Frame::ConstView() const {
+   return ConstImageView { _pixels, _width, _height, _stride };
+}
+
+FramePool::FramePool(std::size_t capacity) {
+   _state = std::make_shared<State>();
+   _state->Capacity = capacity;
+   _state->Pooled = 0;
+   _state->Allocations = 0;
+}
+
+void FramePool::Reserve(int width, int height) {
+   std::lock_guard<std::mutex> guard(_state->Lock);
+
+   auto &idle = _state->Idle;
+
+   // Frames on loan are resized when they come back (see Acquire).
+   for (auto &frame : idle) {
+      if (frame->Width() != width || frame->Height() != height) {
+         frame.reset(new Frame(width, height));
+         _state->Allocations++;
+      }
+   }
+
+   while (_state->Pooled < _state->Capacity) {
+      idle.emplace_back(new Frame(width, height));
+
+      _state->Pooled++;
+      _state->Allocations++;
+   }
+}
+
+FrameHandle FramePool::Acquire(int width, int height) {
+   std::unique_ptr<Frame> frame;
+   bool pooled = true;
+
+   {
+      std::lock_guard<std::mutex> guard(_state->Lock);
+
+      auto &idle = _state->Idle;
+
+      for (auto i = idle.begin(); i != idle.end(); ++i) {
+         if ((*i)->Width() == width && (*i)->Height() == height) {
+            frame = std::move(*i);
+            idle.erase(i);
+            break;
+         }
+      }
+
+      // Nothing the right size, so replace an idle frame, or grow the pool
+      if (frame == nullptr) {
+         if (idle.empty() == false)
+            idle.pop_back();
+         else if (_state->Pooled < _state->Capacity)
+            _state->Pooled++;
+         else
+            pooled = false;
+
+         _state->Allocations++;
+      }
+   }
+
+   if (frame == nullptr)
+      frame.reset(new Frame(width, height));
+
+   return Lend(_state, std::move(frame), pooled);
+}
+
+std::size_t FramePool::Allocations() const {
+   std::lock_guard<std::mutex> guard(_state->Lock);
+   return _state->Allocations;
+}
+
+// The handle keeps the pool's state alive, so frames can outlive the pool itself.
+FrameHandle FramePool::Lend(const std::shared_ptr<State> &state, std::unique_ptr<Frame> frame,
+                            bool pooled) {
+   return FrameHandle(frame.release(), [state, pooled](Frame *returned) {
+      if (pooled == false) {
+         delete returned;
+         return;
+      }
+
+      std::lock_guard<std::mutex> guard(state->Lock);
+      state->Idle.emplace_back(returned);
+   });
+}
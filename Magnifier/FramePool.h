@@ -0,0 +1,102 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ImageScaler.h"
+
+// Plain C++ (no Windows or CLR dependencies), so that it can be built and
+// tested on its own.
+
+namespace Renfrew::Utility {
+
+   /// <summary>
+   /// A BGRA pixel buffer that belongs to a <see cref="FramePool"/>. Rows start on
+   /// a 32-byte boundary.
+   /// </summary>
+   class Frame {
+      friend class FramePool;
+
+      private: std::unique_ptr<std::uint32_t[]> _storage;
+      private: std::uint32_t *_pixels;
+      private: int _width;
+      private: int _height;
+      private: int _stride;
+
+      private: Frame(int width, int height);
+
+      public: std::uint32_t *Pixels() const;
+      public: int Width() const;
+      public: int Height() const;
+
+      // In pixels
+      public: int Stride() const;
+
+      public: ImageView View() const;
+      public: ConstImageView ConstView() const;
+   };
+
+   /// <summary>
+   /// A frame on loan from a pool. It goes back to the pool once the last copy
+   /// of the handle is gone.
+   /// </summary>
+   typedef std::shared_ptr<Frame> FrameHandle;
+
+   /// <summary>
+   /// Hands out frames of a given size without allocating, once the pool has
+   /// warmed up (or has been reserved up front). Frames can be acquired and
+   /// released by any thread. If every frame is in use, an extra one is made,
+   /// and it's freed rather than kept when it comes back.
+   /// </summary>
+   class FramePool {
+      private: struct State {
+         std::mutex Lock;
+         std::vector<std::unique_ptr<Frame>> Idle;
+         std::size_t Capacity;
+         std::size_t Pooled;
+         std::size_t Allocations;
+      };
+
+      private: std::shared_ptr<State> _state;
+
+      public: FramePool(std::size_t capacity);
+
+      FramePool(const FramePool &) = delete;
+      FramePool &operator =(const FramePool &) = delete;
+
+      /// <summary>
+      /// Allocates all of the frames up front, at the given size.
+      /// </summary>
+      public: void Reserve(int width, int height);
+
+      public: FrameHandle Acquire(int width, int height);
+
+      /// <summary>
+      /// The number of frames allocated over the life of the pool.
+      /// </summary>
+      public: std::size_t Allocations() const;
+
+      private: static FrameHandle Lend(const std::shared_ptr<State> &state, std::unique_ptr<Frame> frame,
+                                       bool pooled);
+   };
+}
@@ -0,0 +1,322 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include "GridRaster.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace Renfrew::Utility;
+
+GlyphAtlas::GlyphAtlas() {
+   _cellWidth = 0;
+   _cellHeight = 0;
+}
+
+void GlyphAtlas::Reset(const std::string &characters, int cellWidth, int cellHeight) {
+   _characters = characters;
+   _cellWidth = std::max(cellWidth, 0);
+   _cellHeight = std::max(cellHeight, 0);
+
+   _coverage.assign(static_cast<std::size_t>(Stride()) * _cellHeight, 0);
+}
+
+const std::string &GlyphAtlas::Characters() const {
+   return _characters;
+}
+
+int GlyphAtlas::CellWidth() const {
+   return _cellWidth;
+}
+
+int GlyphAtlas::CellHeight() const {
+   return _cellHeight;
+}
+
+bool GlyphAtlas::Contains(char c) const {
+   return _characters.find(c) != std::string::npos;
+}
+
+std::uint8_t *GlyphAtlas::Glyph(char c) {
+   auto index = _characters.find(c);
+
+   if (index == std::string::npos || _coverage.empty() == true)
+      return nullptr;
+
+   return _coverage.data() + index * _cellWidth;
+}
+
+const std::uint8_t *GlyphAtlas::Glyph(char c) const {
+   return const_cast<GlyphAtlas *>(this)->Glyph(c);
+}
+
+int GlyphAtlas::Stride() const {
+   return _cellWidth * static_cast<int>(_characters.size());
+}
+
+// Draws b over a, where both are the same colour
+static inline std::uint8_t Over(std::uint8_t a, std::uint8_t b) {
+   return static_cast<std::uint8_t>(a + (b * (255 - a) + 127) / 255);
+}
+
+static inline std::uint8_t ToAlpha(double opacity) {
+   return static_cast<std::uint8_t>(std::lround(std::min(std::max(opacity, 0.0), 1.0) * 255));
+}
+
+// One pass of a box blur, either along the rows or down the columns. Anything
+// outside the image counts as transparent.
+static void BoxBlur(const std::uint8_t *source, std::uint8_t *destination,
+                    int width, int height, int radius, bool horizontal) {
+   int lines = horizontal == true ? height : width;
+   int length = horizontal == true ? width : height;
+   int step = horizontal == true ? 1 : width;
+   int next = horizontal == true ? width : 1;
+   int size = radius * 2 + 1;
+
+   for (int line = 0; line < lines; line++) {
+      auto in = source + line * next;
+      auto out = destination + line * next;
+
+      int sum = 0;
+
+      for (int i = 0; i < std::min(radius, length); i++)
+         sum += in[i * step];
+
+      for (int i = 0; i < length; i++) {
+         if (i + radius < length)
+            sum += in[(i + radius) * step];
+
+         if (i - radius - 1 >= 0)
+            sum -= in[(i - radius - 1) * step];
+
+         out[i * step] = static_cast<std::uint8_t>((sum + size / 2) / size);
+      }
+   }
+}
+
+const char *GridRaster::LabelCharacters() {
+   return "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+}
+
+char GridRaster::Digit(int i) {
+   if (i < 10)
+      return static_cast<char>('0' + i);
+   return static_cast<char>('A' + i - 10);
+}
+
+void GridRaster::Render(const GlyphAtlas &atlas, const GridStyle &style,
+                        const ImageView &target) {
+   int width = target.Width;
+   int height = target.Height;
+
+   if (width <= 0 || height <= 0)
+      return;
+
+   auto size = static_cast<std::size_t>(width) * height;
+
+   _layer.assign(size, 0);
+
+   if (style.CellSize > 0) {
+      DrawLines(style, width, height);
+      DrawLabels(atlas, style, width, height);
+   }
+
+   DrawShadow(style, width, height);
+
+   std::uint32_t colour[3] = {
+      style.Colour & 0xFF, (style.Colour >> 8) & 0xFF, (style.Colour >> 16) & 0xFF
+   };
+   std::uint32_t shadowColour[3] = {
+      style.ShadowColour & 0xFF, (style.ShadowColour >> 8) & 0xFF, (style.ShadowColour >> 16) & 0xFF
+   };
+
+   auto shadowAlpha = ToAlpha(style.ShadowOpacity);
+
+   for (int y = 0; y < height; y++) {
+      auto layer = _layer.data() + y * width;
+      auto shadow = _shadow.data() + y * width;
+      auto row = target.Pixels + y * target.Stride;
+
+      for (int x = 0; x < width; x++) {
+         std::uint32_t a = layer[x];
+         std::uint32_t s = (shadow[x] * shadowAlpha + 127) / 255;
+
+         // The shadow only shows where the grid itself doesn't cover it
+         s = (s * (255 - a) + 127) / 255;
+
+         std::uint32_t pixel = (a + s) << 24;
+
+         for (int c = 0; c < 3; c++)
+            pixel |= ((colour[c] * a + shadowColour[c] * s + 127) / 255) << (c * 8);
+
+         row[x] = pixel;
+      }
+   }
+}
+
+void GridRaster::DrawLines(const GridStyle &style, int width, int height) {
+   auto alpha = ToAlpha(style.LineOpacity);
+
+   if (alpha == 0)
+      return;
+
+   auto dashed = [&style](int position) {
+      if (style.DashLength <= 0)
+         return true;
+
+      auto phase = std::fmod(position - style.LineOffset, style.DashLength * 2);
+
+      if (phase < 0)
+         phase += style.DashLength * 2;
+
+      return phase < style.DashLength;
+   };
+
+   for (int k = 0; ; k++) {
+      auto x = static_cast<int>(std::lround(style.LineOffset + k * style.CellSize));
+
+      if (x >= width)
+         break;
+
+      if (x < 0)
+         continue;
+
+      for (int y = 0; y < height; y++) {
+         if (dashed(y) == true)
+            _layer[y * width + x] = Over(_layer[y * width + x], alpha);
+      }
+   }
+
+   for (int k = 0; ; k++) {
+      auto y = static_cast<int>(std::lround(style.LineOffset + k * style.CellSize));
+
+      if (y >= height)
+         break;
+
+      if (y < 0)
+         continue;
+
+      auto row = _layer.data() + y * width;
+
+      for (int x = 0; x < width; x++) {
+         if (dashed(x) == true)
+            row[x] = Over(row[x], alpha);
+      }
+   }
+}
+
+void GridRaster::DrawLabels(const GlyphAtlas &atlas, const GridStyle &style,
+                            int width, int height) {
+   auto opacity = ToAlpha(style.LabelOpacity);
+
+   int glyphWidth = atlas.CellWidth();
+   int glyphHeight = atlas.CellHeight();
+
+   if (opacity == 0 || glyphWidth == 0 || glyphHeight == 0)
+      return;
+
+   int limit = style.Cells > 0 ? std::min(style.Cells, static_cast<int>(MaximumCells)) : MaximumCells;
+
+   // Every label that starts inside the image
+   auto count = [&style, limit](int length) {
+      auto cells = static_cast<int>(std::ceil((length - style.LabelOffset) / style.CellSize));
+      return std::min(std::max(cells, 0), limit);
+   };
+
+   int columns = count(width);
+   int rows = count(height);
+
+   int length = style.LabelPrefix != 0 ? 3 : 2;
+
+   // Centre the glyphs in the label's box
+   auto left = style.LabelOffset + (style.LabelSize - glyphWidth * length) / 2;
+   auto top = style.LabelOffset + (style.LabelSize - glyphHeight) / 2;
+
+   for (int row = 0; row < rows; row++) {
+      for (int column = 0; column < columns; column++) {
+         char text[3] = { style.LabelPrefix, Digit(row), Digit(column) };
+
+         // Skip the prefix if there isn't one
+         auto label = text + 3 - length;
+
+         auto y0 = static_cast<int>(std::lround(top + row * style.CellSize));
+
+         for (int i = 0; i < length; i++) {
+            auto glyph = atlas.Glyph(label[i]);
+
+            if (glyph == nullptr)
+               continue;
+
+            auto x0 = static_cast<int>(std::lround(left + column * style.CellSize)) + i * glyphWidth;
+
+            // Clip the glyph to the image
+            int fromX = std::max(0, -x0);
+            int toX = std::min(glyphWidth, width - x0);
+            int fromY = std::max(0, -y0);
+            int toY = std::min(glyphHeight, height - y0);
+
+            for (int y = fromY; y < toY; y++) {
+               auto coverage = glyph + y * atlas.Stride();
+               auto out = _layer.data() + (y0 + y) * width + x0;
+
+               for (int x = fromX; x < toX; x++) {
+                  if (coverage[x] != 0)
+                     out[x] = Over(out[x], static_cast<std::uint8_t>((coverage[x] * opacity + 127) / 255));
+               }
+            }
+         }
+      }
+   }
+}
+
+void GridRaster::DrawShadow(const GridStyle &style, int width, int height) {
+   auto size = static_cast<std::size_t>(width) * height;
+
+   _shadow.assign(size, 0);
+
+   if (style.ShadowOpacity <= 0)
+      return;
+
+   auto offset = static_cast<int>(std::lround(style.ShadowOffset));
+
+   for (int y = std::max(0, offset); y < height && y - offset < height; y++) {
+      int from = std::max(0, offset);
+      int to = std::min(width, width + offset);
+
+      if (to > from) {
+         std::memcpy(
+            _shadow.data() + y * width + from,
+            _layer.data() + (y - offset) * width + from - offset,
+            to - from
+         );
+      }
+   }
+
+   // Two passes of a box blur each way is close enough to a Gaussian
+   auto radius = static_cast<int>(std::lround(style.ShadowBlur / 2));
+
+   if (radius <= 0)
+      return;
+
+   _scratch.resize(size);
+
+   for (int pass = 0; pass < 2; pass++) {
+      BoxBlur(_shadow.data(), _scratch.data(), width, height, radius, true);
+      BoxBlur(_scratch.data(), _shadow.data(), width, height, radius, false);
+   }
+}
@@ -0,0 +1,136 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ImageScaler.h"
+
+// Plain C++ (no Windows or CLR dependencies), so that it can be built and
+// tested on its own.
+
+namespace Renfrew::Utility {
+
+   /// <summary>
+   /// Coverage masks (0 - 255) for a set of characters, drawn once by the font
+   /// renderer. Every glyph has the same cell size, so it only suits monospaced
+   /// fonts.
+   /// </summary>
+   class GlyphAtlas {
+      private: std::string _characters;
+      private: int _cellWidth;
+      private: int _cellHeight;
+
+      // The glyph cells, side by side in one row
+      private: std::vector<std::uint8_t> _coverage;
+
+      public: GlyphAtlas();
+
+      public: void Reset(const std::string &characters, int cellWidth, int cellHeight);
+
+      public: const std::string &Characters() const;
+      public: int CellWidth() const;
+      public: int CellHeight() const;
+
+      public: bool Contains(char c) const;
+
+      /// <summary>
+      /// The top-left of the character's cell (or null if it isn't in the atlas).
+      /// Rows are <see cref="Stride"/> bytes apart.
+      /// </summary>
+      public: std::uint8_t *Glyph(char c);
+      public: const std::uint8_t *Glyph(char c) const;
+
+      public: int Stride() const;
+   };
+
+   /// <summary>
+   /// How a grid of labelled cells looks, in pixels. Every cell is labelled with
+   /// its row then its column, each as a single digit (0 - 9, then A - Z), after
+   /// the prefix if there is one.
+   /// </summary>
+   struct GridStyle {
+      // Distance between the grid lines
+      double CellSize;
+
+      // Where the first grid line is, across and down
+      double LineOffset;
+
+      // 0 for solid lines
+      double DashLength;
+      double LineOpacity;
+
+      // Labels across and down (up to GridRaster::MaximumCells), or 0 for as
+      // many as the image has room for
+      int Cells;
+
+      // The box each label is centred in
+      double LabelOffset;
+      double LabelSize;
+      double LabelOpacity;
+
+      // Drawn before every label (e.g. the number of the monitor), or 0 for none
+      char LabelPrefix;
+
+      // The shadow is the whole grid, offset (and blurred)
+      double ShadowOffset;
+      double ShadowBlur;
+      double ShadowOpacity;
+
+      // Straight (not premultiplied) BGRA. Only the colour channels are used.
+      std::uint32_t Colour;
+      std::uint32_t ShadowColour;
+   };
+
+   /// <summary>
+   /// Draws a labelled grid into one premultiplied BGRA image, to be shown as a
+   /// single layer rather than a control per cell.
+   /// </summary>
+   class GridRaster {
+      // 0 - 255, one per pixel
+      private: std::vector<std::uint8_t> _layer;
+      private: std::vector<std::uint8_t> _shadow;
+      private: std::vector<std::uint8_t> _scratch;
+
+      /// <summary>
+      /// The largest number of rows or columns that can be labelled.
+      /// </summary>
+      public: static constexpr int MaximumCells = 36;
+
+      /// <summary>
+      /// The characters a grid's labels are made from.
+      /// </summary>
+      public: static const char *LabelCharacters();
+
+      public: static char Digit(int i);
+
+      /// <summary>
+      /// Fills the image with the grid. The lines cover all of it; the labels stop
+      /// after <see cref="GridStyle::Cells"/> (or when they run off the edge).
+      /// </summary>
+      public: void Render(const GlyphAtlas &atlas, const GridStyle &style,
+                          const ImageView &target);
+
+      private: void DrawLines(const GridStyle &style, int width, int height);
+      private: void DrawLabels(const GlyphAtlas &atlas, const GridStyle &style,
+                               int width, int height);
+      private: void DrawShadow(const GridStyle &style, int width, int height);
+   };
+}
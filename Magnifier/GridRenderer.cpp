@@ -0,0 +1,283 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include "stdafx.h"
+
+#using "PresentationFramework.dll"
+#using "PresentationCore.dll"
+#using "WindowsBase.dll"
+#using "System.Xaml.dll"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Runtime::InteropServices;
+using namespace System::Windows::Media;
+using namespace System::Windows::Media::Imaging;
+
+#include "GridRenderer.h"
+#include "MagnifierException.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace Renfrew::Utility;
+
+#pragma managed(push, off)
+
+// Draws the label characters into the atlas, using GDI's greyscale anti-aliasing
+// (white on black, so any one channel is the coverage).
+// Returns 0, or the error code if something couldn't be created.
+static DWORD RasterizeGlyphs(const wchar_t *fontFamily, int emHeight, GlyphAtlas &atlas) {
+   std::string characters = GridRaster::LabelCharacters();
+
+   auto dc = CreateCompatibleDC(nullptr);
+
+   if (dc == nullptr)
+      return GetLastError();
+
+   auto font = CreateFontW(
+      -emHeight, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE,
+      DEFAULT_CHARSET, OUT_TT_PRECIS, CLIP_DEFAULT_PRECIS, ANTIALIASED_QUALITY,
+      FIXED_PITCH | FF_MODERN, fontFamily
+   );
+
+   if (font == nullptr) {
+      DeleteDC(dc);
+      return ERROR_INVALID_HANDLE;
+   }
+
+   auto oldFont = SelectObject(dc, font);
+
+   TEXTMETRICW metrics;
+   GetTextMetricsW(dc, &metrics);
+
+   int cellWidth = 0;
+
+   for (auto c : characters) {
+      wchar_t w = c;
+      SIZE size;
+
+      if (GetTextExtentPoint32W(dc, &w, 1, &size) != FALSE)
+         cellWidth = std::max(cellWidth, static_cast<int>(size.cx));
+   }
+
+   atlas.Reset(characters, cellWidth, metrics.tmHeight);
+
+   BITMAPINFO info { };
+   info.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+   info.bmiHeader.biWidth = atlas.Stride();
+   info.bmiHeader.biHeight = -atlas.CellHeight();
+   info.bmiHeader.biPlanes = 1;
+   info.bmiHeader.biBitCount = 32;
+   info.bmiHeader.biCompression = BI_RGB;
+
+   void *bits = nullptr;
+   auto bitmap = CreateDIBSection(dc, &info, DIB_RGB_COLORS, &bits, nullptr, 0);
+
+   DWORD error = 0;
+
+   if (bitmap == nullptr || bits == nullptr) {
+      error = GetLastError();
+   } else {
+      auto pixels = static_cast<std::uint32_t *>(bits);
+      auto count = static_cast<std::size_t>(atlas.Stride()) * atlas.CellHeight();
+
+      std::fill(pixels, pixels + count, 0);
+
+      auto oldBitmap = SelectObject(dc, bitmap);
+
+      SetTextColor(dc, RGB(255, 255, 255));
+      SetBkMode(dc, TRANSPARENT);
+
+      for (std::size_t i = 0; i < characters.size(); i++) {
+         wchar_t w = characters[i];
+         TextOutW(dc, static_cast<int>(i) * cellWidth, 0, &w, 1);
+      }
+
+      // Make sure GDI has finished with the bitmap before reading it
+      GdiFlush();
+
+      for (int y = 0; y < atlas.CellHeight(); y++) {
+         auto row = atlas.Glyph(characters[0]) + y * atlas.Stride();
+
+         for (int x = 0; x < atlas.Stride(); x++)
+            row[x] = static_cast<std::uint8_t>((pixels[y * atlas.Stride() + x] >> 8) & 0xFF);
+      }
+
+      SelectObject(dc, oldBitmap);
+      DeleteObject(bitmap);
+   }
+
+   SelectObject(dc, oldFont);
+   DeleteObject(font);
+   DeleteDC(dc);
+
+   return error;
+}
+
+#pragma managed(pop)
+
+static std::uint32_t ToBgr(Color colour) {
+   return (static_cast<std::uint32_t>(colour.R) << 16) |
+          (static_cast<std::uint32_t>(colour.G) << 8) |
+          static_cast<std::uint32_t>(colour.B);
+}
+
+GridOptions::GridOptions() {
+   FontFamily = "Consolas";
+   FontSize = 12;
+   LineOpacity = 1;
+   LabelOpacity = 1;
+}
+
+/// <summary>Creates a renderer for grids with the given options (which are copied).</summary>
+GridRenderer::GridRenderer(GridOptions ^options) {
+   if (options == nullptr)
+      throw gcnew ArgumentNullException("options");
+
+   if (options->CellSize <= 0)
+      throw gcnew ArgumentOutOfRangeException("options", "The cell size must be greater than 0.");
+
+   auto prefix = options->LabelPrefix;
+
+   if (prefix != L'\0' && (prefix > 0x7F || strchr(GridRaster::LabelCharacters(), static_cast<char>(prefix)) == nullptr))
+      throw gcnew ArgumentOutOfRangeException("options", "The label prefix must be a digit or a capital letter.");
+
+   _options = gcnew GridOptions();
+   _options->CellSize = options->CellSize;
+   _options->LineOffset = options->LineOffset;
+   _options->DashLength = options->DashLength;
+   _options->LineOpacity = options->LineOpacity;
+   _options->Cells = options->Cells;
+   _options->LabelOffset = options->LabelOffset;
+   _options->LabelSize = options->LabelSize;
+   _options->LabelOpacity = options->LabelOpacity;
+   _options->LabelPrefix = options->LabelPrefix;
+   _options->FontFamily = options->FontFamily;
+   _options->FontSize = options->FontSize;
+   _options->ShadowOffset = options->ShadowOffset;
+   _options->ShadowBlur = options->ShadowBlur;
+   _options->ShadowOpacity = options->ShadowOpacity;
+
+   _raster = new GridRaster();
+   _atlas = nullptr;
+   _atlasScale = 0;
+
+   _cache = gcnew Dictionary<Tuple<Int32, Int32, double, Color, Color> ^, BitmapSource ^>();
+}
+
+GridRenderer::~GridRenderer() {
+   this->!GridRenderer();
+}
+
+GridRenderer::!GridRenderer() {
+   delete _raster;
+   delete _atlas;
+
+   _raster = nullptr;
+   _atlas = nullptr;
+}
+
+BitmapSource ^GridRenderer::Render(double width, double height,
+                                   Color colour, Color shadowColour, double scale) {
+   if (_raster == nullptr)
+      throw gcnew ObjectDisposedException("GridRenderer");
+
+   if (scale <= 0)
+      throw gcnew ArgumentOutOfRangeException("scale");
+
+   int pixelWidth = static_cast<int>(Math::Ceiling(width * scale));
+   int pixelHeight = static_cast<int>(Math::Ceiling(height * scale));
+
+   if (pixelWidth <= 0 || pixelHeight <= 0)
+      return nullptr;
+
+   auto key = Tuple::Create(pixelWidth, pixelHeight, scale, colour, shadowColour);
+
+   BitmapSource ^bitmap;
+
+   if (_cache->TryGetValue(key, bitmap) == true)
+      return bitmap;
+
+   if (_atlas == nullptr || _atlasScale != scale)
+      RenderGlyphs(scale);
+
+   GridStyle style;
+   style.CellSize = _options->CellSize * scale;
+   style.LineOffset = _options->LineOffset * scale;
+   style.DashLength = _options->DashLength * scale;
+   style.LineOpacity = _options->LineOpacity;
+   style.Cells = _options->Cells;
+   style.LabelOffset = _options->LabelOffset * scale;
+   style.LabelSize = _options->LabelSize * scale;
+   style.LabelOpacity = _options->LabelOpacity;
+   style.LabelPrefix = static_cast<char>(_options->LabelPrefix);
+   style.ShadowOffset = _options->ShadowOffset * scale;
+   style.ShadowBlur = _options->ShadowBlur * scale;
+   style.ShadowOpacity = _options->ShadowOpacity;
+   style.Colour = ToBgr(colour);
+   style.ShadowColour = ToBgr(shadowColour);
+
+   std::vector<std::uint32_t> pixels(static_cast<std::size_t>(pixelWidth) * pixelHeight);
+
+   _raster->Render(*_atlas, style, ImageView { pixels.data(), pixelWidth, pixelHeight, pixelWidth });
+
+   bitmap = BitmapSource::Create(
+      pixelWidth, pixelHeight, 96.0 * scale, 96.0 * scale,
+      PixelFormats::Pbgra32, nullptr,
+      IntPtr(pixels.data()), static_cast<int>(pixels.size() * sizeof(std::uint32_t)),
+      pixelWidth * static_cast<int>(sizeof(std::uint32_t))
+   );
+
+   // So that it can be shared (and shown without being copied again)
+   bitmap->Freeze();
+
+   _cache->Add(key, bitmap);
+
+   return bitmap;
+}
+
+void GridRenderer::Clear() {
+   _cache->Clear();
+}
+
+void GridRenderer::RenderGlyphs(double scale) {
+   auto atlas = new GlyphAtlas();
+   auto emHeight = static_cast<int>(Math::Round(_options->FontSize * scale));
+
+   auto fontFamily = Marshal::StringToHGlobalUni(_options->FontFamily);
+
+   DWORD error;
+
+   try {
+      error = RasterizeGlyphs(static_cast<const wchar_t *>(fontFamily.ToPointer()), emHeight, *atlas);
+   } finally {
+      Marshal::FreeHGlobal(fontFamily);
+   }
+
+   if (error != 0) {
+      delete atlas;
+      throw gcnew MagnifierException("Failed to render the grid's glyphs.", error);
+   }
+
+   delete _atlas;
+
+   _atlas = atlas;
+   _atlasScale = scale;
+}
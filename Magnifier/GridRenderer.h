@@ -0,0 +1,118 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include "GridRaster.h"
+
+namespace Renfrew::Utility {
+
+   /// <summary>
+   /// How a labelled grid looks. Sizes are in device-independent units.
+   /// </summary>
+   public ref class GridOptions sealed {
+      public: GridOptions();
+
+      /// <summary>
+      /// Distance between the grid lines.
+      /// </summary>
+      public: property double CellSize;
+
+      /// <summary>
+      /// Where the first grid line is, across and down.
+      /// </summary>
+      public: property double LineOffset;
+
+      /// <summary>
+      /// The length of the dashes (and the gaps between them), or 0 for solid lines.
+      /// </summary>
+      public: property double DashLength;
+      public: property double LineOpacity;
+
+      /// <summary>
+      /// The number of labels across and down, or 0 (the default) for as many as
+      /// fit, up to 36.
+      /// </summary>
+      public: property int Cells;
+
+      /// <summary>
+      /// The box each label is centred in.
+      /// </summary>
+      public: property double LabelOffset;
+      public: property double LabelSize;
+      public: property double LabelOpacity;
+
+      /// <summary>
+      /// Drawn before every label (0 - 9 or A - Z), or '\0' (the default) for none.
+      /// </summary>
+      public: property System::Char LabelPrefix;
+
+      /// <summary>
+      /// Must be a monospaced font.
+      /// </summary>
+      public: property System::String ^FontFamily;
+      public: property double FontSize;
+
+      /// <summary>
+      /// How far the shadow is offset, down and to the right.
+      /// </summary>
+      public: property double ShadowOffset;
+      public: property double ShadowBlur;
+      public: property double ShadowOpacity;
+   };
+
+   /// <summary>
+   /// Draws a labelled grid as a single bitmap, from glyphs rendered once per
+   /// scale. The bitmaps are cached by size, scale and colour, so showing the grid
+   /// again (or switching back to a colour) doesn't draw anything.
+   /// </summary>
+   public ref class GridRenderer sealed {
+      private: GridOptions ^_options;
+
+      private: GridRaster *_raster;
+      private: GlyphAtlas *_atlas;
+      private: double _atlasScale;
+
+      private: System::Collections::Generic::Dictionary<
+         System::Tuple<System::Int32, System::Int32, double, System::Windows::Media::Color,
+                       System::Windows::Media::Color> ^,
+         System::Windows::Media::Imaging::BitmapSource ^
+      > ^_cache;
+
+      public: GridRenderer(GridOptions ^options);
+      public: ~GridRenderer();
+      protected: !GridRenderer();
+
+      /// <summary>
+      /// Gets the grid for an area of the given size (in device-independent units).
+      /// </summary>
+      /// <param name="scale">Device pixels per device-independent unit.</param>
+      /// <returns>A frozen, premultiplied bitmap with its DPI set to match the scale.</returns>
+      public: System::Windows::Media::Imaging::BitmapSource ^Render(
+         double width, double height,
+         System::Windows::Media::Color colour, System::Windows::Media::Color shadowColour,
+         double scale
+      );
+
+      /// <summary>
+      /// Drops the cached bitmaps (the glyphs are kept).
+      /// </summary>
+      public: void Clear();
+
+      private: void RenderGlyphs(double scale);
+   };
+}
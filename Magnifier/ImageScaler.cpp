@@ -0,0 +1,445 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include "CpuFeatures.h"
+#include "ImageScaler.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+#if defined(RENFREW_X86)
+   #include <immintrin.h>
+#endif
+
+using namespace Renfrew::Utility;
+
+// Both filters sample at pixel centres. The bilinear weights have 8 bits of
+// precision, and the rows are blended (and rounded) before the columns; the
+// SIMD paths do exactly the same arithmetic, so they match the reference.
+namespace {
+   struct Sample {
+      int Index;
+      int Weight;
+   };
+
+   int NearestIndex(int destination, int sourceSize, int destinationSize) {
+      auto index = (2LL * destination + 1) * sourceSize / (2LL * destinationSize);
+
+      return static_cast<int>(std::min<long long>(index, sourceSize - 1));
+   }
+
+   Sample BilinearSample(int destination, int sourceSize, int destinationSize) {
+      // Position in 16.16 fixed point, measured from the centre of the first pixel
+      auto position = ((2LL * destination + 1) * sourceSize << 16) / (2LL * destinationSize) - 32768;
+
+      if (position < 0)
+         position = 0;
+
+      int index = static_cast<int>(position >> 16);
+      int weight = static_cast<int>((position >> 8) & 0xFF);
+
+      if (index >= sourceSize - 1)
+         return Sample { sourceSize - 1, 0 };
+
+      return Sample { index, weight };
+   }
+
+   int Blend(int first, int second, int weight) {
+      return (first * (256 - weight) + second * weight + 128) >> 8;
+   }
+
+   int Channel(std::uint32_t pixel, int channel) {
+      return (pixel >> (channel * 8)) & 0xFF;
+   }
+
+   // Rows
+
+   void BlendRowsScalar(const std::uint32_t *top, const std::uint32_t *bottom,
+                        int weight, int width, std::uint16_t *row) {
+      for (int x = 0; x < width; x++) {
+         for (int c = 0; c < 4; c++)
+            row[x * 4 + c] = static_cast<std::uint16_t>(
+               Blend(Channel(top[x], c), Channel(bottom[x], c), weight)
+            );
+      }
+   }
+
+   void BlendColumnsScalar(const std::uint16_t *row, const std::int32_t *columns,
+                           const std::int32_t *weights, int width, std::uint32_t *destination) {
+      for (int x = 0; x < width; x++) {
+         auto first = row + columns[x] * 4;
+         std::uint32_t pixel = 0;
+
+         for (int c = 0; c < 4; c++)
+            pixel |= static_cast<std::uint32_t>(Blend(first[c], first[c + 4], weights[x])) << (c * 8);
+
+         destination[x] = pixel;
+      }
+   }
+
+   void GatherScalar(const std::uint32_t *source, const std::int32_t *columns,
+                     int width, std::uint32_t *destination) {
+      for (int x = 0; x < width; x++)
+         destination[x] = source[columns[x]];
+   }
+
+#if defined(RENFREW_X86)
+
+   // SSE2
+
+   RENFREW_TARGET_SSE2
+   void BlendRowsSse2(const std::uint32_t *top, const std::uint32_t *bottom,
+                      int weight, int width, std::uint16_t *row) {
+      const __m128i zero = _mm_setzero_si128();
+      const __m128i round = _mm_set1_epi16(128);
+      const __m128i topWeight = _mm_set1_epi16(static_cast<short>(256 - weight));
+      const __m128i bottomWeight = _mm_set1_epi16(static_cast<short>(weight));
+
+      int x = 0;
+
+      for (; x + 4 <= width; x += 4) {
+         __m128i t = _mm_loadu_si128(reinterpret_cast<const __m128i *>(top + x));
+         __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bottom + x));
+
+         __m128i low = _mm_add_epi16(
+            _mm_mullo_epi16(_mm_unpacklo_epi8(t, zero), topWeight),
+            _mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), bottomWeight)
+         );
+         __m128i high = _mm_add_epi16(
+            _mm_mullo_epi16(_mm_unpackhi_epi8(t, zero), topWeight),
+            _mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), bottomWeight)
+         );
+
+         _mm_storeu_si128(reinterpret_cast<__m128i *>(row + x * 4),
+                          _mm_srli_epi16(_mm_add_epi16(low, round), 8));
+         _mm_storeu_si128(reinterpret_cast<__m128i *>(row + x * 4 + 8),
+                          _mm_srli_epi16(_mm_add_epi16(high, round), 8));
+      }
+
+      BlendRowsScalar(top + x, bottom + x, weight, width - x, row + x * 4);
+   }
+
+   // Blends a pixel of the row with the one after it
+   RENFREW_TARGET_SSE2
+   inline __m128i BlendPairSse2(const std::uint16_t *row, std::int32_t column, std::int32_t weight) {
+      __m128i pair = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + column * 4));
+
+      // First and second pixel of the pair interleaved, channel by channel
+      pair = _mm_unpacklo_epi16(pair, _mm_srli_si128(pair, 8));
+
+      __m128i weights = _mm_set1_epi32((256 - weight) | (weight << 16));
+
+      return _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(pair, weights), _mm_set1_epi32(128)), 8);
+   }
+
+   RENFREW_TARGET_SSE2
+   void BlendColumnsSse2(const std::uint16_t *row, const std::int32_t *columns,
+                         const std::int32_t *weights, int width, std::uint32_t *destination) {
+      int x = 0;
+
+      for (; x + 2 <= width; x += 2) {
+         __m128i first = BlendPairSse2(row, columns[x], weights[x]);
+         __m128i second = BlendPairSse2(row, columns[x + 1], weights[x + 1]);
+
+         __m128i pixels = _mm_packs_epi32(first, second);
+         pixels = _mm_packus_epi16(pixels, pixels);
+
+         _mm_storel_epi64(reinterpret_cast<__m128i *>(destination + x), pixels);
+      }
+
+      BlendColumnsScalar(row, columns + x, weights + x, width - x, destination + x);
+   }
+
+   RENFREW_TARGET_SSE2
+   void GatherSse2(const std::uint32_t *source, const std::int32_t *columns,
+                   int width, std::uint32_t *destination) {
+      int x = 0;
+
+      for (; x + 4 <= width; x += 4) {
+         __m128i pixels = _mm_setr_epi32(
+            static_cast<int>(source[columns[x]]),
+            static_cast<int>(source[columns[x + 1]]),
+            static_cast<int>(source[columns[x + 2]]),
+            static_cast<int>(source[columns[x + 3]])
+         );
+
+         _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + x), pixels);
+      }
+
+      GatherScalar(source, columns + x, width - x, destination + x);
+   }
+
+   // AVX2
+
+   RENFREW_TARGET_AVX2
+   void BlendRowsAvx2(const std::uint32_t *top, const std::uint32_t *bottom,
+                      int weight, int width, std::uint16_t *row) {
+      const __m256i round = _mm256_set1_epi16(128);
+      const __m256i topWeight = _mm256_set1_epi16(static_cast<short>(256 - weight));
+      const __m256i bottomWeight = _mm256_set1_epi16(static_cast<short>(weight));
+
+      int x = 0;
+
+      for (; x + 4 <= width; x += 4) {
+         __m256i t = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(top + x)));
+         __m256i b = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(bottom + x)));
+
+         __m256i blended = _mm256_add_epi16(
+            _mm256_mullo_epi16(t, topWeight),
+            _mm256_mullo_epi16(b, bottomWeight)
+         );
+
+         _mm256_storeu_si256(reinterpret_cast<__m256i *>(row + x * 4),
+                             _mm256_srli_epi16(_mm256_add_epi16(blended, round), 8));
+      }
+
+      BlendRowsScalar(top + x, bottom + x, weight, width - x, row + x * 4);
+   }
+
+   // Blends two pixels of the row (one per 128-bit lane) with the ones after them
+   RENFREW_TARGET_AVX2
+   inline __m256i BlendPairsAvx2(const std::uint16_t *row,
+                                 std::int32_t firstColumn, std::int32_t firstWeight,
+                                 std::int32_t secondColumn, std::int32_t secondWeight) {
+      __m256i pairs = _mm256_inserti128_si256(
+         _mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + firstColumn * 4))
+         ),
+         _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + secondColumn * 4)),
+         1
+      );
+
+      pairs = _mm256_unpacklo_epi16(pairs, _mm256_srli_si256(pairs, 8));
+
+      __m256i weights = _mm256_inserti128_si256(
+         _mm256_set1_epi32((256 - firstWeight) | (firstWeight << 16)),
+         _mm_set1_epi32((256 - secondWeight) | (secondWeight << 16)),
+         1
+      );
+
+      return _mm256_srai_epi32(
+         _mm256_add_epi32(_mm256_madd_epi16(pairs, weights), _mm256_set1_epi32(128)), 8
+      );
+   }
+
+   RENFREW_TARGET_AVX2
+   void BlendColumnsAvx2(const std::uint16_t *row, const std::int32_t *columns,
+                         const std::int32_t *weights, int width, std::uint32_t *destination) {
+      int x = 0;
+
+      for (; x + 4 <= width; x += 4) {
+         // The lanes of the first hold pixels 0 and 2, of the second 1 and 3
+         __m256i first = BlendPairsAvx2(row, columns[x], weights[x], columns[x + 2], weights[x + 2]);
+         __m256i second = BlendPairsAvx2(row, columns[x + 1], weights[x + 1], columns[x + 3], weights[x + 3]);
+
+         // Each lane now holds two pixels: 0 and 1, then 2 and 3
+         __m256i pixels = _mm256_packs_epi32(first, second);
+         pixels = _mm256_packus_epi16(pixels, pixels);
+
+         // Take the first 64 bits of each lane
+         pixels = _mm256_permute4x64_epi64(pixels, 0x08);
+
+         _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + x), _mm256_castsi256_si128(pixels));
+      }
+
+      BlendColumnsScalar(row, columns + x, weights + x, width - x, destination + x);
+   }
+
+   RENFREW_TARGET_AVX2
+   void GatherAvx2(const std::uint32_t *source, const std::int32_t *columns,
+                   int width, std::uint32_t *destination) {
+      int x = 0;
+
+      for (; x + 8 <= width; x += 8) {
+         __m256i indices = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(columns + x));
+         __m256i pixels = _mm256_i32gather_epi32(reinterpret_cast<const int *>(source), indices, 4);
+
+         _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + x), pixels);
+      }
+
+      GatherScalar(source, columns + x, width - x, destination + x);
+   }
+
+#endif
+}
+
+ImageScaler::ImageScaler() {
+   _path = DetectSimdLevel();
+}
+
+ImageScaler::ImageScaler(SimdLevel path) {
+   _path = std::min(path, DetectSimdLevel());
+}
+
+SimdLevel ImageScaler::Path() const {
+   return _path;
+}
+
+void ImageScaler::Scale(const ConstImageView &source, const ImageView &destination,
+                        ScaleFilter filter) {
+   if (source.Width <= 0 || source.Height <= 0 || destination.Width <= 0 || destination.Height <= 0)
+      return;
+
+   if (filter == ScaleFilter::Bilinear)
+      ScaleBilinear(source, destination);
+   else
+      ScaleNearest(source, destination);
+}
+
+void ImageScaler::ScaleReference(const ConstImageView &source, const ImageView &destination,
+                                 ScaleFilter filter) {
+   if (source.Width <= 0 || source.Height <= 0 || destination.Width <= 0 || destination.Height <= 0)
+      return;
+
+   for (int y = 0; y < destination.Height; y++) {
+      auto target = destination.Pixels + static_cast<std::ptrdiff_t>(y) * destination.Stride;
+
+      if (filter == ScaleFilter::Nearest) {
+         auto row = source.Pixels +
+            static_cast<std::ptrdiff_t>(NearestIndex(y, source.Height, destination.Height)) * source.Stride;
+
+         for (int x = 0; x < destination.Width; x++)
+            target[x] = row[NearestIndex(x, source.Width, destination.Width)];
+
+         continue;
+      }
+
+      auto rows = BilinearSample(y, source.Height, destination.Height);
+
+      auto top = source.Pixels + static_cast<std::ptrdiff_t>(rows.Index) * source.Stride;
+      auto bottom = source.Pixels +
+         static_cast<std::ptrdiff_t>(std::min(rows.Index + 1, source.Height - 1)) * source.Stride;
+
+      for (int x = 0; x < destination.Width; x++) {
+         auto columns = BilinearSample(x, source.Width, destination.Width);
+
+         int left = columns.Index;
+         int right = std::min(left + 1, source.Width - 1);
+
+         std::uint32_t pixel = 0;
+
+         for (int c = 0; c < 4; c++) {
+            int first = Blend(Channel(top[left], c), Channel(bottom[left], c), rows.Weight);
+            int second = Blend(Channel(top[right], c), Channel(bottom[right], c), rows.Weight);
+
+            pixel |= static_cast<std::uint32_t>(Blend(first, second, columns.Weight)) << (c * 8);
+         }
+
+         target[x] = pixel;
+      }
+   }
+}
+
+void ImageScaler::ScaleNearest(const ConstImageView &source, const ImageView &destination) {
+   _columns.resize(destination.Width);
+
+   for (int x = 0; x < destination.Width; x++)
+      _columns[x] = NearestIndex(x, source.Width, destination.Width);
+
+   int previous = -1;
+
+   for (int y = 0; y < destination.Height; y++) {
+      auto target = destination.Pixels + static_cast<std::ptrdiff_t>(y) * destination.Stride;
+      int sourceY = NearestIndex(y, source.Height, destination.Height);
+
+      // When scaling up, most rows are the same as the one above them.
+      if (sourceY == previous) {
+         std::memcpy(target, target - destination.Stride, destination.Width * sizeof(std::uint32_t));
+         continue;
+      }
+
+      previous = sourceY;
+
+      auto row = source.Pixels + static_cast<std::ptrdiff_t>(sourceY) * source.Stride;
+
+      switch (_path) {
+#if defined(RENFREW_X86)
+         case SimdLevel::Avx2:
+            GatherAvx2(row, _columns.data(), destination.Width, target);
+            break;
+         case SimdLevel::Sse2:
+            GatherSse2(row, _columns.data(), destination.Width, target);
+            break;
+#endif
+         default:
+            GatherScalar(row, _columns.data(), destination.Width, target);
+            break;
+      }
+   }
+}
+
+void ImageScaler::ScaleBilinear(const ConstImageView &source, const ImageView &destination) {
+   _columns.resize(destination.Width);
+   _weights.resize(destination.Width);
+
+   for (int x = 0; x < destination.Width; x++) {
+      auto sample = BilinearSample(x, source.Width, destination.Width);
+
+      _columns[x] = sample.Index;
+      _weights[x] = sample.Weight;
+   }
+
+   // One extra pixel, so the last column can be blended with "the one after it"
+   // (with a weight of zero) without reading past the end.
+   _row.resize((source.Width + 1) * 4);
+
+   Sample previous { -1, 0 };
+
+   for (int y = 0; y < destination.Height; y++) {
+      auto target = destination.Pixels + static_cast<std::ptrdiff_t>(y) * destination.Stride;
+      auto rows = BilinearSample(y, source.Height, destination.Height);
+
+      if (rows.Index != previous.Index || rows.Weight != previous.Weight) {
+         previous = rows;
+
+         auto top = source.Pixels + static_cast<std::ptrdiff_t>(rows.Index) * source.Stride;
+         auto bottom = source.Pixels +
+            static_cast<std::ptrdiff_t>(std::min(rows.Index + 1, source.Height - 1)) * source.Stride;
+
+         switch (_path) {
+#if defined(RENFREW_X86)
+            case SimdLevel::Avx2:
+               BlendRowsAvx2(top, bottom, rows.Weight, source.Width, _row.data());
+               break;
+            case SimdLevel::Sse2:
+               BlendRowsSse2(top, bottom, rows.Weight, source.Width, _row.data());
+               break;
+#endif
+            default:
+               BlendRowsScalar(top, bottom, rows.Weight, source.Width, _row.data());
+               break;
+         }
+
+         std::copy_n(_row.data() + (source.Width - 1) * 4, 4, _row.data() + source.Width * 4);
+      }
+
+      switch (_path) {
+#if defined(RENFREW_X86)
+         case SimdLevel::Avx2:
+            BlendColumnsAvx2(_row.data(), _columns.data(), _weights.data(), destination.Width, target);
+            break;
+         case SimdLevel::Sse2:
+            BlendColumnsSse2(_row.data(), _columns.data(), _weights.data(), destination.Width, target);
+            break;
+#endif
+         default:
+            BlendColumnsScalar(_row.data(), _columns.data(), _weights.data(), destination.Width, target);
+            break;
+      }
+   }
+}
@@ -0,0 +1,96 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "CpuFeatures.h"
+
+// Plain C++ (no Windows or CLR dependencies), so that it can be built and
+// tested on its own.
+
+namespace Renfrew::Utility {
+
+   /// <summary>
+   /// 32-bit pixels (BGRA) that can be read. Stride is in pixels.
+   /// </summary>
+   struct ConstImageView {
+      const std::uint32_t *Pixels;
+      int Width;
+      int Height;
+      int Stride;
+   };
+
+   /// <summary>
+   /// 32-bit pixels (BGRA) that can be written. Stride is in pixels.
+   /// </summary>
+   struct ImageView {
+      std::uint32_t *Pixels;
+      int Width;
+      int Height;
+      int Stride;
+   };
+
+   enum class ScaleFilter {
+      Nearest,
+      Bilinear
+   };
+
+   /// <summary>
+   /// Resizes images to any size (so any scale, whole or not). Every path gives
+   /// exactly the same result as <see cref="ScaleReference"/>; the fastest one the
+   /// processor supports is picked at run time. The buffers used along the way are
+   /// kept, so an instance should be reused from frame to frame (by one thread).
+   /// </summary>
+   class ImageScaler {
+      private: SimdLevel _path;
+
+      // Source column, and the weight (out of 256) of the column after it, for
+      // each destination column
+      private: std::vector<std::int32_t> _columns;
+      private: std::vector<std::int32_t> _weights;
+
+      // Two source rows blended together, 16 bits per channel
+      private: std::vector<std::uint16_t> _row;
+
+      public: ImageScaler();
+
+      /// <summary>
+      /// Uses the given path, or the best one below it if the processor doesn't
+      /// support it.
+      /// </summary>
+      public: ImageScaler(SimdLevel path);
+
+      public: SimdLevel Path() const;
+
+      public: void Scale(const ConstImageView &source, const ImageView &destination,
+                         ScaleFilter filter);
+
+      /// <summary>
+      /// A straightforward (and slow) version of the scaling, one pixel at a time,
+      /// to check the other paths against.
+      /// </summary>
+      public: static void ScaleReference(const ConstImageView &source,
+                                         const ImageView &destination, ScaleFilter filter);
+
+      private: void ScaleNearest(const ConstImageView &source, const ImageView &destination);
+      private: void ScaleBilinear(const ConstImageView &source, const ImageView &destination);
+
+   };
+}
@@ -26,10 +26,15 @@ using namespace System::Windows;
 using namespace System::Windows::Interop;
 using namespace System::Runtime::InteropServices;
 
+using namespace System::Collections::Generic;
 using namespace System::Diagnostics;
+using namespace System::Threading;
 
 #include "Magnifier.h"
 #include "MagnifierException.h"
+#include "SoftwareMagnifier.h"
+
+#include <vector>
 
 using namespace Renfrew::Utility;
 
@@ -37,6 +42,8 @@ using namespace Renfrew::Utility;
 Magnifier::Magnifier() {
    _parentHwnd = nullptr;
    _magnifierHwnd = nullptr;
+   _software = nullptr;
+   _appliedOverlaysVersion = 0;
 }
 
 /// <summary>Binds the Magnifier to the given WPF surface/window.</summary>
@@ -63,6 +70,9 @@ HandleRef Magnifier::BuildWindowCore(HandleRef handleRef) {
 /// <summary>Unbinds the Magnifier from the given WPF surface/window.</summary>
 /// <param name="handleRef">The window handle of the parent window.</param>
 void Magnifier::DestroyWindowCore(HandleRef handleRef) {
+   delete _software;
+   _software = nullptr;
+
    if (DestroyWindow(_parentHwnd) == TRUE)
       return;
 
@@ -70,37 +80,154 @@ void Magnifier::DestroyWindowCore(HandleRef handleRef) {
 }
 
 /// <summary>
-/// Initializes the magnifier.
+/// Initializes the magnifier. Falls back to scaling the screen in software if the
+/// magnification subsystem can't be initialized.
 /// </summary>
 void Magnifier::Initialize(double scaleMultiplier) {
-   if (MagInitialize() == FALSE)
-      throw gcnew Exception("Could not initialize magnification subsystem.");
-
-   _magnifierHwnd = CreateWindow(
-      WC_MAGNIFIER, TEXT("MagnifierWindow"),
-      WS_CHILD | MS_SHOWMAGNIFIEDCURSOR | WS_VISIBLE, // | MS_INVERTCOLORS,
-      0, 0,
-      static_cast<int>(300 * scaleMultiplier),
-      static_cast<int>(300 * scaleMultiplier),
-      _parentHwnd, NULL,
-      _hInstance, NULL
-   );
+   auto size = static_cast<int>(300 * scaleMultiplier);
 
-   if (_magnifierHwnd == nullptr)
-      throw gcnew MagnifierException("Failed to create magnifier window.", GetLastError());
+   if (MagInitialize() == TRUE) {
+      _magnifierHwnd = CreateWindow(
+         WC_MAGNIFIER, TEXT("MagnifierWindow"),
+         WS_CHILD | MS_SHOWMAGNIFIEDCURSOR | WS_VISIBLE, // | MS_INVERTCOLORS,
+         0, 0,
+         size, size,
+         _parentHwnd, NULL,
+         _hInstance, NULL
+      );
+
+      if (_magnifierHwnd == nullptr)
+         throw gcnew MagnifierException("Failed to create magnifier window.", GetLastError());
+   } else {
+      Debug::WriteLine("Magnifier: Could not initialize magnification subsystem; scaling in software.");
+
+      _software = SoftwareMagnifier::Create(_parentHwnd, _hInstance, size, size);
+
+      if (_software == nullptr)
+         throw gcnew MagnifierException("Failed to create software magnifier window.", GetLastError());
+   }
 
-   SetMagnification(3);
+   SetMagnification(3.0);
    Update(0, 0, 100, 100);
 }
 
+/// <summary>
+/// Resizes the magnifier for the scale of the screen it's on. Does nothing
+/// before the magnifier is initialized (it's sized then).
+/// </summary>
+/// <param name="scaleMultiplier">The screen's display scale (1.0 for 96 DPI).</param>
+void Magnifier::SetScaleMultiplier(double scaleMultiplier) {
+   auto size = static_cast<int>(300 * scaleMultiplier);
+
+   if (_software != nullptr) {
+      _software->SetSize(size, size);
+      return;
+   }
+
+   if (_magnifierHwnd == nullptr)
+      return;
+
+   SetWindowPos(_magnifierHwnd, nullptr, 0, 0, size, size, SWP_NOMOVE | SWP_NOZORDER | SWP_NOACTIVATE);
+}
+
+void Magnifier::AddOverlay(IntPtr hwnd) {
+   if (hwnd == IntPtr::Zero)
+      throw gcnew ArgumentNullException("hwnd");
+
+   Monitor::Enter(_overlays);
+
+   try {
+      if (_overlays->Contains(hwnd) == false) {
+         _overlays->Add(hwnd);
+         _overlaysVersion++;
+      }
+   } finally {
+      Monitor::Exit(_overlays);
+   }
+}
+
+void Magnifier::RemoveOverlay(IntPtr hwnd) {
+   Monitor::Enter(_overlays);
+
+   try {
+      if (_overlays->Remove(hwnd) == true)
+         _overlaysVersion++;
+   } finally {
+      Monitor::Exit(_overlays);
+   }
+}
+
+array<IntPtr> ^Magnifier::GetOverlays() {
+   Monitor::Enter(_overlays);
+
+   try {
+      return _overlays->ToArray();
+   } finally {
+      Monitor::Exit(_overlays);
+   }
+}
+
+// Brings the magnifier's exclusions up to date with the overlay list. The
+// Magnification API filters the windows itself. The screen copy the software
+// magnifier uses can't, so the overlays are excluded from screen capture instead
+// (Windows 10 2004 and up; on older versions they're still copied).
+void Magnifier::ApplyOverlays() {
+   array<IntPtr> ^overlays;
+   int version;
+
+   Monitor::Enter(_overlays);
+
+   try {
+      version = _overlaysVersion;
+
+      if (version == _appliedOverlaysVersion)
+         return;
+
+      overlays = _overlays->ToArray();
+   } finally {
+      Monitor::Exit(_overlays);
+   }
+
+   _appliedOverlaysVersion = version;
+
+   if (_software != nullptr) {
+      for each (auto overlay in overlays)
+         SetWindowDisplayAffinity(static_cast<HWND>(overlay.ToPointer()), WDA_EXCLUDEFROMCAPTURE);
+
+      return;
+   }
+
+   std::vector<HWND> hwnds;
+
+   for each (auto overlay in overlays)
+      hwnds.push_back(static_cast<HWND>(overlay.ToPointer()));
+
+   auto filtered = MagSetWindowFilterList(
+      _magnifierHwnd, MW_FILTERMODE_EXCLUDE,
+      static_cast<int>(hwnds.size()), hwnds.empty() == true ? nullptr : hwnds.data()
+   );
+
+   if (filtered == FALSE)
+      Debug::WriteLine("Magnifier: Could not set the window filter list; overlays will be magnified.");
+}
+
+bool Magnifier::IsSoftware::get() {
+   return _software != nullptr;
+}
+
 /// <summary>
 /// Sets the magnification multiplier.
 /// </summary>
-/// <param name="multiplier">The multiplier for the zoom-level.</param>
-void Magnifier::SetMagnification(Int32 multiplier) {
-   if (multiplier < 0)
+/// <param name="multiplier">The multiplier for the zoom-level (needn't be whole).</param>
+void Magnifier::SetMagnification(Double multiplier) {
+   if (multiplier <= 0.0)
       throw gcnew ArgumentOutOfRangeException("multiplier must be a positive number!");
 
+   if (_software != nullptr) {
+      _software->SetMagnification(multiplier);
+      return;
+   }
+
    MAGTRANSFORM matrix;
    memset(&matrix, 0, sizeof(matrix));
    matrix.v[0][0] = (float) multiplier;
@@ -127,7 +254,16 @@ void Magnifier::SetMagnification(Int32 multiplier) {
 /// <param name="width">The width of the source rectangle, in pixels.</param>
 /// <param name="height">The height of the source rectangle, in pixels.</param>
 void Magnifier::Update(Int32 x, Int32 y, Int32 width, Int32 height) {
-   RECT r = { x, y, width, height };
+   RECT r = { x, y, x + width, y + height };
+
+   ApplyOverlays();
+
+   if (_software != nullptr) {
+      if (_software->Update(r) == true)
+         return;
+
+      throw gcnew MagnifierException("Failed to update software magnifier.", GetLastError());
+   }
 
    if (MagSetWindowSource(_magnifierHwnd, r) == TRUE)
       return;
@@ -21,11 +21,25 @@ using namespace System;
 
 namespace Renfrew::Utility {
 
+   class SoftwareMagnifier;
+
    public ref class Magnifier : public HwndHost {
       private: HWND _parentHwnd;
       private: HWND _magnifierHwnd;
       private: HINSTANCE _hInstance;
 
+      // Used instead of the Magnification API when it can't be initialized
+      private: SoftwareMagnifier *_software;
+
+      // Windows left out of every magnifier's image; guarded by locking the list.
+      // The version goes up whenever the list changes.
+      private: static System::Collections::Generic::List<IntPtr> ^_overlays =
+         gcnew System::Collections::Generic::List<IntPtr>();
+      private: static int _overlaysVersion = 0;
+
+      // The version of the list this magnifier last applied
+      private: int _appliedOverlaysVersion;
+
       public: Magnifier();
 
       // From HwndHost
@@ -33,8 +47,32 @@ namespace Renfrew::Utility {
       protected: virtual void DestroyWindowCore(HandleRef handleRef) override;
 
       public: void Initialize(double scaleMultiplier);
-      public: void SetMagnification(Int32 multiplier);
+      public: void SetScaleMultiplier(double scaleMultiplier);
+      public: void SetMagnification(Double multiplier);
       public: void Update(Int32 x, Int32 y, Int32 width, Int32 height);
+
+      /// <summary>
+      /// Leaves the given (top-level) window out of the magnified image, so that our
+      /// own overlays can stay on the screen while it's being magnified. Applies to
+      /// every magnifier. Safe to call from any thread.
+      /// </summary>
+      public: static void AddOverlay(IntPtr hwnd);
+      public: static void RemoveOverlay(IntPtr hwnd);
+
+      /// <summary>
+      /// A copy of the overlay list, for anything else that looks at the screen.
+      /// </summary>
+      internal: static array<IntPtr> ^GetOverlays();
+
+      private: void ApplyOverlays();
+
+      /// <summary>
+      /// Whether the screen is being scaled in software, rather than by the
+      /// Magnification API.
+      /// </summary>
+      public: property bool IsSoftware {
+         bool get();
+      }
    };
 
 }
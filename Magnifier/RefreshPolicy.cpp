@@ -0,0 +1,135 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include "RefreshPolicy.h"
+
+using namespace Renfrew::Utility;
+
+RefreshPolicy::RefreshPolicy(double heartbeatMs) {
+   _source = SourceRect { 0, 0, 0, 0 };
+   _hasSource = false;
+   _dirty = true;
+
+   _heartbeat = heartbeatMs;
+   _lastUpdate = 0.0;
+
+   _expectedFrames = 0;
+}
+
+const SourceRect &RefreshPolicy::Source() const {
+   return _source;
+}
+
+bool RefreshPolicy::HasSource() const {
+   return _hasSource;
+}
+
+void RefreshPolicy::SetSource(const SourceRect &source) {
+   if (_hasSource == true && source == _source)
+      return;
+
+   _source = source;
+   _hasSource = true;
+   _dirty = true;
+}
+
+void RefreshPolicy::Invalidate() {
+   _dirty = true;
+}
+
+bool RefreshPolicy::ShouldUpdate(std::uint64_t composedFrames, double nowMs) const {
+   if (_hasSource == false)
+      return false;
+
+   if (_dirty == true || composedFrames == 0)
+      return true;
+
+   // Something else was drawn since the last update was shown
+   if (composedFrames > _expectedFrames)
+      return true;
+
+   return nowMs - _lastUpdate >= _heartbeat;
+}
+
+void RefreshPolicy::Updated(std::uint64_t composedFrames, double nowMs) {
+   _dirty = false;
+   _lastUpdate = nowMs;
+
+   // The update itself shows up in the next composed frame
+   _expectedFrames = composedFrames + 1;
+}
+
+FrameStatistics::FrameStatistics() {
+   _frameTime = 0.0;
+   _updateTime = 0.0;
+   _cpuUsage = 0.0;
+
+   _frames = 0;
+   _updates = 0;
+
+   _cpuTime = 0.0;
+   _wallTime = 0.0;
+}
+
+void FrameStatistics::AddFrame(double intervalMs) {
+   _frameTime = Average(_frameTime, intervalMs, _frames++);
+}
+
+void FrameStatistics::AddUpdate(double durationMs) {
+   _updateTime = Average(_updateTime, durationMs, _updates++);
+}
+
+void FrameStatistics::AddCpuTime(double cpuMs, double wallMs) {
+   _cpuTime += cpuMs;
+   _wallTime += wallMs;
+
+   if (_wallTime < CpuWindow)
+      return;
+
+   _cpuUsage = _cpuTime / _wallTime;
+
+   _cpuTime = 0.0;
+   _wallTime = 0.0;
+}
+
+double FrameStatistics::AverageFrameTime() const {
+   return _frameTime;
+}
+
+double FrameStatistics::AverageUpdateTime() const {
+   return _updateTime;
+}
+
+double FrameStatistics::CpuUsage() const {
+   return _cpuUsage;
+}
+
+std::uint64_t FrameStatistics::Frames() const {
+   return _frames;
+}
+
+std::uint64_t FrameStatistics::Updates() const {
+   return _updates;
+}
+
+// The first sample is taken as is, so the average doesn't have to climb up from zero.
+double FrameStatistics::Average(double average, double sample, std::uint64_t count) {
+   if (count == 0)
+      return sample;
+
+   return average + (sample - average) * Smoothing;
+}
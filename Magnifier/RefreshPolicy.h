@@ -0,0 +1,129 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <cstdint>
+
+// Plain C++ (no Windows or CLR dependencies), so that it can be built and
+// tested on its own.
+
+namespace Renfrew::Utility {
+
+   /// <summary>
+   /// The part of the screen shown by the magnifier, in physical pixels.
+   /// </summary>
+   struct SourceRect {
+      int X;
+      int Y;
+      int Width;
+      int Height;
+
+      bool operator ==(const SourceRect &other) const {
+         return X == other.X && Y == other.Y && Width == other.Width && Height == other.Height;
+      }
+
+      bool operator !=(const SourceRect &other) const {
+         return !(*this == other);
+      }
+   };
+
+   /// <summary>
+   /// Decides when the magnifier needs to be updated: when the source rectangle
+   /// moves, or when something other than the magnifier itself has been drawn on
+   /// the screen. Screen changes are spotted by counting the frames composed by
+   /// the desktop window manager; each update of the magnifier accounts for one.
+   /// </summary>
+   class RefreshPolicy {
+      // Longest time to go without an update, in case a change was missed
+      public: static constexpr double DefaultHeartbeat = 250.0;
+
+      private: SourceRect _source;
+      private: bool _hasSource;
+      private: bool _dirty;
+
+      private: double _heartbeat;
+      private: double _lastUpdate;
+
+      // Frames composed by the time the last update should have been shown
+      private: std::uint64_t _expectedFrames;
+
+      public: RefreshPolicy(double heartbeatMs = DefaultHeartbeat);
+
+      public: const SourceRect &Source() const;
+      public: bool HasSource() const;
+
+      /// <summary>
+      /// Sets the source rectangle. Nothing changes if it's the same as before.
+      /// </summary>
+      public: void SetSource(const SourceRect &source);
+
+      /// <summary>
+      /// Forces an update on the next frame.
+      /// </summary>
+      public: void Invalidate();
+
+      /// <param name="composedFrames">
+      /// The number of frames composed so far, or 0 if it isn't known (in which
+      /// case the screen is assumed to have changed).
+      /// </param>
+      public: bool ShouldUpdate(std::uint64_t composedFrames, double nowMs) const;
+
+      public: void Updated(std::uint64_t composedFrames, double nowMs);
+   };
+
+   /// <summary>
+   /// Keeps running figures for the frame time, the time taken by updates, and
+   /// the share of a core used by the refresh thread.
+   /// </summary>
+   class FrameStatistics {
+      // How much each new sample counts towards the averages
+      public: static constexpr double Smoothing = 1.0 / 16.0;
+
+      // How much time the CPU usage is measured over, in milliseconds
+      public: static constexpr double CpuWindow = 1000.0;
+
+      private: double _frameTime;
+      private: double _updateTime;
+      private: double _cpuUsage;
+
+      private: std::uint64_t _frames;
+      private: std::uint64_t _updates;
+
+      private: double _cpuTime;
+      private: double _wallTime;
+
+      public: FrameStatistics();
+
+      public: void AddFrame(double intervalMs);
+      public: void AddUpdate(double durationMs);
+
+      /// <summary>
+      /// Adds CPU time used by the refresh thread over a period of wall clock time.
+      /// </summary>
+      public: void AddCpuTime(double cpuMs, double wallMs);
+
+      public: double AverageFrameTime() const;
+      public: double AverageUpdateTime() const;
+      public: double CpuUsage() const;
+
+      public: std::uint64_t Frames() const;
+      public: std::uint64_t Updates() const;
+
+      private: static double Average(double average, double sample, std::uint64_t count);
+   };
+}
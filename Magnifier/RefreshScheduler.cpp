@@ -0,0 +1,300 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include "stdafx.h"
+
+#using "PresentationFramework.dll"
+#using "PresentationCore.dll"
+#using "WindowsBase.dll"
+#using "System.Xaml.dll"
+
+using namespace System::Windows::Interop;
+using namespace System::Runtime::InteropServices;
+
+using namespace System;
+using namespace System::Diagnostics;
+using namespace System::Threading;
+
+#include "MagnifierException.h"
+#include "RefreshScheduler.h"
+
+using namespace Renfrew::Utility;
+
+#pragma managed(push, off)
+
+// Used when the refresh rate can't be read from the desktop window manager (60 Hz)
+static const double defaultRefreshPeriod = 1000.0 / 60.0;
+
+static double Now() {
+   static LARGE_INTEGER frequency = [] {
+      LARGE_INTEGER f;
+      QueryPerformanceFrequency(&f);
+      return f;
+   }();
+
+   LARGE_INTEGER counter;
+   QueryPerformanceCounter(&counter);
+
+   return counter.QuadPart * 1000.0 / frequency.QuadPart;
+}
+
+// CPU time used by the calling thread, in milliseconds
+static double ThreadCpuTime() {
+   FILETIME creation, exit, kernel, user;
+
+   if (GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user) == FALSE)
+      return 0.0;
+
+   ULARGE_INTEGER k { kernel.dwLowDateTime, kernel.dwHighDateTime };
+   ULARGE_INTEGER u { user.dwLowDateTime, user.dwHighDateTime };
+
+   // 100 ns units
+   return (k.QuadPart + u.QuadPart) / 10000.0;
+}
+
+// Gets the number of frames composed so far (0 if unknown), and the refresh period.
+static UINT64 ReadCompositionTiming(double &refreshPeriod) {
+   static LARGE_INTEGER frequency = [] {
+      LARGE_INTEGER f;
+      QueryPerformanceFrequency(&f);
+      return f;
+   }();
+
+   DWM_TIMING_INFO info { sizeof(DWM_TIMING_INFO) };
+
+   refreshPeriod = defaultRefreshPeriod;
+
+   if (FAILED(DwmGetCompositionTimingInfo(nullptr, &info)))
+      return 0;
+
+   if (info.qpcRefreshPeriod > 0)
+      refreshPeriod = info.qpcRefreshPeriod * 1000.0 / frequency.QuadPart;
+
+   return info.cFrame;
+}
+
+// Waits for the next frame. DwmFlush returns early when composition is off, or
+// when there's nothing to compose, so the rest of the period is slept off.
+static void WaitForFrame(double refreshPeriod) {
+   double start = Now();
+
+   DwmFlush();
+
+   double remaining = refreshPeriod - (Now() - start);
+
+   if (remaining > refreshPeriod / 2)
+      Sleep(static_cast<DWORD>(remaining));
+}
+
+#pragma managed(pop)
+
+RefreshStatistics::RefreshStatistics(const FrameStatistics &statistics) {
+   _frameTime = statistics.AverageFrameTime();
+   _updateTime = statistics.AverageUpdateTime();
+   _cpuUsage = statistics.CpuUsage();
+   _frames = static_cast<Int64>(statistics.Frames());
+   _updates = static_cast<Int64>(statistics.Updates());
+}
+
+double RefreshStatistics::AverageFrameTime::get() {
+   return _frameTime;
+}
+
+double RefreshStatistics::AverageUpdateTime::get() {
+   return _updateTime;
+}
+
+double RefreshStatistics::CpuUsage::get() {
+   return _cpuUsage;
+}
+
+Int64 RefreshStatistics::Frames::get() {
+   return _frames;
+}
+
+Int64 RefreshStatistics::Updates::get() {
+   return _updates;
+}
+
+/// <summary>Creates a scheduler for the given magnifier. It starts out suspended.</summary>
+RefreshScheduler::RefreshScheduler(Magnifier ^magnifier) {
+   if (magnifier == nullptr)
+      throw gcnew ArgumentNullException("magnifier");
+
+   _magnifier = magnifier;
+
+   _lock = gcnew Object();
+   _running = gcnew ManualResetEvent(false);
+
+   _policy = new RefreshPolicy();
+   _statistics = new FrameStatistics();
+
+   _thread = gcnew Thread(gcnew ThreadStart(this, &RefreshScheduler::Run));
+   _thread->Name = "Magnifier Refresh";
+   _thread->IsBackground = true;
+   _thread->Start();
+}
+
+RefreshScheduler::~RefreshScheduler() {
+   Monitor::Enter(_lock);
+
+   try {
+      _disposed = true;
+   } finally {
+      Monitor::Exit(_lock);
+   }
+
+   // Wake the thread so it sees that it's been disposed; it frees the native state
+   // on its way out.
+   _running->Set();
+}
+
+// Must be called with the lock held
+void RefreshScheduler::Free() {
+   delete _policy;
+   delete _statistics;
+
+   _policy = nullptr;
+   _statistics = nullptr;
+}
+
+RefreshStatistics ^RefreshScheduler::Statistics::get() {
+   Monitor::Enter(_lock);
+
+   try {
+      ThrowIfDisposed();
+      return gcnew RefreshStatistics(*_statistics);
+   } finally {
+      Monitor::Exit(_lock);
+   }
+}
+
+void RefreshScheduler::SetSource(Int32 x, Int32 y, Int32 width, Int32 height) {
+   Monitor::Enter(_lock);
+
+   try {
+      ThrowIfDisposed();
+      _policy->SetSource(SourceRect { x, y, width, height });
+   } finally {
+      Monitor::Exit(_lock);
+   }
+}
+
+void RefreshScheduler::Invalidate() {
+   Monitor::Enter(_lock);
+
+   try {
+      ThrowIfDisposed();
+      _policy->Invalidate();
+   } finally {
+      Monitor::Exit(_lock);
+   }
+}
+
+void RefreshScheduler::Resume() {
+   Invalidate();
+   _running->Set();
+}
+
+void RefreshScheduler::Suspend() {
+   _running->Reset();
+}
+
+void RefreshScheduler::Run() {
+   for (;;) {
+      _running->WaitOne();
+
+      // The time spent suspended doesn't count towards the statistics.
+      double lastFrame = Now();
+      double lastCpu = ThreadCpuTime();
+      double refreshPeriod = defaultRefreshPeriod;
+
+      while (_running->WaitOne(0) == true) {
+         WaitForFrame(refreshPeriod);
+
+         double now = Now();
+         double cpu = ThreadCpuTime();
+         UINT64 composed = ReadCompositionTiming(refreshPeriod);
+
+         bool update = false;
+         SourceRect source;
+
+         Monitor::Enter(_lock);
+
+         try {
+            if (_disposed == true) {
+               Free();
+               return;
+            }
+
+            update = _policy->ShouldUpdate(composed, now);
+            source = _policy->Source();
+
+            // Marked as done up front, so that a source set while the update is
+            // running isn't lost.
+            if (update == true)
+               _policy->Updated(composed, now);
+         } finally {
+            Monitor::Exit(_lock);
+         }
+
+         double updateTime = 0.0;
+
+         if (update == true) {
+            try {
+               _magnifier->Update(source.X, source.Y, source.Width, source.Height);
+            } catch (MagnifierException ^e) {
+               Debug::WriteLine("RefreshScheduler: " + e->Message);
+            }
+
+            updateTime = Now() - now;
+         }
+
+         Monitor::Enter(_lock);
+
+         try {
+            _statistics->AddFrame(now - lastFrame);
+            _statistics->AddCpuTime(cpu - lastCpu, now - lastFrame);
+
+            if (update == true)
+               _statistics->AddUpdate(updateTime);
+         } finally {
+            Monitor::Exit(_lock);
+         }
+
+         lastFrame = now;
+         lastCpu = cpu;
+      }
+
+      Monitor::Enter(_lock);
+
+      try {
+         if (_disposed == true) {
+            Free();
+            return;
+         }
+      } finally {
+         Monitor::Exit(_lock);
+      }
+   }
+}
+
+// Must be called with the lock held
+void RefreshScheduler::ThrowIfDisposed() {
+   if (_disposed == true)
+      throw gcnew ObjectDisposedException("RefreshScheduler");
+}
@@ -0,0 +1,118 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include "Magnifier.h"
+#include "RefreshPolicy.h"
+
+namespace Renfrew::Utility {
+
+   /// <summary>
+   /// A snapshot of how the magnifier refresh is performing.
+   /// </summary>
+   public ref class RefreshStatistics sealed {
+      private: double _frameTime;
+      private: double _updateTime;
+      private: double _cpuUsage;
+      private: System::Int64 _frames;
+      private: System::Int64 _updates;
+
+      internal: RefreshStatistics(const FrameStatistics &statistics);
+
+      /// <summary>
+      /// The average time between frames, in milliseconds.
+      /// </summary>
+      public: property double AverageFrameTime {
+         double get();
+      }
+
+      /// <summary>
+      /// The average time taken to update the magnifier, in milliseconds.
+      /// </summary>
+      public: property double AverageUpdateTime {
+         double get();
+      }
+
+      /// <summary>
+      /// The share of one core used by the refresh thread (0 - 1), over the last second
+      /// or so that it was running.
+      /// </summary>
+      public: property double CpuUsage {
+         double get();
+      }
+
+      public: property System::Int64 Frames {
+         System::Int64 get();
+      }
+
+      public: property System::Int64 Updates {
+         System::Int64 get();
+      }
+   };
+
+   /// <summary>
+   /// Keeps a magnifier up to date. Runs once per display refresh (paced by the
+   /// desktop window manager) while resumed, and only updates the magnifier when
+   /// the source rectangle or the screen has changed.
+   /// </summary>
+   public ref class RefreshScheduler sealed {
+      private: Magnifier ^_magnifier;
+
+      private: System::Object ^_lock;
+      private: System::Threading::Thread ^_thread;
+      private: System::Threading::ManualResetEvent ^_running;
+      private: bool _disposed;
+
+      // Guarded by _lock
+      private: RefreshPolicy *_policy;
+      private: FrameStatistics *_statistics;
+
+      public: RefreshScheduler(Magnifier ^magnifier);
+      public: ~RefreshScheduler();
+
+      public: property RefreshStatistics ^Statistics {
+         RefreshStatistics ^get();
+      }
+
+      /// <summary>
+      /// Sets the part of the screen to magnify. Safe to call from any thread.
+      /// </summary>
+      public: void SetSource(System::Int32 x, System::Int32 y,
+                             System::Int32 width, System::Int32 height);
+
+      /// <summary>
+      /// Makes the magnifier update on the next frame, whether or not anything
+      /// seems to have changed.
+      /// </summary>
+      public: void Invalidate();
+
+      /// <summary>
+      /// Starts refreshing (e.g. when the magnifier is shown).
+      /// </summary>
+      public: void Resume();
+
+      /// <summary>
+      /// Stops refreshing until resumed (e.g. when the magnifier is hidden).
+      /// </summary>
+      public: void Suspend();
+
+      private: void Run();
+      private: void Free();
+      private: void ThrowIfDisposed();
+   };
+}
@@ -0,0 +1,132 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include "stdafx.h"
+#include "ScreenCapture.h"
+
+#include <cstring>
+
+using namespace Renfrew::Utility;
+
+ScreenCapture::ScreenCapture(std::size_t poolSize)
+   : _pool(poolSize) {
+
+   _dc = nullptr;
+   _bitmap = nullptr;
+   _previous = nullptr;
+   _pixels = nullptr;
+   _stride = 0;
+   _height = 0;
+
+   _area = RECT { };
+}
+
+ScreenCapture::~ScreenCapture() {
+   Release();
+}
+
+FrameHandle ScreenCapture::Capture(const RECT &area, TileChanges &changes) {
+   int width = area.right - area.left;
+   int height = area.bottom - area.top;
+
+   if (width <= 0 || height <= 0)
+      return nullptr;
+
+   // A different part of the screen can't be compared with the last one.
+   if (EqualRect(&area, &_area) == FALSE) {
+      _detector.Reset();
+      _pool.Reserve(width, height);
+
+      _area = area;
+   }
+
+   auto frame = _pool.Acquire(width, height);
+
+   if (Resize(frame->Stride(), height) == false)
+      return nullptr;
+
+   auto screen = GetDC(nullptr);
+   auto copied = BitBlt(_dc, 0, 0, width, height, screen, area.left, area.top, SRCCOPY);
+   ReleaseDC(nullptr, screen);
+
+   if (copied == FALSE)
+      return nullptr;
+
+   // Make sure GDI has finished with the bitmap before reading it
+   GdiFlush();
+
+   std::memcpy(frame->Pixels(), _pixels,
+               static_cast<std::size_t>(_stride) * height * sizeof(std::uint32_t));
+
+   _detector.Update(frame->ConstView(), changes);
+
+   return frame;
+}
+
+bool ScreenCapture::Resize(int stride, int height) {
+   if (_dc != nullptr && _stride == stride && _height == height)
+      return true;
+
+   Release();
+
+   BITMAPINFO info { };
+
+   info.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+   info.bmiHeader.biWidth = stride;
+   info.bmiHeader.biHeight = -height; // Top-down
+   info.bmiHeader.biPlanes = 1;
+   info.bmiHeader.biBitCount = 32;
+   info.bmiHeader.biCompression = BI_RGB;
+
+   void *pixels = nullptr;
+
+   _bitmap = CreateDIBSection(nullptr, &info, DIB_RGB_COLORS, &pixels, nullptr, 0);
+
+   if (_bitmap == nullptr)
+      return false;
+
+   _dc = CreateCompatibleDC(nullptr);
+
+   if (_dc == nullptr) {
+      Release();
+      return false;
+   }
+
+   _previous = SelectObject(_dc, _bitmap);
+   _pixels = static_cast<std::uint32_t *>(pixels);
+   _stride = stride;
+   _height = height;
+
+   return true;
+}
+
+void ScreenCapture::Release() {
+   if (_dc != nullptr) {
+      SelectObject(_dc, _previous);
+      DeleteDC(_dc);
+   }
+
+   if (_bitmap != nullptr)
+      DeleteObject(_bitmap);
+
+   _dc = nullptr;
+   _bitmap = nullptr;
+   _previous = nullptr;
+   _pixels = nullptr;
+   _stride = 0;
+   _height = 0;
+}
@@ -0,0 +1,61 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include "FramePool.h"
+#include "TileHasher.h"
+
+namespace Renfrew::Utility {
+
+   /// <summary>
+   /// Copies part of the screen into pooled frames, and works out which tiles have
+   /// changed since the last capture of the same area, so callers can skip work
+   /// when nothing has.
+   /// </summary>
+   class ScreenCapture {
+      public: static constexpr std::size_t DefaultPoolSize = 3;
+
+      private: FramePool _pool;
+      private: ChangeDetector _detector;
+
+      // What the screen is copied into; rows are the same length as a frame's.
+      private: HDC _dc;
+      private: HBITMAP _bitmap;
+      private: HGDIOBJ _previous;
+      private: std::uint32_t *_pixels;
+      private: int _stride;
+      private: int _height;
+
+      private: RECT _area;
+
+      public: ScreenCapture(std::size_t poolSize = DefaultPoolSize);
+      public: ~ScreenCapture();
+
+      ScreenCapture(const ScreenCapture &) = delete;
+      ScreenCapture &operator =(const ScreenCapture &) = delete;
+
+      /// <summary>
+      /// Copies the given area of the screen.
+      /// </summary>
+      /// <returns>The frame, or nullptr if the screen couldn't be copied.</returns>
+      public: FrameHandle Capture(const RECT &area, TileChanges &changes);
+
+      private: bool Resize(int stride, int height);
+      private: void Release();
+   };
+}
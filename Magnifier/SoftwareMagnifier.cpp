@@ -0,0 +1,220 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include "stdafx.h"
+#include "SoftwareMagnifier.h"
+
+#include <cmath>
+
+using namespace Renfrew::Utility;
+
+static const wchar_t *windowClassName = L"RenfrewSoftwareMagnifier";
+
+SoftwareMagnifier::SoftwareMagnifier() {
+   _hwnd = nullptr;
+   InitializeSRWLock(&_lock);
+
+   _magnification = 1.0;
+
+   _frame = Surface { };
+   _frameMagnification = 0.0;
+}
+
+SoftwareMagnifier::~SoftwareMagnifier() {
+   if (_hwnd != nullptr) {
+      SetWindowLongPtrW(_hwnd, GWLP_USERDATA, 0);
+      DestroyWindow(_hwnd);
+   }
+
+   Release(_frame);
+}
+
+SoftwareMagnifier *SoftwareMagnifier::Create(HWND parent, HINSTANCE instance, int width, int height) {
+   WNDCLASSEXW windowClass { sizeof(WNDCLASSEXW) };
+
+   windowClass.lpfnWndProc = WindowProc;
+   windowClass.hInstance = instance;
+   windowClass.hCursor = LoadCursor(nullptr, IDC_ARROW);
+   windowClass.lpszClassName = windowClassName;
+
+   // Fails harmlessly if the class is already registered
+   RegisterClassExW(&windowClass);
+
+   auto magnifier = new SoftwareMagnifier();
+
+   magnifier->_hwnd = CreateWindowExW(
+      0, windowClassName, nullptr,
+      WS_CHILD | WS_VISIBLE,
+      0, 0, width, height,
+      parent, nullptr,
+      instance, nullptr
+   );
+
+   if (magnifier->_hwnd == nullptr) {
+      auto error = GetLastError();
+
+      delete magnifier;
+      SetLastError(error);
+
+      return nullptr;
+   }
+
+   SetWindowLongPtrW(magnifier->_hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(magnifier));
+
+   return magnifier;
+}
+
+void SoftwareMagnifier::SetMagnification(double magnification) {
+   AcquireSRWLockExclusive(&_lock);
+   _magnification = magnification;
+   ReleaseSRWLockExclusive(&_lock);
+}
+
+bool SoftwareMagnifier::Update(const RECT &source) {
+   int width = source.right - source.left;
+   int height = source.bottom - source.top;
+
+   if (width <= 0 || height <= 0)
+      return true;
+
+   TileChanges changes;
+   auto captured = _screen.Capture(source, changes);
+
+   if (captured == nullptr)
+      return false;
+
+   AcquireSRWLockExclusive(&_lock);
+
+   int frameWidth = static_cast<int>(std::lround(width * _magnification));
+   int frameHeight = static_cast<int>(std::lround(height * _magnification));
+
+   // Skip the scaling (and the repaint) if it would draw the same thing again.
+   bool stale = changes.Any() == true ||
+      _frameMagnification != _magnification ||
+      _frame.Width != frameWidth || _frame.Height != frameHeight;
+
+   bool resized = stale == false || Resize(_frame, frameWidth, frameHeight);
+
+   if (stale == true && resized == true) {
+      auto filter = _magnification == std::floor(_magnification) ?
+         ScaleFilter::Nearest : ScaleFilter::Bilinear;
+
+      _scaler.Scale(
+         captured->ConstView(),
+         ImageView { _frame.Pixels, _frame.Width, _frame.Height, _frame.Width },
+         filter
+      );
+
+      _frameMagnification = _magnification;
+   }
+
+   ReleaseSRWLockExclusive(&_lock);
+
+   if (stale == true)
+      InvalidateRect(_hwnd, nullptr, FALSE);
+
+   return resized;
+}
+
+void SoftwareMagnifier::Paint(HDC dc) {
+   AcquireSRWLockShared(&_lock);
+
+   if (_frame.Dc != nullptr)
+      BitBlt(dc, 0, 0, _frame.Width, _frame.Height, _frame.Dc, 0, 0, SRCCOPY);
+
+   ReleaseSRWLockShared(&_lock);
+}
+
+// Makes sure the surface is the given size. Its contents are lost if it changes.
+void SoftwareMagnifier::SetSize(int width, int height) {
+   SetWindowPos(_hwnd, nullptr, 0, 0, width, height, SWP_NOMOVE | SWP_NOZORDER | SWP_NOACTIVATE);
+}
+
+bool SoftwareMagnifier::Resize(Surface &surface, int width, int height) {
+   if (surface.Dc != nullptr && surface.Width == width && surface.Height == height)
+      return true;
+
+   Release(surface);
+
+   if (width <= 0 || height <= 0)
+      return false;
+
+   BITMAPINFO info { };
+
+   info.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+   info.bmiHeader.biWidth = width;
+   info.bmiHeader.biHeight = -height; // Top-down
+   info.bmiHeader.biPlanes = 1;
+   info.bmiHeader.biBitCount = 32;
+   info.bmiHeader.biCompression = BI_RGB;
+
+   void *pixels = nullptr;
+
+   surface.Bitmap = CreateDIBSection(nullptr, &info, DIB_RGB_COLORS, &pixels, nullptr, 0);
+
+   if (surface.Bitmap == nullptr)
+      return false;
+
+   surface.Dc = CreateCompatibleDC(nullptr);
+
+   if (surface.Dc == nullptr) {
+      Release(surface);
+      return false;
+   }
+
+   surface.Previous = SelectObject(surface.Dc, surface.Bitmap);
+   surface.Pixels = static_cast<std::uint32_t *>(pixels);
+   surface.Width = width;
+   surface.Height = height;
+
+   return true;
+}
+
+void SoftwareMagnifier::Release(Surface &surface) {
+   if (surface.Dc != nullptr) {
+      SelectObject(surface.Dc, surface.Previous);
+      DeleteDC(surface.Dc);
+   }
+
+   if (surface.Bitmap != nullptr)
+      DeleteObject(surface.Bitmap);
+
+   surface = Surface { };
+}
+
+LRESULT CALLBACK SoftwareMagnifier::WindowProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam) {
+   auto magnifier = reinterpret_cast<SoftwareMagnifier *>(GetWindowLongPtrW(hwnd, GWLP_USERDATA));
+
+   switch (message) {
+      case WM_ERASEBKGND:
+         // Everything is painted over anyway
+         return 1;
+
+      case WM_PAINT: {
+         PAINTSTRUCT paint;
+         auto dc = BeginPaint(hwnd, &paint);
+
+         if (magnifier != nullptr)
+            magnifier->Paint(dc);
+
+         EndPaint(hwnd, &paint);
+         return 0;
+      }
+   }
+
+   return DefWindowProcW(hwnd, message, wParam, lParam);
+}
@@ -0,0 +1,88 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include "ImageScaler.h"
+#include "ScreenCapture.h"
+
+namespace Renfrew::Utility {
+
+   /// <summary>
+   /// Shows a magnified part of the screen without the Magnification API (for when
+   /// it isn't available). The pixels are copied from the screen and scaled up in
+   /// software: nearest-neighbour for whole-number magnifications, which keeps the
+   /// pixels crisp, and bilinear otherwise. Nothing is scaled or redrawn while the
+   /// copied pixels stay the same.
+   /// </summary>
+   class SoftwareMagnifier {
+      private: struct Surface {
+         HDC Dc;
+         HBITMAP Bitmap;
+         HGDIOBJ Previous;
+         std::uint32_t *Pixels;
+         int Width;
+         int Height;
+      };
+
+      private: HWND _hwnd;
+      private: SRWLOCK _lock;
+
+      private: double _magnification;
+      private: ImageScaler _scaler;
+
+      // Only used by the thread calling Update
+      private: ScreenCapture _screen;
+
+      // Guarded by _lock; painted by the window
+      private: Surface _frame;
+      private: double _frameMagnification;
+
+      private: SoftwareMagnifier();
+
+      public: ~SoftwareMagnifier();
+
+      SoftwareMagnifier(const SoftwareMagnifier &) = delete;
+      SoftwareMagnifier &operator =(const SoftwareMagnifier &) = delete;
+
+      /// <summary>
+      /// Creates the magnifier, as a child of the given window.
+      /// </summary>
+      /// <returns>The magnifier, or nullptr if its window couldn't be created.</returns>
+      public: static SoftwareMagnifier *Create(HWND parent, HINSTANCE instance, int width, int height);
+
+      public: void SetMagnification(double magnification);
+
+      /// <summary>
+      /// Resizes the magnifier's window (in physical pixels).
+      /// </summary>
+      public: void SetSize(int width, int height);
+
+      /// <summary>
+      /// Copies the given part of the screen, scales it, and redraws the window.
+      /// </summary>
+      /// <returns>false if the screen couldn't be copied.</returns>
+      public: bool Update(const RECT &source);
+
+      private: void Paint(HDC dc);
+
+      private: static bool Resize(Surface &surface, int width, int height);
+      private: static void Release(Surface &surface);
+
+      private: static LRESULT CALLBACK WindowProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam);
+   };
+}
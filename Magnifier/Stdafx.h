@@ -20,4 +20,9 @@
 #define WIN32_LEAN_AND_MEAN
 
 #include <Windows.h>
+#include <dwmapi.h>
 #include <magnification.h>
+
+#ifndef WDA_EXCLUDEFROMCAPTURE
+#define WDA_EXCLUDEFROMCAPTURE 0x00000011
+#endif
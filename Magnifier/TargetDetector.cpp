@@ -0,0 +1,593 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include "TargetDetector.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+
+#if defined(RENFREW_X86)
+   #include <immintrin.h>
+#endif
+
+using namespace Renfrew::Utility;
+
+namespace {
+   // BT.601 weights, out of 256
+   const int blueWeight = 29;
+   const int greenWeight = 150;
+   const int redWeight = 77;
+
+   inline std::uint8_t GreyPixel(std::uint32_t p) {
+      int b = p & 0xFF;
+      int g = (p >> 8) & 0xFF;
+      int r = (p >> 16) & 0xFF;
+
+      return static_cast<std::uint8_t>((b * blueWeight + g * greenWeight + r * redWeight + 128) >> 8);
+   }
+
+   // Pixels [from, to) of a row
+   void GreyScalar(const std::uint32_t *source, std::uint8_t *destination, int from, int to) {
+      for (int x = from; x < to; x++)
+         destination[x] = GreyPixel(source[x]);
+   }
+
+   inline std::uint8_t EdgePixel(const std::uint8_t *a, const std::uint8_t *b,
+                                 const std::uint8_t *c, int x, int threshold) {
+      int gx = (a[x + 1] + 2 * b[x + 1] + c[x + 1]) - (a[x - 1] + 2 * b[x - 1] + c[x - 1]);
+      int gy = (c[x - 1] + 2 * c[x] + c[x + 1]) - (a[x - 1] + 2 * a[x] + a[x + 1]);
+
+      return std::abs(gx) + std::abs(gy) > threshold ? 255 : 0;
+   }
+
+   // Output pixels [from, to) of a row, where 0 < from and to < width
+   void EdgesScalar(const std::uint8_t *a, const std::uint8_t *b, const std::uint8_t *c,
+                    std::uint8_t *destination, int from, int to, int threshold) {
+      for (int x = from; x < to; x++)
+         destination[x] = EdgePixel(a, b, c, x, threshold);
+   }
+
+   inline std::uint8_t Max3(std::uint8_t a, std::uint8_t b, std::uint8_t c) {
+      return std::max(a, std::max(b, c));
+   }
+
+#if defined(RENFREW_X86)
+
+   RENFREW_TARGET_SSE2
+   inline __m128i GreySse2(__m128i pixels) {
+      const __m128i mask = _mm_set1_epi32(0xFF);
+
+      auto b = _mm_and_si128(pixels, mask);
+      auto g = _mm_and_si128(_mm_srli_epi32(pixels, 8), mask);
+      auto r = _mm_and_si128(_mm_srli_epi32(pixels, 16), mask);
+
+      // The high half of each 32-bit lane is 0, so 16-bit multiplies are enough
+      auto sum = _mm_add_epi32(
+         _mm_add_epi32(
+            _mm_mullo_epi16(b, _mm_set1_epi32(blueWeight)),
+            _mm_mullo_epi16(g, _mm_set1_epi32(greenWeight))
+         ),
+         _mm_add_epi32(_mm_mullo_epi16(r, _mm_set1_epi32(redWeight)), _mm_set1_epi32(128))
+      );
+
+      return _mm_srli_epi32(sum, 8);
+   }
+
+   RENFREW_TARGET_SSE2
+   int GreySse2(const std::uint32_t *source, std::uint8_t *destination, int width) {
+      int x = 0;
+
+      for (; x + 8 <= width; x += 8) {
+         auto lo = GreySse2(_mm_loadu_si128(reinterpret_cast<const __m128i *>(source + x)));
+         auto hi = GreySse2(_mm_loadu_si128(reinterpret_cast<const __m128i *>(source + x + 4)));
+
+         auto words = _mm_packs_epi32(lo, hi);
+
+         _mm_storel_epi64(reinterpret_cast<__m128i *>(destination + x), _mm_packus_epi16(words, words));
+      }
+
+      return x;
+   }
+
+   RENFREW_TARGET_AVX2
+   inline __m256i GreyAvx2(__m256i pixels) {
+      const __m256i mask = _mm256_set1_epi32(0xFF);
+
+      auto b = _mm256_and_si256(pixels, mask);
+      auto g = _mm256_and_si256(_mm256_srli_epi32(pixels, 8), mask);
+      auto r = _mm256_and_si256(_mm256_srli_epi32(pixels, 16), mask);
+
+      auto sum = _mm256_add_epi32(
+         _mm256_add_epi32(
+            _mm256_mullo_epi16(b, _mm256_set1_epi32(blueWeight)),
+            _mm256_mullo_epi16(g, _mm256_set1_epi32(greenWeight))
+         ),
+         _mm256_add_epi32(_mm256_mullo_epi16(r, _mm256_set1_epi32(redWeight)), _mm256_set1_epi32(128))
+      );
+
+      return _mm256_srli_epi32(sum, 8);
+   }
+
+   RENFREW_TARGET_AVX2
+   int GreyAvx2(const std::uint32_t *source, std::uint8_t *destination, int width) {
+      int x = 0;
+
+      for (; x + 16 <= width; x += 16) {
+         auto lo = GreyAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + x)));
+         auto hi = GreyAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + x + 8)));
+
+         // Packing works within each 128-bit half, so put the words back in order
+         auto words = _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xD8);
+
+         auto bytes = _mm_packus_epi16(
+            _mm256_castsi256_si128(words), _mm256_extracti128_si256(words, 1)
+         );
+
+         _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + x), bytes);
+      }
+
+      return x;
+   }
+
+   RENFREW_TARGET_SSE2
+   inline __m128i LoadWordsSse2(const std::uint8_t *p) {
+      return _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)), _mm_setzero_si128());
+   }
+
+   RENFREW_TARGET_SSE2
+   inline __m128i AbsSse2(__m128i v) {
+      return _mm_max_epi16(v, _mm_sub_epi16(_mm_setzero_si128(), v));
+   }
+
+   // Returns the first pixel it didn't do
+   RENFREW_TARGET_SSE2
+   int EdgesSse2(const std::uint8_t *a, const std::uint8_t *b, const std::uint8_t *c,
+                 std::uint8_t *destination, int width, int threshold) {
+      auto limit = _mm_set1_epi16(static_cast<short>(threshold));
+
+      int x = 1;
+
+      for (; x + 8 <= width - 1; x += 8) {
+         auto a0 = LoadWordsSse2(a + x - 1), a1 = LoadWordsSse2(a + x), a2 = LoadWordsSse2(a + x + 1);
+         auto b0 = LoadWordsSse2(b + x - 1), b2 = LoadWordsSse2(b + x + 1);
+         auto c0 = LoadWordsSse2(c + x - 1), c1 = LoadWordsSse2(c + x), c2 = LoadWordsSse2(c + x + 1);
+
+         auto gx = _mm_sub_epi16(
+            _mm_add_epi16(_mm_add_epi16(a2, c2), _mm_slli_epi16(b2, 1)),
+            _mm_add_epi16(_mm_add_epi16(a0, c0), _mm_slli_epi16(b0, 1))
+         );
+         auto gy = _mm_sub_epi16(
+            _mm_add_epi16(_mm_add_epi16(c0, c2), _mm_slli_epi16(c1, 1)),
+            _mm_add_epi16(_mm_add_epi16(a0, a2), _mm_slli_epi16(a1, 1))
+         );
+
+         auto edge = _mm_cmpgt_epi16(_mm_add_epi16(AbsSse2(gx), AbsSse2(gy)), limit);
+
+         _mm_storel_epi64(reinterpret_cast<__m128i *>(destination + x), _mm_packs_epi16(edge, edge));
+      }
+
+      return x;
+   }
+
+   RENFREW_TARGET_AVX2
+   inline __m256i LoadWordsAvx2(const std::uint8_t *p) {
+      return _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+   }
+
+   RENFREW_TARGET_AVX2
+   int EdgesAvx2(const std::uint8_t *a, const std::uint8_t *b, const std::uint8_t *c,
+                 std::uint8_t *destination, int width, int threshold) {
+      auto limit = _mm256_set1_epi16(static_cast<short>(threshold));
+
+      int x = 1;
+
+      for (; x + 16 <= width - 1; x += 16) {
+         auto a0 = LoadWordsAvx2(a + x - 1), a1 = LoadWordsAvx2(a + x), a2 = LoadWordsAvx2(a + x + 1);
+         auto b0 = LoadWordsAvx2(b + x - 1), b2 = LoadWordsAvx2(b + x + 1);
+         auto c0 = LoadWordsAvx2(c + x - 1), c1 = LoadWordsAvx2(c + x), c2 = LoadWordsAvx2(c + x + 1);
+
+         auto gx = _mm256_sub_epi16(
+            _mm256_add_epi16(_mm256_add_epi16(a2, c2), _mm256_slli_epi16(b2, 1)),
+            _mm256_add_epi16(_mm256_add_epi16(a0, c0), _mm256_slli_epi16(b0, 1))
+         );
+         auto gy = _mm256_sub_epi16(
+            _mm256_add_epi16(_mm256_add_epi16(c0, c2), _mm256_slli_epi16(c1, 1)),
+            _mm256_add_epi16(_mm256_add_epi16(a0, a2), _mm256_slli_epi16(a1, 1))
+         );
+
+         auto edge = _mm256_cmpgt_epi16(
+            _mm256_add_epi16(_mm256_abs_epi16(gx), _mm256_abs_epi16(gy)), limit
+         );
+
+         auto bytes = _mm_packs_epi16(_mm256_castsi256_si128(edge), _mm256_extracti128_si256(edge, 1));
+
+         _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + x), bytes);
+      }
+
+      return x;
+   }
+
+   RENFREW_TARGET_SSE2
+   int MaxRowsSse2(const std::uint8_t *a, const std::uint8_t *b, const std::uint8_t *c,
+                   std::uint8_t *destination, int width) {
+      int x = 0;
+
+      for (; x + 16 <= width; x += 16) {
+         auto m = _mm_max_epu8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + x)),
+            _mm_max_epu8(
+               _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + x)),
+               _mm_loadu_si128(reinterpret_cast<const __m128i *>(c + x))
+            )
+         );
+
+         _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + x), m);
+      }
+
+      return x;
+   }
+
+   RENFREW_TARGET_SSE2
+   int MaxColumnsSse2(const std::uint8_t *source, std::uint8_t *destination, int width) {
+      int x = 1;
+
+      for (; x + 16 <= width - 1; x += 16) {
+         auto m = _mm_max_epu8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + x - 1)),
+            _mm_max_epu8(
+               _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + x)),
+               _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + x + 1))
+            )
+         );
+
+         _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + x), m);
+      }
+
+      return x;
+   }
+
+   RENFREW_TARGET_AVX2
+   int MaxRowsAvx2(const std::uint8_t *a, const std::uint8_t *b, const std::uint8_t *c,
+                   std::uint8_t *destination, int width) {
+      int x = 0;
+
+      for (; x + 32 <= width; x += 32) {
+         auto m = _mm256_max_epu8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + x)),
+            _mm256_max_epu8(
+               _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + x)),
+               _mm256_loadu_si256(reinterpret_cast<const __m256i *>(c + x))
+            )
+         );
+
+         _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + x), m);
+      }
+
+      return x;
+   }
+
+   RENFREW_TARGET_AVX2
+   int MaxColumnsAvx2(const std::uint8_t *source, std::uint8_t *destination, int width) {
+      int x = 1;
+
+      for (; x + 32 <= width - 1; x += 32) {
+         auto m = _mm256_max_epu8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + x - 1)),
+            _mm256_max_epu8(
+               _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + x)),
+               _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + x + 1))
+            )
+         );
+
+         _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + x), m);
+      }
+
+      return x;
+   }
+
+#endif
+
+   std::int32_t Find(std::vector<std::int32_t> &parents, std::int32_t label) {
+      while (parents[label] != label) {
+         // Halve the path on the way up
+         parents[label] = parents[parents[label]];
+         label = parents[label];
+      }
+
+      return label;
+   }
+
+   std::int32_t Union(std::vector<std::int32_t> &parents, std::int32_t a, std::int32_t b) {
+      a = Find(parents, a);
+      b = Find(parents, b);
+
+      if (a < b) {
+         parents[b] = a;
+         return a;
+      }
+
+      parents[a] = b;
+      return b;
+   }
+
+   bool Contains(const Target &outer, const Target &inner) {
+      return inner.Left >= outer.Left && inner.Top >= outer.Top &&
+             inner.Left + inner.Width <= outer.Left + outer.Width &&
+             inner.Top + inner.Height <= outer.Top + outer.Height;
+   }
+}
+
+TargetDetector::TargetDetector(const TargetOptions &options)
+   : TargetDetector(options, DetectSimdLevel()) {
+
+}
+
+TargetDetector::TargetDetector(const TargetOptions &options, SimdLevel path) {
+   _options = options;
+   _options.EdgeThreshold = std::min(std::max(_options.EdgeThreshold, 0), 254);
+   _options.MinimumSize = std::max(_options.MinimumSize, 1);
+
+   _path = std::min(path, DetectSimdLevel());
+}
+
+SimdLevel TargetDetector::Path() const {
+   return _path;
+}
+
+void TargetDetector::Detect(const ConstImageView &image, std::vector<Target> &targets) {
+   targets.clear();
+
+   if (image.Width < 3 || image.Height < 3)
+      return;
+
+   Grey(image, _grey);
+   Edges(_grey, image.Width, image.Height, _edges);
+   Thicken(_edges, image.Width, image.Height, _thick);
+
+   std::vector<Target> components;
+   Components(_thick, image.Width, image.Height, components);
+
+   auto maximumWidth = static_cast<int>(image.Width * _options.MaximumShare);
+   auto maximumHeight = static_cast<int>(image.Height * _options.MaximumShare);
+
+   // Finding the edges, then thickening them, each grow a component by a pixel
+   // all round. That isn't held against it here, or a text box that's most of
+   // the image wide would be taken for a panel.
+   const int grown = 4;
+
+   components.erase(
+      std::remove_if(components.begin(), components.end(), [&](const Target &t) {
+         return t.Width < _options.MinimumSize || t.Height < _options.MinimumSize ||
+                t.Width - grown > maximumWidth || t.Height - grown > maximumHeight;
+      }),
+      components.end()
+   );
+
+   // Biggest first, so that anything inside a target (e.g. a button's label) is
+   // dropped in favour of it.
+   std::stable_sort(components.begin(), components.end(), [](const Target &a, const Target &b) {
+      return a.Width * a.Height > b.Width * b.Height;
+   });
+
+   for (auto &component : components) {
+      if (static_cast<int>(targets.size()) >= _options.MaximumTargets)
+         break;
+
+      bool inside = std::any_of(targets.begin(), targets.end(), [&](const Target &t) {
+         return Contains(t, component);
+      });
+
+      if (inside == false)
+         targets.push_back(component);
+   }
+
+   std::sort(targets.begin(), targets.end(), [](const Target &a, const Target &b) {
+      return a.Top != b.Top ? a.Top < b.Top : a.Left < b.Left;
+   });
+}
+
+void TargetDetector::Grey(const ConstImageView &image, std::vector<std::uint8_t> &grey) const {
+   grey.resize(static_cast<std::size_t>(image.Width) * image.Height);
+
+   for (int y = 0; y < image.Height; y++) {
+      auto source = image.Pixels + static_cast<std::ptrdiff_t>(y) * image.Stride;
+      auto destination = grey.data() + static_cast<std::ptrdiff_t>(y) * image.Width;
+
+      int done = 0;
+
+      switch (_path) {
+#if defined(RENFREW_X86)
+         case SimdLevel::Avx2:
+            done = GreyAvx2(source, destination, image.Width);
+            break;
+         case SimdLevel::Sse2:
+            done = GreySse2(source, destination, image.Width);
+            break;
+#endif
+         default:
+            break;
+      }
+
+      GreyScalar(source, destination, done, image.Width);
+   }
+}
+
+void TargetDetector::Edges(const std::vector<std::uint8_t> &grey, int width, int height,
+                           std::vector<std::uint8_t> &edges) const {
+   edges.assign(static_cast<std::size_t>(width) * height, 0);
+
+   for (int y = 1; y < height - 1; y++) {
+      auto b = grey.data() + static_cast<std::ptrdiff_t>(y) * width;
+      auto a = b - width;
+      auto c = b + width;
+      auto destination = edges.data() + static_cast<std::ptrdiff_t>(y) * width;
+
+      int done = 1;
+
+      switch (_path) {
+#if defined(RENFREW_X86)
+         case SimdLevel::Avx2:
+            done = EdgesAvx2(a, b, c, destination, width, _options.EdgeThreshold);
+            break;
+         case SimdLevel::Sse2:
+            done = EdgesSse2(a, b, c, destination, width, _options.EdgeThreshold);
+            break;
+#endif
+         default:
+            break;
+      }
+
+      EdgesScalar(a, b, c, destination, done, width - 1, _options.EdgeThreshold);
+   }
+}
+
+void TargetDetector::Thicken(const std::vector<std::uint8_t> &edges, int width, int height,
+                             std::vector<std::uint8_t> &thick) {
+   _rows.resize(static_cast<std::size_t>(width));
+   thick.resize(static_cast<std::size_t>(width) * height);
+
+   for (int y = 0; y < height; y++) {
+      auto b = edges.data() + static_cast<std::ptrdiff_t>(y) * width;
+      auto a = y > 0 ? b - width : b;
+      auto c = y < height - 1 ? b + width : b;
+      auto rows = _rows.data();
+      auto destination = thick.data() + static_cast<std::ptrdiff_t>(y) * width;
+
+      // Down the columns first, then along the row
+      int done = 0;
+
+      switch (_path) {
+#if defined(RENFREW_X86)
+         case SimdLevel::Avx2:
+            done = MaxRowsAvx2(a, b, c, rows, width);
+            break;
+         case SimdLevel::Sse2:
+            done = MaxRowsSse2(a, b, c, rows, width);
+            break;
+#endif
+         default:
+            break;
+      }
+
+      for (int x = done; x < width; x++)
+         rows[x] = Max3(a[x], b[x], c[x]);
+
+      done = 1;
+
+      switch (_path) {
+#if defined(RENFREW_X86)
+         case SimdLevel::Avx2:
+            done = MaxColumnsAvx2(rows, destination, width);
+            break;
+         case SimdLevel::Sse2:
+            done = MaxColumnsSse2(rows, destination, width);
+            break;
+#endif
+         default:
+            break;
+      }
+
+      for (int x = done; x < width - 1; x++)
+         destination[x] = Max3(rows[x - 1], rows[x], rows[x + 1]);
+
+      destination[0] = width > 1 ? std::max(rows[0], rows[1]) : rows[0];
+
+      if (width > 1)
+         destination[width - 1] = std::max(rows[width - 2], rows[width - 1]);
+   }
+}
+
+void TargetDetector::Components(const std::vector<std::uint8_t> &edges, int width, int height,
+                                std::vector<Target> &components) {
+   components.clear();
+
+   _labels.assign(static_cast<std::size_t>(width) * height, 0);
+
+   // Label 0 is the background
+   _parents.assign(1, 0);
+
+   // First pass: give each pixel the smallest label of the neighbours already seen
+   // (left, and the three above), and note which labels meet.
+   for (int y = 0; y < height; y++) {
+      auto row = edges.data() + static_cast<std::ptrdiff_t>(y) * width;
+      auto labels = _labels.data() + static_cast<std::ptrdiff_t>(y) * width;
+      auto above = labels - width;
+
+      for (int x = 0; x < width; x++) {
+         if (row[x] == 0)
+            continue;
+
+         std::int32_t neighbours[4] = {
+            x > 0 ? labels[x - 1] : 0,
+            y > 0 && x > 0 ? above[x - 1] : 0,
+            y > 0 ? above[x] : 0,
+            y > 0 && x < width - 1 ? above[x + 1] : 0
+         };
+
+         std::int32_t label = 0;
+
+         for (auto neighbour : neighbours) {
+            if (neighbour == 0)
+               continue;
+
+            label = label == 0 ? Find(_parents, neighbour) : Union(_parents, label, neighbour);
+         }
+
+         if (label == 0) {
+            label = static_cast<std::int32_t>(_parents.size());
+            _parents.push_back(label);
+         }
+
+         labels[x] = label;
+      }
+   }
+
+   // Second pass: grow the bounds of each group
+   std::vector<std::int32_t> index(_parents.size(), -1);
+   std::vector<int> right, bottom;
+
+   for (int y = 0; y < height; y++) {
+      auto labels = _labels.data() + static_cast<std::ptrdiff_t>(y) * width;
+
+      for (int x = 0; x < width; x++) {
+         if (labels[x] == 0)
+            continue;
+
+         auto root = Find(_parents, labels[x]);
+
+         if (index[root] < 0) {
+            index[root] = static_cast<std::int32_t>(components.size());
+            components.push_back(Target { x, y, 0, 0 });
+            right.push_back(x);
+            bottom.push_back(y);
+         }
+
+         auto i = index[root];
+         auto &c = components[i];
+
+         c.Left = std::min(c.Left, x);
+         right[i] = std::max(right[i], x);
+         bottom[i] = std::max(bottom[i], y);
+      }
+   }
+
+   for (std::size_t i = 0; i < components.size(); i++) {
+      components[i].Width = right[i] - components[i].Left + 1;
+      components[i].Height = bottom[i] - components[i].Top + 1;
+   }
+}
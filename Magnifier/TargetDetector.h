@@ -0,0 +1,122 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "CpuFeatures.h"
+#include "ImageScaler.h"
+
+// Plain C++ (no Windows or CLR dependencies), so that it can be built and
+// tested on its own.
+
+namespace Renfrew::Utility {
+
+   /// <summary>
+   /// Something in an image that looks like it can be clicked (a button, a check
+   /// box, a text box, a word), in image pixels.
+   /// </summary>
+   struct Target {
+      int Left;
+      int Top;
+      int Width;
+      int Height;
+
+      int CentreX() const { return Left + Width / 2; }
+      int CentreY() const { return Top + Height / 2; }
+   };
+
+   struct TargetOptions {
+      // Edges are where |Gx| + |Gy| (Sobel, saturated at 255) is above this
+      int EdgeThreshold = 64;
+
+      // Targets smaller than this (either way) are ignored as noise
+      int MinimumSize = 6;
+
+      // Targets bigger than this share of the image (either way) are ignored, as
+      // they're probably panels or the edges of windows
+      double MaximumShare = 0.9;
+
+      int MaximumTargets = 9;
+   };
+
+   /// <summary>
+   /// Finds likely click targets in an image: it's converted to grey, its edges are
+   /// found (Sobel), thickened a pixel so that the letters of a word run together,
+   /// and split into connected groups. The groups of a sensible size that aren't
+   /// inside another one are the targets.
+   ///
+   /// The per-pixel stages have SSE2 and AVX2 versions (picked at run time) that
+   /// give exactly the same results as the scalar ones. The buffers are kept, so an
+   /// instance should be reused (by one thread).
+   /// </summary>
+   class TargetDetector {
+      private: SimdLevel _path;
+      private: TargetOptions _options;
+
+      private: std::vector<std::uint8_t> _grey;
+      private: std::vector<std::uint8_t> _edges;
+      private: std::vector<std::uint8_t> _thick;
+      private: std::vector<std::uint8_t> _rows;
+      private: std::vector<std::int32_t> _labels;
+      private: std::vector<std::int32_t> _parents;
+
+      public: TargetDetector(const TargetOptions &options = TargetOptions());
+
+      /// <summary>
+      /// Uses the given path, or the best one below it if the processor doesn't
+      /// support it.
+      /// </summary>
+      public: TargetDetector(const TargetOptions &options, SimdLevel path);
+
+      public: SimdLevel Path() const;
+
+      /// <summary>
+      /// Finds the targets, sorted top to bottom, then left to right.
+      /// </summary>
+      public: void Detect(const ConstImageView &image, std::vector<Target> &targets);
+
+      // The stages, exposed so that they can be checked (and timed) on their own.
+      // Buffers are one byte per pixel, with a stride of the image's width.
+
+      /// <summary>
+      /// Luma (BT.601, 8-bit fixed point) of each pixel.
+      /// </summary>
+      public: void Grey(const ConstImageView &image, std::vector<std::uint8_t> &grey) const;
+
+      /// <summary>
+      /// 255 where the Sobel gradient is above the threshold, otherwise 0. The
+      /// pixels around the edge of the image are always 0.
+      /// </summary>
+      public: void Edges(const std::vector<std::uint8_t> &grey, int width, int height,
+                         std::vector<std::uint8_t> &edges) const;
+
+      /// <summary>
+      /// Grows the edges by a pixel each way (the maximum of each 3 x 3 block).
+      /// </summary>
+      public: void Thicken(const std::vector<std::uint8_t> &edges, int width, int height,
+                           std::vector<std::uint8_t> &thick);
+
+      /// <summary>
+      /// The bounds of every group of touching (8-way) edge pixels.
+      /// </summary>
+      public: void Components(const std::vector<std::uint8_t> &edges, int width, int height,
+                              std::vector<Target> &components);
+   };
+}
@@ -0,0 +1,124 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include "stdafx.h"
+
+#using "WindowsBase.dll"
+
+using namespace System;
+using namespace System::Diagnostics;
+using namespace System::Windows;
+
+#include "Magnifier.h"
+#include "MagnifierException.h"
+#include "ScreenCapture.h"
+#include "TargetDetector.h"
+#include "TargetFinder.h"
+
+#include <utility>
+#include <vector>
+
+using namespace Renfrew::Utility;
+
+TargetFinder::TargetFinder() {
+   // Only one frame is looked at at a time
+   _screen = new ScreenCapture(1);
+   _detector = new TargetDetector();
+
+   Debug::WriteLine("TargetFinder: Using the {0} path.", static_cast<int>(_detector->Path()));
+}
+
+TargetFinder::~TargetFinder() {
+   this->!TargetFinder();
+}
+
+TargetFinder::!TargetFinder() {
+   delete _screen;
+   delete _detector;
+
+   _screen = nullptr;
+   _detector = nullptr;
+}
+
+array<Int32Rect> ^TargetFinder::Find(Int32 x, Int32 y, Int32 width, Int32 height) {
+   if (_screen == nullptr)
+      throw gcnew ObjectDisposedException("TargetFinder");
+
+   if (width <= 0 || height <= 0)
+      return gcnew array<Int32Rect>(0);
+
+   // Our overlays are only left out of capture while the copy is made, so that
+   // they still show up when the screen is recorded or shared. The affinity they
+   // had is put back afterwards.
+   std::vector<std::pair<HWND, DWORD>> excluded;
+   bool canExclude = true;
+
+   for each (auto overlay in Magnifier::GetOverlays()) {
+      auto hwnd = static_cast<HWND>(overlay.ToPointer());
+      DWORD affinity = WDA_NONE;
+
+      // Closed, or left out already (by the software magnifier)
+      if (GetWindowDisplayAffinity(hwnd, &affinity) == FALSE || affinity == WDA_EXCLUDEFROMCAPTURE)
+         continue;
+
+      // Only Windows 10 2004 and up can leave windows out of capture
+      if (SetWindowDisplayAffinity(hwnd, WDA_EXCLUDEFROMCAPTURE) == FALSE) {
+         canExclude = false;
+         break;
+      }
+
+      excluded.emplace_back(hwnd, affinity);
+   }
+
+   RECT area = { x, y, x + width, y + height };
+   TileChanges changes;
+   FrameHandle frame;
+   DWORD error = ERROR_SUCCESS;
+
+   if (canExclude == true) {
+
+      // The windows are left out from the next frame the desktop composes
+      DwmFlush();
+
+      frame = _screen->Capture(area, changes);
+      error = GetLastError();
+   }
+
+   for (auto &window : excluded)
+      SetWindowDisplayAffinity(window.first, window.second);
+
+   // The grid's lines and labels would be taken for targets, so there are none
+   if (canExclude == false) {
+      Debug::WriteLine("TargetFinder: Overlays can't be left out of capture; not looking for targets.");
+      return gcnew array<Int32Rect>(0);
+   }
+
+   if (frame == nullptr)
+      throw gcnew MagnifierException("Failed to copy the screen.", error);
+
+   std::vector<Target> targets;
+   _detector->Detect(frame->ConstView(), targets);
+
+   auto result = gcnew array<Int32Rect>(static_cast<int>(targets.size()));
+
+   for (int i = 0; i < result->Length; i++) {
+      auto &t = targets[i];
+      result[i] = Int32Rect(x + t.Left, y + t.Top, t.Width, t.Height);
+   }
+
+   return result;
+}
@@ -0,0 +1,48 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+namespace Renfrew::Utility {
+
+   class ScreenCapture;
+   class TargetDetector;
+
+   /// <summary>
+   /// Finds likely click targets (buttons, check boxes, text boxes, words) in part
+   /// of the screen. Our own overlays are left out of the copy it looks at (just
+   /// while it's made), so the grid lines and labels aren't mistaken for targets.
+   /// Where they can't be left out (before Windows 10 2004), nothing is found.
+   /// </summary>
+   public ref class TargetFinder sealed {
+      private: ScreenCapture *_screen;
+      private: TargetDetector *_detector;
+
+      public: TargetFinder();
+      public: ~TargetFinder();
+      protected: !TargetFinder();
+
+      /// <summary>
+      /// Copies the given area of the screen (in pixels) and looks for targets in it.
+      /// </summary>
+      /// <returns>
+      /// The targets in screen pixels, sorted top to bottom, then left to right.
+      /// </returns>
+      public: array<System::Windows::Int32Rect> ^Find(System::Int32 x, System::Int32 y,
+                                                      System::Int32 width, System::Int32 height);
+   };
+}
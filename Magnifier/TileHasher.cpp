@@ -0,0 +1,309 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include "TileHasher.h"
+
+#include <algorithm>
+#include <cstddef>
+
+#if defined(RENFREW_X86)
+   #include <immintrin.h>
+#endif
+
+using namespace Renfrew::Utility;
+
+namespace {
+   // One lane per column of a (whole) tile. Having this many chains of
+   // multiplies going at once keeps the SIMD paths from waiting on each other.
+   const int lanes = 32;
+
+   const std::uint32_t lanePrime = 0x01000193;
+   const std::uint32_t laneBasis = 0x811C9DC5;
+
+   const std::uint64_t tilePrime = 0x00000100000001B3ULL;
+   const std::uint64_t tileBasis = 0xCBF29CE484222325ULL;
+
+   struct Tile {
+      const std::uint32_t *Pixels;
+      int Width;
+      int Height;
+      int Stride;
+   };
+
+   std::uint64_t Fold(const std::uint32_t *state) {
+      std::uint64_t hash = tileBasis;
+
+      for (int i = 0; i < lanes; i++)
+         hash = (hash ^ state[i]) * tilePrime;
+
+      return hash;
+   }
+
+   std::uint64_t HashScalar(const Tile &tile) {
+      std::uint32_t state[lanes];
+      std::fill_n(state, lanes, laneBasis);
+
+      for (int y = 0; y < tile.Height; y++) {
+         auto row = tile.Pixels + static_cast<std::ptrdiff_t>(y) * tile.Stride;
+
+         for (int x = 0; x < tile.Width; x++)
+            state[x % lanes] = (state[x % lanes] ^ row[x]) * lanePrime;
+      }
+
+      return Fold(state);
+   }
+
+#if defined(RENFREW_X86)
+
+   // SSE2 has no 32-bit multiply that keeps the low half, so it's made from two
+   // 32 x 32 -> 64-bit multiplies (of the even and odd lanes).
+   RENFREW_TARGET_SSE2
+   inline __m128i MultiplySse2(__m128i a, __m128i b) {
+      __m128i even = _mm_mul_epu32(a, b);
+      __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+
+      return _mm_unpacklo_epi32(
+         _mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+         _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0))
+      );
+   }
+
+   RENFREW_TARGET_SSE2
+   std::uint64_t HashSse2(const Tile &tile) {
+      const int vectors = lanes / 4;
+      const __m128i prime = _mm_set1_epi32(static_cast<int>(lanePrime));
+
+      __m128i state[vectors];
+
+      for (int i = 0; i < vectors; i++)
+         state[i] = _mm_set1_epi32(static_cast<int>(laneBasis));
+
+      for (int y = 0; y < tile.Height; y++) {
+         auto row = tile.Pixels + static_cast<std::ptrdiff_t>(y) * tile.Stride;
+
+         for (int x = 0; x < tile.Width; x += lanes) {
+            for (int i = 0; i < vectors; i++) {
+               __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + x + i * 4));
+               state[i] = MultiplySse2(_mm_xor_si128(state[i], pixels), prime);
+            }
+         }
+      }
+
+      alignas(16) std::uint32_t folded[lanes];
+
+      for (int i = 0; i < vectors; i++)
+         _mm_store_si128(reinterpret_cast<__m128i *>(folded + i * 4), state[i]);
+
+      return Fold(folded);
+   }
+
+   RENFREW_TARGET_AVX2
+   std::uint64_t HashAvx2(const Tile &tile) {
+      const int vectors = lanes / 8;
+      const __m256i prime = _mm256_set1_epi32(static_cast<int>(lanePrime));
+
+      __m256i state[vectors];
+
+      for (int i = 0; i < vectors; i++)
+         state[i] = _mm256_set1_epi32(static_cast<int>(laneBasis));
+
+      for (int y = 0; y < tile.Height; y++) {
+         auto row = tile.Pixels + static_cast<std::ptrdiff_t>(y) * tile.Stride;
+
+         for (int x = 0; x < tile.Width; x += lanes) {
+            for (int i = 0; i < vectors; i++) {
+               __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row + x + i * 8));
+               state[i] = _mm256_mullo_epi32(_mm256_xor_si256(state[i], pixels), prime);
+            }
+         }
+      }
+
+      alignas(32) std::uint32_t folded[lanes];
+
+      for (int i = 0; i < vectors; i++)
+         _mm256_store_si256(reinterpret_cast<__m256i *>(folded + i * 8), state[i]);
+
+      return Fold(folded);
+   }
+
+#endif
+}
+
+TileHasher::TileHasher(int tileSize)
+   : TileHasher(tileSize, DetectSimdLevel()) {
+
+}
+
+TileHasher::TileHasher(int tileSize, SimdLevel path) {
+   // Whole groups of lanes, so the SIMD paths only see ragged tiles at the edges
+   _tileSize = std::max(lanes, (tileSize + lanes - 1) / lanes * lanes);
+   _path = std::min(path, DetectSimdLevel());
+}
+
+int TileHasher::TileSize() const {
+   return _tileSize;
+}
+
+SimdLevel TileHasher::Path() const {
+   return _path;
+}
+
+int TileHasher::Columns(int width) const {
+   return (width + _tileSize - 1) / _tileSize;
+}
+
+int TileHasher::Rows(int height) const {
+   return (height + _tileSize - 1) / _tileSize;
+}
+
+void TileHasher::Hash(const ConstImageView &image, std::vector<std::uint64_t> &hashes) const {
+   int columns = Columns(image.Width);
+   int rows = Rows(image.Height);
+
+   hashes.resize(static_cast<std::size_t>(columns) * rows);
+
+   auto hash = hashes.begin();
+
+   for (int row = 0; row < rows; row++) {
+      for (int column = 0; column < columns; column++) {
+         int x = column * _tileSize;
+         int y = row * _tileSize;
+
+         Tile tile {
+            image.Pixels + static_cast<std::ptrdiff_t>(y) * image.Stride + x,
+            std::min(_tileSize, image.Width - x),
+            std::min(_tileSize, image.Height - y),
+            image.Stride
+         };
+
+         // Tiles that don't fill a whole number of lanes are left to the scalar path.
+         bool whole = tile.Width % lanes == 0;
+
+         switch (whole == true ? _path : SimdLevel::Scalar) {
+#if defined(RENFREW_X86)
+            case SimdLevel::Avx2:
+               *hash++ = HashAvx2(tile);
+               break;
+            case SimdLevel::Sse2:
+               *hash++ = HashSse2(tile);
+               break;
+#endif
+            default:
+               *hash++ = HashScalar(tile);
+               break;
+         }
+      }
+   }
+}
+
+TileChanges::TileChanges() {
+   Reset(TileHasher::DefaultTileSize, 0, 0, false);
+}
+
+bool TileChanges::Any() const {
+   return _all == true || _changed.empty() == false;
+}
+
+bool TileChanges::All() const {
+   return _all;
+}
+
+const std::vector<int> &TileChanges::Changed() const {
+   return _changed;
+}
+
+bool TileChanges::Intersects(int x, int y, int width, int height) const {
+   if (width <= 0 || height <= 0)
+      return false;
+
+   if (_all == true)
+      return true;
+
+   int left = std::max(0, x / _tileSize);
+   int top = std::max(0, y / _tileSize);
+   int right = (x + width - 1) / _tileSize;
+   int bottom = (y + height - 1) / _tileSize;
+
+   for (int tile : _changed) {
+      int column = tile % _columns;
+      int row = tile / _columns;
+
+      if (column >= left && column <= right && row >= top && row <= bottom)
+         return true;
+   }
+
+   return false;
+}
+
+void TileChanges::Reset(int tileSize, int columns, int rows, bool all) {
+   _tileSize = tileSize;
+   _columns = columns;
+   _rows = rows;
+   _all = all;
+   _changed.clear();
+}
+
+void TileChanges::Add(int tile) {
+   _changed.push_back(tile);
+}
+
+ChangeDetector::ChangeDetector(int tileSize)
+   : _hasher(tileSize) {
+
+   _width = 0;
+   _height = 0;
+}
+
+ChangeDetector::ChangeDetector(const TileHasher &hasher)
+   : _hasher(hasher) {
+
+   _width = 0;
+   _height = 0;
+}
+
+void ChangeDetector::Update(const ConstImageView &frame, TileChanges &changes) {
+   _hasher.Hash(frame, _current);
+
+   int columns = _hasher.Columns(frame.Width);
+   int rows = _hasher.Rows(frame.Height);
+
+   bool all = _previous.empty() == true || frame.Width != _width || frame.Height != _height;
+
+   changes.Reset(_hasher.TileSize(), columns, rows, all);
+
+   if (all == false)
+      Diff(_previous, _current, changes);
+
+   _previous.swap(_current);
+
+   _width = frame.Width;
+   _height = frame.Height;
+}
+
+void ChangeDetector::Reset() {
+   _previous.clear();
+}
+
+void ChangeDetector::Diff(const std::vector<std::uint64_t> &previous,
+                          const std::vector<std::uint64_t> &current, TileChanges &changes) {
+   auto count = std::min(previous.size(), current.size());
+
+   for (std::size_t i = 0; i < count; i++) {
+      if (previous[i] != current[i])
+         changes.Add(static_cast<int>(i));
+   }
+}
@@ -0,0 +1,130 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "CpuFeatures.h"
+#include "ImageScaler.h"
+
+// Plain C++ (no Windows or CLR dependencies), so that it can be built and
+// tested on its own.
+
+namespace Renfrew::Utility {
+
+   /// <summary>
+   /// Hashes an image in square tiles, so that frames can be compared a tile at a
+   /// time. Each tile is hashed in 32 interleaved lanes (one per column, modulo
+   /// 32), where every step is reversible; a tile that differs by a single pixel
+   /// therefore always gets a different hash. Every path gives the same hashes as
+   /// the scalar one. The tile size is rounded up to a multiple of 32.
+   /// </summary>
+   class TileHasher {
+      public: static constexpr int DefaultTileSize = 32;
+
+      private: SimdLevel _path;
+      private: int _tileSize;
+
+      public: TileHasher(int tileSize = DefaultTileSize);
+
+      /// <summary>
+      /// Uses the given path, or the best one below it if the processor doesn't
+      /// support it.
+      /// </summary>
+      public: TileHasher(int tileSize, SimdLevel path);
+
+      public: int TileSize() const;
+      public: SimdLevel Path() const;
+
+      public: int Columns(int width) const;
+      public: int Rows(int height) const;
+
+      /// <summary>
+      /// Hashes every tile, row by row. Tiles on the right and bottom edges may
+      /// be smaller than the others.
+      /// </summary>
+      public: void Hash(const ConstImageView &image, std::vector<std::uint64_t> &hashes) const;
+   };
+
+   /// <summary>
+   /// The tiles that changed between two frames.
+   /// </summary>
+   class TileChanges {
+      private: int _tileSize;
+      private: int _columns;
+      private: int _rows;
+      private: bool _all;
+      private: std::vector<int> _changed;
+
+      public: TileChanges();
+
+      /// <summary>
+      /// Whether anything changed at all.
+      /// </summary>
+      public: bool Any() const;
+
+      /// <summary>
+      /// Whether everything should be treated as changed (e.g. the first frame,
+      /// or the frame changed size).
+      /// </summary>
+      public: bool All() const;
+
+      /// <summary>
+      /// The changed tiles (as indices, row by row). Empty if <see cref="All"/>.
+      /// </summary>
+      public: const std::vector<int> &Changed() const;
+
+      /// <summary>
+      /// Whether anything changed inside a rectangle of the frame.
+      /// </summary>
+      public: bool Intersects(int x, int y, int width, int height) const;
+
+      public: void Reset(int tileSize, int columns, int rows, bool all);
+      public: void Add(int tile);
+   };
+
+   /// <summary>
+   /// Remembers the tile hashes of the previous frame, and works out which tiles
+   /// have changed since.
+   /// </summary>
+   class ChangeDetector {
+      private: TileHasher _hasher;
+      private: std::vector<std::uint64_t> _previous;
+      private: std::vector<std::uint64_t> _current;
+      private: int _width;
+      private: int _height;
+
+      public: ChangeDetector(int tileSize = TileHasher::DefaultTileSize);
+      public: ChangeDetector(const TileHasher &hasher);
+
+      public: void Update(const ConstImageView &frame, TileChanges &changes);
+
+      /// <summary>
+      /// Forgets the previous frame, so everything counts as changed next time
+      /// (e.g. when the frame shows a different part of the screen).
+      /// </summary>
+      public: void Reset();
+
+      /// <summary>
+      /// Compares two sets of hashes, adding the tiles that differ.
+      /// </summary>
+      public: static void Diff(const std::vector<std::uint64_t> &previous,
+                               const std::vector<std::uint64_t> &current, TileChanges &changes);
+   };
+}
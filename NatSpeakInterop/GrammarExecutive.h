@@ -17,34 +17,181 @@
 
 #pragma once
 
+#include "NativeGramCommon.h"
+#include "SrGramNotifySink.h"
+
 namespace Renfrew::NatSpeakInterop {
    private ref class GrammarExecutive {
       private: IGrammar ^_grammar;
-      private: ISrGramCommon ^_isrGramCommon;
+      private: GrammarPartition ^_partition;
+      private: Int32 _index;
+
+      private: Dragon::ComInterfaces::INativeSrGramCommon *_srGramCommon;
+      private: Dragon::ComInterfaces::INativeDgnSrGramCommon *_dgnSrGramCommon;
+
+      // The rule names, marshaled once for the engine
+      private: Dictionary<String^, IntPtr> ^_ruleNames;
+
+      private: Sinks::SrGramNotifySink *_notifySink;
+      private: GCHandle _handle;
 
-      public: GrammarExecutive(IGrammar ^grammar) {
+      private: HashSet<String^> ^_activeRules;
+
+      private: array<byte> ^_hash;
+
+      public: GrammarExecutive(IGrammar ^grammar, GrammarPartition ^partition, Int32 index) {
          if (grammar == nullptr)
             throw gcnew ArgumentNullException("grammar");
+         if (partition == nullptr)
+            throw gcnew ArgumentNullException("partition");
 
          _grammar = grammar;
+         _partition = partition;
+         _index = index;
+         _activeRules = gcnew HashSet<String^>();
+         _ruleNames = gcnew Dictionary<String^, IntPtr>(StringComparer::CurrentCultureIgnoreCase);
       }
 
+      /// <summary>
+      /// The names of the rules currently active in the engine for this grammar.
+      /// </summary>
+      public: property HashSet<String^> ^ActiveRules {
+         HashSet<String^> ^get() {
+            return _activeRules;
+         };
+      };
+
       public: property IGrammar ^Grammar {
          IGrammar ^get() {
             return _grammar;
          };
       };
 
-      public: property ISrGramCommon ^GramCommonInterface {
-         ISrGramCommon ^get() {
-            return _isrGramCommon;
+      /// <summary>
+      /// The part of the grammar loaded by this executive.
+      /// </summary>
+      public: property GrammarPartition ^Partition {
+         GrammarPartition ^get() {
+            return _partition;
+         };
+      };
+
+      public: property Int32 Index {
+         Int32 get() {
+            return _index;
+         };
+      };
+
+      public: property Dragon::ComInterfaces::INativeSrGramCommon *GramCommon {
+         Dragon::ComInterfaces::INativeSrGramCommon *get() {
+            return _srGramCommon;
+         }
+      };
+
+      public: property Dragon::ComInterfaces::INativeDgnSrGramCommon *DgnGramCommon {
+         Dragon::ComInterfaces::INativeDgnSrGramCommon *get() {
+            return _dgnSrGramCommon;
+         }
+      };
+
+      /// <summary>
+      /// The hash of the serialized grammar that was loaded.
+      /// </summary>
+      public: property array<byte> ^Hash {
+         array<byte> ^get() {
+            return _hash;
          }
 
-         void set(ISrGramCommon ^isrGramCommon) {
-            _isrGramCommon = isrGramCommon;
+         void set(array<byte> ^hash) {
+            _hash = hash;
          }
       };
 
+      /// <summary>
+      /// Creates the notify sink for this grammar. The sink passes the callback a
+      /// GCHandle to this executive, which stays allocated until the sink is released.
+      /// </summary>
+      public: Sinks::SrGramNotifySink *CreateNotifySink(Sinks::PhraseFinishCallback callback) {
+         ReleaseNotifySink();
+
+         _handle = GCHandle::Alloc(this);
+         _notifySink = new Sinks::SrGramNotifySink(callback, GCHandle::ToIntPtr(_handle).ToPointer());
+
+         return _notifySink;
+      }
+
+      public: void ReleaseNotifySink() {
+         if (_notifySink != nullptr) {
+            _notifySink->Detach();
+            _notifySink->Release();
+            _notifySink = nullptr;
+         }
+
+         if (_handle.IsAllocated == true)
+            _handle.Free();
+      }
+
+      /// <summary>
+      /// Takes (and AddRefs) the interfaces of the grammar loaded by the engine, and
+      /// marshals the partition's rule names for them.
+      /// </summary>
+      public: void AttachGrammar(LPUNKNOWN pUnknown) {
+         Dragon::ComInterfaces::INativeSrGramCommon *srGramCommon = nullptr;
+         Dragon::ComInterfaces::INativeDgnSrGramCommon *dgnSrGramCommon = nullptr;
+
+         ReleaseGrammar();
+
+         Marshal::ThrowExceptionForHR(pUnknown->QueryInterface(
+            __uuidof(Dragon::ComInterfaces::INativeSrGramCommon), (void **)&srGramCommon
+         ));
+
+         auto hr = pUnknown->QueryInterface(
+            __uuidof(Dragon::ComInterfaces::INativeDgnSrGramCommon), (void **)&dgnSrGramCommon
+         );
+
+         if (FAILED(hr)) {
+            srGramCommon->Release();
+            Marshal::ThrowExceptionForHR(hr);
+         }
+
+         _srGramCommon = srGramCommon;
+         _dgnSrGramCommon = dgnSrGramCommon;
+
+         for each (auto ruleName in _partition->RuleNames)
+            _ruleNames[ruleName] = Marshal::StringToHGlobalUni(ruleName);
+      }
+
+      /// <summary>
+      /// Gets the rule's name as a native string. It stays valid until the grammar is released.
+      /// </summary>
+      public: PCWSTR GetRuleName(String ^ruleName) {
+         IntPtr name;
+
+         if (_ruleNames->TryGetValue(ruleName, name) == false) {
+            name = Marshal::StringToHGlobalUni(ruleName);
+            _ruleNames->Add(ruleName, name);
+         }
+
+         return static_cast<PCWSTR>(name.ToPointer());
+      }
+
+      public: void ReleaseGrammar() {
+         if (_dgnSrGramCommon != nullptr) {
+            _dgnSrGramCommon->Release();
+            _dgnSrGramCommon = nullptr;
+         }
+
+         if (_srGramCommon != nullptr) {
+            _srGramCommon->Release();
+            _srGramCommon = nullptr;
+         }
+
+         for each (auto name in _ruleNames->Values)
+            Marshal::FreeHGlobal(name);
+
+         _ruleNames->Clear();
+      }
+
       public: int GetHashCode() override {
          return _grammar->GetHashCode();
       }
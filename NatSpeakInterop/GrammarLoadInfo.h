@@ -0,0 +1,80 @@
+// Project Renfrew
+// Copyright(C) 2019 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#pragma once
+
+namespace Renfrew::NatSpeakInterop {
+
+   /// <summary>
+   /// Describes how a grammar was last loaded into the engine.
+   /// </summary>
+   public ref class GrammarLoadInfo {
+
+      private: bool _isWarm;
+      private: TimeSpan _elapsed;
+      private: Int32 _size;
+      private: Int32 _partitions;
+
+      public: GrammarLoadInfo(bool isWarm, TimeSpan elapsed, Int32 size, Int32 partitions) {
+         _isWarm = isWarm;
+         _elapsed = elapsed;
+         _size = size;
+         _partitions = partitions;
+      }
+
+      /// <summary>
+      /// true if the grammar was restored from engine archives; false if
+      /// (any part of) it was compiled from its serialized definition.
+      /// </summary>
+      public: property bool IsWarm {
+         bool get() {
+            return _isWarm;
+         }
+      }
+
+      /// <summary>
+      /// How long the engine took to load the grammar.
+      /// </summary>
+      public: property TimeSpan Elapsed {
+         TimeSpan get() {
+            return _elapsed;
+         }
+      }
+
+      /// <summary>
+      /// The size (in bytes) of the data given to the engine.
+      /// </summary>
+      public: property Int32 Size {
+         Int32 get() {
+            return _size;
+         }
+      }
+
+      /// <summary>
+      /// The number of engine grammars the grammar was split into.
+      /// </summary>
+      public: property Int32 Partitions {
+         Int32 get() {
+            return _partitions;
+         }
+      }
+
+      public: String ^ToString() override {
+         return String::Format("{0} load, {1:0.0} ms, {2} bytes, {3} engine grammar(s)",
+            _isWarm ? "warm" : "cold", _elapsed.TotalMilliseconds, _size, _partitions);
+      }
+   };
+}
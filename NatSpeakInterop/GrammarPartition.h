@@ -0,0 +1,66 @@
+// Project Renfrew
+// Copyright(C) 2019 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#pragma once
+
+namespace Renfrew::NatSpeakInterop {
+
+   /// <summary>
+   /// A part of a grammar that is loaded into the engine as a grammar of its own.
+   /// </summary>
+   public ref class GrammarPartition {
+
+      private: HashSet<String^> ^_ruleNames;
+      private: array<byte> ^_bytes;
+      private: Int32 _wordCount;
+
+      public: GrammarPartition(IEnumerable<String^> ^ruleNames, array<byte> ^bytes, Int32 wordCount) {
+         if (ruleNames == nullptr)
+            throw gcnew ArgumentNullException("ruleNames");
+         if (bytes == nullptr)
+            throw gcnew ArgumentNullException("bytes");
+
+         _ruleNames = gcnew HashSet<String^>(ruleNames, StringComparer::CurrentCultureIgnoreCase);
+         _bytes = bytes;
+         _wordCount = wordCount;
+      }
+
+      /// <summary>
+      /// The serialized (SRGRMFMT_CFG) partition.
+      /// </summary>
+      public: property array<byte> ^Bytes {
+         array<byte> ^get() {
+            return _bytes;
+         }
+      }
+
+      public: property IEnumerable<String^> ^RuleNames {
+         IEnumerable<String^> ^get() {
+            return _ruleNames;
+         }
+      }
+
+      public: property Int32 WordCount {
+         Int32 get() {
+            return _wordCount;
+         }
+      }
+
+      public: bool ContainsRule(String ^ruleName) {
+         return _ruleNames->Contains(ruleName);
+      }
+   };
+}
@@ -25,6 +25,10 @@
 #include "InvalidStateException.h"
 #include "SrErrorCodes.h"
 
+using namespace System::Collections;
+using namespace System::IO;
+using namespace System::Security::Cryptography;
+
 using namespace Renfrew::NatSpeakInterop;
 using namespace Renfrew::NatSpeakInterop::Dragon;
 using namespace Renfrew::NatSpeakInterop::Dragon::ComInterfaces;
@@ -44,8 +48,15 @@ GrammarService::GrammarService(ISrCentral ^isrCentral,
    _isrCentral = isrCentral;
    _idgnSrEngineControl = idgnSrEngineControl;
 
-   _grammars = gcnew Dictionary<IGrammar^, GrammarExecutive^>();
-   _activeRules = gcnew HashSet<String^>();
+   _grammars = gcnew Dictionary<IGrammar^, List<GrammarExecutive^>^>();
+   _loadInfo = gcnew Dictionary<IGrammar^, GrammarLoadInfo^>();
+
+   _phraseFinishHandler = gcnew PhraseFinishHandler(this, &GrammarService::PhraseFinished);
+   _phraseFinishCallback = reinterpret_cast<PhraseFinishCallback>(
+      Marshal::GetFunctionPointerForDelegate(_phraseFinishHandler).ToPointer()
+   );
+
+   ReadEngineLimits();
 }
 
 GrammarService::~GrammarService() {
@@ -58,8 +69,6 @@ GrammarService::~GrammarService() {
 }
 
 void GrammarService::ActivateRule(IGrammar ^grammar, HWND hWnd, String ^ruleName) {
-   pin_ptr<const WCHAR> wstrRuleName = PtrToStringChars(ruleName);
-
    if (_grammars->ContainsKey(grammar) == false)
       throw gcnew GrammarNotLoadedException("FILL ME IN");
 
@@ -67,25 +76,23 @@ void GrammarService::ActivateRule(IGrammar ^grammar, HWND hWnd, String ^ruleName
    if (hWnd != nullptr && IsWindow(hWnd) == false)
       return; // TODO: Throw exception?
 
-   auto ge = _grammars[grammar];
-
-   // TODO: Check that the grammar actually has the matching rule name!
+   auto ge = GetGrammarExecutive(grammar, ruleName);
 
+   // Rules are only activated once, so the engine never reports one as
+   // already active
    try {
-      if (_activeRules->Contains(ruleName) == false) {
-         ge->GramCommonInterface->Activate(
+      if (ge->ActiveRules->Contains(ruleName) == false) {
+         Marshal::ThrowExceptionForHR(ge->GramCommon->Activate(
             hWnd, // TODO: Set to hWnd (where applicable)
-            false, wstrRuleName
-         );
-         _activeRules->Add(ruleName);
+            FALSE, ge->GetRuleName(ruleName)
+         ));
+         ge->ActiveRules->Add(ruleName);
       }
    } catch (COMException ^e) {
       if (e->HResult == SrErrorCodes::SRERR_INVALIDRULE)
          throw gcnew GrammarException(String::Format("Invalid Rule: {0}!", ruleName), e);
       if (e->HResult == SrErrorCodes::SRERR_GRAMMARTOOCOMPLEX)
          throw gcnew GrammarException("Grammar too complex!", e);
-      if (e->HResult == SrErrorCodes::SRERR_RULEALREADYACTIVE)
-         throw gcnew GrammarException(String::Format("Rule Already Active: {0}!", ruleName), e);
       throw gcnew GrammarException("Unexpected Grammar Error!", e);
    }
 }
@@ -98,42 +105,88 @@ void GrammarService::ActivateRules(IGrammar ^grammar) {
    throw gcnew NotImplementedException();
 }
 
-GrammarExecutive ^GrammarService::AddGrammarToList(IGrammar ^grammar) {
-   GrammarExecutive ^ge;
+String ^GrammarService::ArchiveDirectory::get() {
+   return _archiveDirectory;
+}
+
+void GrammarService::ArchiveDirectory::set(String ^archiveDirectory) {
+   _archiveDirectory = archiveDirectory;
+}
+
+List<GrammarExecutive^> ^GrammarService::AddGrammarToList(IGrammar ^grammar) {
 
    // Make sure the grammar's not already loaded
    if (_grammars->ContainsKey(grammar) == true)
       throw gcnew GrammarAlreadyLoadedException("FILL ME IN");
 
-   ge = gcnew GrammarExecutive(grammar);
+   auto executives = gcnew List<GrammarExecutive^>();
 
-   _grammars->Add(grammar, ge);
+   _grammars->Add(grammar, executives);
 
-   return ge;
+   return executives;
 }
 
-void GrammarService::DeactivateRule(IGrammar ^grammar, String ^ruleName) {
-   pin_ptr<const WCHAR> wstrRuleName = PtrToStringChars(ruleName);
+array<byte> ^GrammarService::ComputeHash(array<byte> ^grammarBytes) {
+   auto sha = SHA256::Create();
 
-   auto ge = GetGrammarExecutive(grammar);
+   try {
+      return sha->ComputeHash(grammarBytes);
+   } finally {
+      delete sha;
+   }
+}
 
-   // TODO: Check that the grammar actually has the matching rule name!
+void GrammarService::DeactivateRule(IGrammar ^grammar, String ^ruleName) {
+   auto ge = GetGrammarExecutive(grammar, ruleName);
 
+   // Likewise, only active rules are deactivated
    try {
-      if (_activeRules->Contains(ruleName) == true) {
-         ge->GramCommonInterface->Deactivate(
-            wstrRuleName
-         );
-         _activeRules->Remove(ruleName);
+      if (ge->ActiveRules->Contains(ruleName) == true) {
+         Marshal::ThrowExceptionForHR(ge->GramCommon->Deactivate(
+            ge->GetRuleName(ruleName)
+         ));
+         ge->ActiveRules->Remove(ruleName);
       }
    } catch (COMException ^e) {
-      if (e->HResult == SrErrorCodes::SRERR_RULENOTACTIVE)
-         throw gcnew GrammarException(String::Format("Rule Is Not Active: {0}!", ruleName), e);
       throw gcnew GrammarException("Unexpected Grammar Error!", e);
    }
 }
 
-GrammarExecutive ^GrammarService::GetGrammarExecutive(IGrammar ^grammar) {
+LPUNKNOWN GrammarService::EngineGrammarLoad(SRGRMFMT format, array<byte> ^grammarBytes,
+                                            IntPtr notifySinkPtr) {
+   LPUNKNOWN pUnknown;
+
+   // Pinning any sub-element of a managed array pins the entire array
+   pin_ptr<byte> bytes = &grammarBytes[0];
+
+   SDATA data;
+   data.dwSize = grammarBytes->Length;
+   data.pData = bytes;
+
+   _isrCentral->GrammarLoad(
+      format, data, notifySinkPtr, __uuidof(ISrGramNotifySink^), &pUnknown
+   );
+
+   return pUnknown;
+}
+
+String ^GrammarService::GetArchivePath(GrammarExecutive ^ge) {
+   if (_archiveDirectory == nullptr)
+      return nullptr;
+
+   auto fileName = ge->Grammar->ToString();
+
+   for each (auto c in Path::GetInvalidFileNameChars())
+      fileName = fileName->Replace(c, '_');
+
+   // Partitioned grammars get one archive per partition
+   if (ge->Index > 0)
+      fileName += "." + ge->Index;
+
+   return Path::Combine(_archiveDirectory, fileName + ".archive");
+}
+
+List<GrammarExecutive^> ^GrammarService::GetGrammarExecutives(IGrammar ^grammar) {
    if (grammar == nullptr)
       throw gcnew ArgumentNullException("grammar");
 
@@ -144,6 +197,29 @@ GrammarExecutive ^GrammarService::GetGrammarExecutive(IGrammar ^grammar) {
    return _grammars[grammar];
 }
 
+GrammarExecutive ^GrammarService::GetGrammarExecutive(IGrammar ^grammar, String ^ruleName) {
+
+   // Find the partition that the rule was loaded with
+   for each (auto ge in GetGrammarExecutives(grammar)) {
+      if (ge->Partition->ContainsRule(ruleName) == true)
+         return ge;
+   }
+
+   throw gcnew GrammarException(String::Format("Invalid Rule: {0}!", ruleName), (Exception^)nullptr);
+}
+
+GrammarLoadInfo ^GrammarService::GetLoadInfo(IGrammar ^grammar) {
+   if (grammar == nullptr)
+      throw gcnew ArgumentNullException("grammar");
+
+   GrammarLoadInfo ^loadInfo;
+
+   if (_loadInfo->TryGetValue(grammar, loadInfo) == false)
+      return nullptr;
+
+   return loadInfo;
+}
+
 void GrammarService::GrammarSerializer::set(IGrammarSerializer ^grammarSerializer) {
    if (grammarSerializer == nullptr)
       throw gcnew ArgumentNullException("grammarSerializer");
@@ -153,56 +229,133 @@ void GrammarService::GrammarSerializer::set(IGrammarSerializer ^grammarSerialize
 
 void GrammarService::LoadGrammar(IGrammar ^grammar) {
 
-   ISrGramNotifySink ^isrGramNotifySink;
-   IntPtr iSrGramNotifySinkPtr;
-
-   LPUNKNOWN pUnknown;
-   array<byte> ^grammarBytes;
-
    if (grammar == nullptr)
       throw gcnew ArgumentNullException("grammar");
 
    if (_grammarSerializer == nullptr)
       throw gcnew InvalidStateException("GrammarSerializer hasn't been set!");
 
-   auto ge = AddGrammarToList(grammar);
+   // Split the grammar up if it's too big for the engine to take in one piece.
+   auto partitions = _grammarSerializer->Partition(grammar, _maxWords);
 
-   grammarBytes = _grammarSerializer->Serialize(grammar);
+   auto executives = AddGrammarToList(grammar);
 
-   // Pinning any sub-element of a managed array pins the entire array
-   pin_ptr<byte> bytes = &grammarBytes[0];
+   if (_maxGrammars != 0) {
+      auto loaded = 0;
 
-   SDATA data;
-   data.dwSize = grammarBytes->Length;
-   data.pData = bytes;
+      for each (auto list in _grammars->Values)
+         loaded += list->Count;
 
-   isrGramNotifySink = gcnew SrGramNotifySink(
-      gcnew Action<UInt32, Object^, ISrResBasic^>(this, &GrammarService::PhraseFinishedCallback), ge
-   );
+      if (loaded + partitions->Count > (Int32)_maxGrammars) {
+         Debug::WriteLine(
+            "GrammarService: Loading {0} exceeds the engine's limit of {1} grammars.",
+            grammar, _maxGrammars
+         );
+      }
+   }
 
-   iSrGramNotifySinkPtr = Marshal::GetIUnknownForObject(isrGramNotifySink);
+   auto isWarm = true;
+   auto elapsed = TimeSpan::Zero;
+   auto size = 0;
 
    try {
-      _isrCentral->GrammarLoad(
-         SRGRMFMT_CFG, data, iSrGramNotifySinkPtr, __uuidof(ISrGramNotifySink^), &pUnknown
-      );
-   } catch (COMException ^e) {
-      if (e->HResult == SrErrorCodes::SRERR_INVALIDCHAR)
-         throw gcnew GrammarException("Invalid Word/Character in Grammar", e);
-      if (e->HResult == SrErrorCodes::SRERR_GRAMMARERROR)
-         throw gcnew GrammarException("Grammar Error", e);
-      throw gcnew GrammarException("Unexpected Grammar Error!", e);
+      for (auto i = 0; i < partitions->Count; i++) {
+         auto ge = gcnew GrammarExecutive(grammar, partitions[i], i);
+
+         auto loadInfo = LoadPartition(ge);
+
+         executives->Add(ge);
+
+         isWarm = isWarm && loadInfo->IsWarm;
+         elapsed = elapsed.Add(loadInfo->Elapsed);
+         size += loadInfo->Size;
+      }
+   } catch (Exception^) {
+
+      // Don't leave the grammar half loaded
+      for each (auto ge in RemoveGrammarFromList(grammar))
+         ReleasePartition(ge);
+
+      throw;
    }
 
-   ISrGramCommon ^isrGramCommon = (ISrGramCommon^)
-      Marshal::GetTypedObjectForIUnknown(IntPtr(pUnknown), ISrGramCommon::typeid);
+   auto loadInfo = gcnew GrammarLoadInfo(isWarm, elapsed, size, partitions->Count);
+
+   _loadInfo[grammar] = loadInfo;
+
+   Debug::WriteLine("GrammarService: Loaded " + grammar + " (" + loadInfo + ").");
+}
+
+GrammarLoadInfo ^GrammarService::LoadPartition(GrammarExecutive ^ge) {
+
+   IntPtr iSrGramNotifySinkPtr;
+
+   LPUNKNOWN pUnknown = nullptr;
+   array<byte> ^grammarBytes;
+   array<byte> ^archiveBytes;
+
+   grammarBytes = ge->Partition->Bytes;
+   ge->Hash = ComputeHash(grammarBytes);
+
+   // Prefer the engine's own archive of the grammar, if the grammar hasn't changed since.
+   archiveBytes = ReadArchive(ge);
 
-   pUnknown->Release();
-   Marshal::Release(iSrGramNotifySinkPtr);
+   // The executive keeps its reference to the sink until the grammar is released
+   iSrGramNotifySinkPtr = IntPtr(
+      static_cast<INativeSrGramNotifySink *>(ge->CreateNotifySink(_phraseFinishCallback))
+   );
 
-   // Store isrGramCommon with our grammar
-   ge->GramCommonInterface = isrGramCommon;
+   auto stopwatch = Stopwatch::StartNew();
 
+   try {
+      if (archiveBytes != nullptr) {
+         try {
+            pUnknown = EngineGrammarLoad(SRGRMFMT_CFGNATIVE, archiveBytes, iSrGramNotifySinkPtr);
+         } catch (COMException ^e) {
+            Debug::WriteLine(
+               "GrammarService: Could not restore {0} from its archive ({1:x8}). Compiling it instead.",
+               ge->Grammar, e->HResult
+            );
+         }
+      }
+
+      if (pUnknown == nullptr) {
+         try {
+            pUnknown = EngineGrammarLoad(SRGRMFMT_CFG, grammarBytes, iSrGramNotifySinkPtr);
+         } catch (COMException ^e) {
+            if (e->HResult == SrErrorCodes::SRERR_INVALIDCHAR)
+               throw gcnew GrammarException("Invalid Word/Character in Grammar", e);
+            if (e->HResult == SrErrorCodes::SRERR_GRAMMARERROR)
+               throw gcnew GrammarException("Grammar Error", e);
+            if (e->HResult == SrErrorCodes::SRERR_GRAMMARTOOCOMPLEX)
+               throw gcnew GrammarException("Grammar too complex!", e);
+            throw gcnew GrammarException("Unexpected Grammar Error!", e);
+         }
+
+         archiveBytes = nullptr;
+      }
+   } catch (Exception^) {
+      ge->ReleaseNotifySink();
+      throw;
+   }
+
+   auto elapsed = stopwatch->Elapsed;
+
+   // Keep the grammar's interfaces with our grammar, resolved once, so that
+   // (de)activating its rules doesn't go through an RCW
+   try {
+      ge->AttachGrammar(pUnknown);
+   } catch (Exception^) {
+      ge->ReleaseNotifySink();
+      throw;
+   } finally {
+      pUnknown->Release();
+   }
+
+   return gcnew GrammarLoadInfo(
+      archiveBytes != nullptr, elapsed,
+      archiveBytes != nullptr ? archiveBytes->Length : grammarBytes->Length, 1
+   );
 }
 
 void GrammarService::PausedProcessor(UInt64 cookie) {
@@ -214,29 +367,44 @@ void GrammarService::PausedProcessor(UInt64 cookie) {
    _idgnSrEngineControl->Resume(cookie);
 }
 
-void GrammarService::PhraseFinishedCallback(UInt32 flags, Object ^grammarObj, ISrResBasic^ isrResBasic) {
-   Debug::WriteLine(__FUNCTION__);
+void GrammarService::PhraseFinished(IntPtr context, IntPtr result) {
 
-   auto ge = (GrammarExecutive^)grammarObj;
+   // Called from the (native) notify sink, which can't take an exception
+   try {
+      auto phraseResult = static_cast<const PhraseResult *>(result.ToPointer());
+      auto ge = (GrammarExecutive^)GCHandle::FromIntPtr(context).Target;
 
-   if (ge == nullptr)
-      throw gcnew InvalidStateException("grammarObj is unexpectedly NULL!");
+      if (ge == nullptr)
+         throw gcnew InvalidStateException("Grammar executive is unexpectedly NULL!");
 
-   //
-   // Test Processing The Results
-   //
+      List<String^> ^spokenWords;
 
-   /* MOVE BELOW BasePathWord
-   *if ((flags & ISRNOTEFIN_RECOGNIZED) == 0) {
-   Debug::WriteLine("Rejected");
-   return;
-   }
+      if (phraseResult->HasPhrase == true) {
+         spokenWords = gcnew List<String^>((Int32)phraseResult->WordCount);
+
+         for (DWORD i = 0; i < phraseResult->WordCount; i++)
+            spokenWords->Add(gcnew String(phraseResult->Words[i]));
+      } else {
 
-   if ((flags & ISRNOTEFIN_THISGRAMMAR) == 0) {
-   Debug::WriteLine("Other");
-   return;
-   }*/
+         // The engine didn't send the phrase, so read it from the results object
+         auto isrResBasic = (ISrResBasic^)Marshal::GetObjectForIUnknown(IntPtr(phraseResult->Results));
+
+         try {
+            spokenWords = GetBestPathWords(isrResBasic);
+         } finally {
+            Marshal::ReleaseComObject(isrResBasic);
+         }
+      }
 
+      // Evaluate the list of spoken words against the
+      // list of available rules in the grammar.
+      ge->Grammar->InvokeRule(spokenWords);
+   } catch (Exception ^e) {
+      Debug::WriteLine("GrammarService: Could not handle a phrase: " + e);
+   }
+}
+
+List<String^> ^GrammarService::GetBestPathWords(ISrResBasic ^isrResBasic) {
    auto isrResGraph = (ISrResGraph^)isrResBasic;
 
    DWORD pathSize = 0;
@@ -294,24 +462,94 @@ void GrammarService::PhraseFinishedCallback(UInt32 flags, Object ^grammarObj, IS
 
    delete[] path;
 
-   // Evaluate the list of spoken words against the
-   // list of available rules in the grammar.
-   ge->Grammar->InvokeRule(spokenWords);
+   return spokenWords;
+}
+
+void GrammarService::ReadEngineLimits() {
+   SRMODEINFOW modeInfo;
+
+   _maxWords = 0;
+   _maxGrammars = 0;
+
+   try {
+      _isrCentral->ModeGet(&modeInfo);
+   } catch (COMException ^e) {
+      Debug::WriteLine("GrammarService: Could not read the engine's limits ({0:x8}).", e->HResult);
+      return;
+   }
+
+   // Every word of a grammar can be active in its first state, so
+   // keep each grammar under both word limits.
+   _maxWords = modeInfo.dwMaxWordsVocab;
+
+   if (modeInfo.dwMaxWordsState != 0 && (_maxWords == 0 || modeInfo.dwMaxWordsState < _maxWords))
+      _maxWords = modeInfo.dwMaxWordsState;
+
+   _maxGrammars = modeInfo.dwGrammars;
 
+   Debug::WriteLine(
+      "GrammarService: Engine limits: {0} words (vocabulary: {1}, state: {2}), {3} grammars.",
+      _maxWords, modeInfo.dwMaxWordsVocab, modeInfo.dwMaxWordsState, _maxGrammars
+   );
 }
 
-GrammarExecutive ^GrammarService::RemoveGrammarFromList(IGrammar ^grammar) {
-   auto ge = GetGrammarExecutive(grammar);
+array<byte> ^GrammarService::ReadArchive(GrammarExecutive ^ge) {
+   auto grammar = ge->Grammar;
+   auto hash = ge->Hash;
+   auto path = GetArchivePath(ge);
+
+   if (path == nullptr || File::Exists(path) == false)
+      return nullptr;
+
+   try {
+      auto reader = gcnew BinaryReader(File::OpenRead(path));
+
+      try {
+         if (reader->ReadUInt32() != ArchiveMagic || reader->ReadUInt32() != ArchiveVersion)
+            return nullptr;
+
+         // Is the archive for this version of the grammar?
+         auto archivedHash = reader->ReadBytes(hash->Length);
+
+         if (StructuralComparisons::StructuralEqualityComparer->Equals(archivedHash, hash) == false) {
+            Debug::WriteLine("GrammarService: Archive of " + grammar + " is out of date.");
+            return nullptr;
+         }
+
+         auto length = reader->ReadInt32();
+         auto archiveBytes = reader->ReadBytes(length);
+
+         if (length <= 0 || archiveBytes->Length != length)
+            return nullptr;
+
+         return archiveBytes;
+      } finally {
+         delete reader;
+      }
+   } catch (IOException ^e) {
+      Debug::WriteLine("GrammarService: Could not read " + path + ": " + e->Message);
+      return nullptr;
+   }
+}
+
+void GrammarService::ReleasePartition(GrammarExecutive ^ge) {
+   ge->ReleaseGrammar();
+   ge->ReleaseNotifySink();
+}
+
+List<GrammarExecutive^> ^GrammarService::RemoveGrammarFromList(IGrammar ^grammar) {
+   auto executives = GetGrammarExecutives(grammar);
 
    _grammars->Remove(grammar);
 
-   return ge;
+   return executives;
 }
 
 void GrammarService::SetExclusiveGrammar(IGrammar ^grammar, bool exclusive) {
-   auto ge = GetGrammarExecutive(grammar);
 
-   ((IDgnSrGramCommon^)(ge->GramCommonInterface))->SpecialGrammar(exclusive);
+   // Every partition has to be exclusive, or the grammar would lose some of its rules.
+   for each (auto ge in GetGrammarExecutives(grammar))
+      Marshal::ThrowExceptionForHR(ge->DgnGramCommon->SpecialGrammar(exclusive == true ? TRUE : FALSE));
 }
 
 void GrammarService::UnloadGrammar(IGrammar ^grammar) {
@@ -320,12 +558,71 @@ void GrammarService::UnloadGrammar(IGrammar ^grammar) {
 
    Debug::WriteLine("GrammarService: Unloading " + grammar + ".");
 
-   auto ge = RemoveGrammarFromList(grammar);
-
-   if (ge->GramCommonInterface == nullptr)
-      throw gcnew InvalidStateException("isrGramCommon interface is not set!");
+   for each (auto ge in RemoveGrammarFromList(grammar)) {
+      if (ge->GramCommon == nullptr)
+         throw gcnew InvalidStateException("isrGramCommon interface is not set!");
 
-   Marshal::ReleaseComObject(ge->GramCommonInterface);
-   ge->GramCommonInterface = nullptr;
+      WriteArchive(ge);
+      ReleasePartition(ge);
+   }
 }
 
+void GrammarService::WriteArchive(GrammarExecutive ^ge) {
+   auto path = GetArchivePath(ge);
+
+   if (path == nullptr || ge->Hash == nullptr)
+      return;
+
+   DWORD dwNeeded = 0;
+
+   // Find out how big the archive is
+   auto hr = ge->GramCommon->Archive(FALSE, nullptr, 0, &dwNeeded);
+
+   if (FAILED(hr) == true && dwNeeded == 0) {
+      Debug::WriteLine("GrammarService: Could not archive {0} ({1:x8}).", ge->Grammar, hr);
+      return;
+   }
+
+   if (dwNeeded == 0)
+      return;
+
+   auto archiveBytes = gcnew array<byte>(dwNeeded);
+
+   {
+      pin_ptr<byte> bytes = &archiveBytes[0];
+      hr = ge->GramCommon->Archive(FALSE, bytes, dwNeeded, &dwNeeded);
+   }
+
+   if (FAILED(hr) == true) {
+      Debug::WriteLine("GrammarService: Could not archive {0} ({1:x8}).", ge->Grammar, hr);
+      return;
+   }
+
+   // Write to a temporary file first, so that a partial archive is never picked up.
+   auto tempPath = path + ".tmp";
+
+   try {
+      Directory::CreateDirectory(Path::GetDirectoryName(path));
+
+      auto writer = gcnew BinaryWriter(File::Create(tempPath));
+
+      try {
+         writer->Write(ArchiveMagic);
+         writer->Write(ArchiveVersion);
+         writer->Write(ge->Hash);
+         writer->Write((Int32)dwNeeded);
+         writer->Write(archiveBytes, 0, dwNeeded);
+      } finally {
+         delete writer;
+      }
+
+      if (File::Exists(path) == true)
+         File::Delete(path);
+
+      File::Move(tempPath, path);
+   } catch (IOException ^e) {
+      Debug::WriteLine("GrammarService: Could not write " + path + ": " + e->Message);
+   } catch (UnauthorizedAccessException ^e) {
+      Debug::WriteLine("GrammarService: Could not write " + path + ": " + e->Message);
+   }
+}
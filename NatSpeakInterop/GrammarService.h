@@ -18,7 +18,9 @@
 #pragma once
 
 #include "IGrammar.h"
+#include "GrammarPartition.h"
 #include "IGrammarSerializer.h"
+#include "GrammarLoadInfo.h"
 #include "IGrammarService.h"
 #include "GrammarExecutive.h"
 
@@ -31,18 +33,48 @@ namespace Renfrew::NatSpeakInterop {
 
       private: IGrammarSerializer ^_grammarSerializer;
 
-      private: Dictionary<IGrammar^, GrammarExecutive^> ^_grammars;
+      private: Dictionary<IGrammar^, List<GrammarExecutive^>^> ^_grammars;
+      private: Dictionary<IGrammar^, GrammarLoadInfo^> ^_loadInfo;
 
-      private: HashSet<String^> ^_activeRules;
+      private: String ^_archiveDirectory;
+
+      // The notify sinks call back through a function pointer to this delegate,
+      // which has to live as long as the service does.
+      private: [UnmanagedFunctionPointer(CallingConvention::StdCall)]
+               delegate void PhraseFinishHandler(IntPtr context, IntPtr result);
+      private: PhraseFinishHandler ^_phraseFinishHandler;
+      private: Sinks::PhraseFinishCallback _phraseFinishCallback;
+
+      // Engine limits (0 = no limit)
+      private: UInt32 _maxWords;
+      private: UInt32 _maxGrammars;
+
+      // Archive file header
+      private: static const UInt32 ArchiveMagic   = 0x41464E52; // "RNFA"
+      private: static const UInt32 ArchiveVersion = 1;
 
       public: GrammarService(ISrCentral ^isrCentral,
                              IDgnSrEngineControl ^idgnSrEngineControl);
       public: ~GrammarService();
 
-      private: GrammarExecutive ^AddGrammarToList(IGrammar ^grammar);
-      private: GrammarExecutive ^RemoveGrammarFromList(IGrammar ^grammar);
+      private: List<GrammarExecutive^> ^AddGrammarToList(IGrammar ^grammar);
+      private: List<GrammarExecutive^> ^RemoveGrammarFromList(IGrammar ^grammar);
+
+      private: List<GrammarExecutive^> ^GetGrammarExecutives(IGrammar ^grammar);
+      private: GrammarExecutive ^GetGrammarExecutive(IGrammar ^grammar, String ^ruleName);
+
+      private: void ReadEngineLimits();
+      private: GrammarLoadInfo ^LoadPartition(GrammarExecutive ^ge);
+      private: void ReleasePartition(GrammarExecutive ^ge);
 
-      private: GrammarExecutive ^GetGrammarExecutive(IGrammar ^grammar);
+      private: static array<byte> ^ComputeHash(array<byte> ^grammarBytes);
+      private: static List<String^> ^GetBestPathWords(ISrResBasic ^isrResBasic);
+      private: LPUNKNOWN EngineGrammarLoad(SRGRMFMT format, array<byte> ^grammarBytes,
+                                           IntPtr notifySinkPtr);
+
+      private: String ^GetArchivePath(GrammarExecutive ^ge);
+      private: array<byte> ^ReadArchive(GrammarExecutive ^ge);
+      private: void WriteArchive(GrammarExecutive ^ge);
 
       public: virtual void ActivateRule(IGrammar ^grammar, HWND hWnd, String ^ruleName);
       public: virtual void ActivateRule(IGrammar ^grammar, IntPtr hWnd, String ^ruleName);
@@ -55,10 +87,17 @@ namespace Renfrew::NatSpeakInterop {
          void set(IGrammarSerializer ^grammarSerializer);
       }
 
+      public: virtual property String ^ArchiveDirectory {
+         String ^get();
+         void set(String ^archiveDirectory);
+      }
+
+      public: virtual GrammarLoadInfo ^GetLoadInfo(IGrammar ^grammar);
+
       public: virtual void LoadGrammar(IGrammar ^grammar);
       public: virtual void UnloadGrammar(IGrammar ^grammar);
 
       public: void PausedProcessor(UInt64 cookie);
-      public: void PhraseFinishedCallback(UInt32 flags, Object ^grammarObj, ISrResBasic^ isrResBasic);
+      private: void PhraseFinished(IntPtr context, IntPtr result);
    };
 }
\ No newline at end of file
@@ -20,5 +20,11 @@
 namespace Renfrew::NatSpeakInterop {
    public interface class IGrammarSerializer {
       public: array<byte> ^Serialize(IGrammar ^grammar);
+
+      /// <summary>
+      /// Serializes the grammar as one or more engine grammars, none of which
+      /// use more than maxWords words (zero means no limit).
+      /// </summary>
+      public: IList<GrammarPartition^> ^Partition(IGrammar ^grammar, UInt32 maxWords);
    };
 }
\ No newline at end of file
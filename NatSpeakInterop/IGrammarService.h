@@ -30,6 +30,21 @@ namespace Renfrew::NatSpeakInterop {
          void set(IGrammarSerializer ^grammarSerializer);
       };
 
+      /// <summary>
+      /// The directory that engine grammar archives are kept in. A grammar is archived
+      /// when it's unloaded, and restored from its archive on the next load as long as
+      /// it hasn't changed. Archiving is disabled while this is null.
+      /// </summary>
+      property String ^ArchiveDirectory {
+         String ^get();
+         void set(String ^archiveDirectory);
+      };
+
+      /// <summary>
+      /// Gets how the grammar was last loaded, or null if it hasn't been loaded.
+      /// </summary>
+      GrammarLoadInfo ^GetLoadInfo(IGrammar ^grammar);
+
       void LoadGrammar(IGrammar ^grammar);
       void UnloadGrammar(IGrammar ^grammar);
    };
@@ -135,6 +135,26 @@ String ^NatSpeakService::GetCurrentUserProfileName() {
    }
 }
 
+void NatSpeakService::OnAttributeChanged(UInt32 attribute) {
+   if (attribute != ISRNSAC_SPEAKER)
+      return;
+
+   // Called on Dragon's notification thread, so nothing may escape
+   try {
+
+      // The notification is also sent while a profile is being unloaded, so
+      // only announce the profile once Dragon can actually report it.
+      auto profileName = GetCurrentUserProfileName();
+
+      if (profileName == nullptr)
+         return;
+
+      ProfileReady(this, gcnew ProfileReadyEventArgs(profileName));
+   } catch (Exception ^e) {
+      Debug::WriteLine("NatSpeakService: Could not handle a speaker change: " + e);
+   }
+}
+
 DragonVersion ^NatSpeakService::GetDragonVersion() {
    WORD major, minor, patch;
 
@@ -285,7 +305,8 @@ void NatSpeakService::RegisterEngineSink() {
 
                                // Create an engine sink
    auto sink = gcnew SrNotifySink(
-      gcnew Action<UInt64>(_grammarService, &NatSpeakInterop::GrammarService::PausedProcessor)
+      gcnew Action<UInt64>(_grammarService, &NatSpeakInterop::GrammarService::PausedProcessor),
+      gcnew Action<UInt32>(this, &NatSpeakService::OnAttributeChanged)
    );
 
    // ISrNotifySink ^isrNotifySink = sink;
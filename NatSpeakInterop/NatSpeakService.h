@@ -18,6 +18,7 @@
 #pragma once
 
 #include "GrammarService.h"
+#include "ProfileReadyEventArgs.h"
 
 // Native types are private by default with /clr
 #pragma make_public(::IServiceProvider)
@@ -51,6 +52,7 @@ namespace Renfrew::NatSpeakInterop {
       public: ~NatSpeakService();
 
       private: void CreateGrammarService();
+      private: void OnAttributeChanged(UInt32 attribute);
       private: void ReleaseGrammarService();
 
       private: void InitializeIsrCentral(::IServiceProvider *pServiceProvider);
@@ -63,6 +65,12 @@ namespace Renfrew::NatSpeakInterop {
       public: void Connect(::IServiceProvider *pServiceProvider);
       public: void Disconnect();
 
+      /// <summary>
+      /// Raised when Dragon reports that a user profile has been loaded or switched.
+      /// Handlers are called on Dragon's notification thread.
+      /// </summary>
+      public: event EventHandler<ProfileReadyEventArgs ^> ^ProfileReady;
+
       public: IntPtr CreateSiteObject();
       public: void ReleaseSiteObject(IntPtr sitePtr);
 
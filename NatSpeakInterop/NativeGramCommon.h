@@ -0,0 +1,48 @@
+// Project Renfrew
+// Copyright(C) 2024 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+
+#pragma once
+
+#include "IDgnSrGramCommon.h"
+#include "ISrGramCommon.h"
+
+namespace Renfrew::NatSpeakInterop::Dragon::ComInterfaces {
+
+   // Native declarations of the grammar interfaces, so that they can be called
+   // without going through an RCW. The method order has to match the managed
+   // interfaces (and so the engine's vtables).
+
+   struct DECLSPEC_UUID(ISrGramCommonGUID)
+   INativeSrGramCommon : public IUnknown {
+      public: STDMETHOD(Activate)(HWND, BOOL, PCWSTR) = 0;
+      public: STDMETHOD(Archive)(BOOL, PVOID, DWORD, DWORD *) = 0;
+      public: STDMETHOD(BookMark)(QWORD, DWORD) = 0;
+      public: STDMETHOD(Deactivate)(PCWSTR) = 0;
+      public: STDMETHOD(DeteriorationGet)(DWORD *, DWORD *, DWORD *) = 0;
+      public: STDMETHOD(DeteriorationSet)(DWORD, DWORD, DWORD) = 0;
+      public: STDMETHOD(TrainDlg)(HWND, PCWSTR) = 0;
+      public: STDMETHOD(TrainPhrase)(DWORD, PSDATA) = 0;
+      public: STDMETHOD(TrainQuery)(DWORD *) = 0;
+   };
+
+   struct DECLSPEC_UUID(IDgnSRGramCommonGUID)
+   INativeDgnSrGramCommon : public IUnknown {
+      public: STDMETHOD(SpecialGrammar)(BOOL) = 0;
+      public: STDMETHOD(Identify)(GUID *) = 0;
+   };
+}
\ No newline at end of file
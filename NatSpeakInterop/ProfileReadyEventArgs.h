@@ -0,0 +1,40 @@
+// Project Renfrew
+// Copyright(C) 2019 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#pragma once
+
+namespace Renfrew::NatSpeakInterop {
+   public ref class ProfileReadyEventArgs : EventArgs {
+
+      private: String ^_profileName;
+
+      public: ProfileReadyEventArgs(String ^profileName) {
+         if (profileName == nullptr)
+            throw gcnew ArgumentNullException("profileName");
+
+         _profileName = profileName;
+      }
+
+      /// <summary>
+      /// The name of the Dragon user profile that was loaded.
+      /// </summary>
+      public: property String ^ProfileName {
+         String ^get() {
+            return _profileName;
+         }
+      }
+   };
+}
@@ -15,87 +15,108 @@
 // along with this program.If not, see<http://www.gnu.org/licenses/>.
 //
 
-#pragma once
 
-#include "Stdafx.h"
+// Compiled without /clr, so the engine's notifications don't cross into managed code
+// until there's a phrase to hand over.
+
+#include <cwchar>
+
 #include "SrGramNotifySink.h"
 #include "SinkFlags.h"
 
 using namespace Renfrew::NatSpeakInterop::Sinks;
-using namespace Renfrew::NatSpeakInterop::Dragon::ComInterfaces;
 
-SrGramNotifySink::SrGramNotifySink(Action<UInt32, Object^, ISrResBasic^> ^phraseFinishCallback,
-   Object ^callbackParam) {
+SrGramNotifySink::SrGramNotifySink(PhraseFinishCallback phraseFinishCallback, void *context) {
+   _references = 1;
+   _phraseFinishCallback = phraseFinishCallback;
+   _context = context;
+}
 
-   if (phraseFinishCallback == nullptr)
-      throw gcnew ArgumentNullException("phraseFinishCallback");
-   if (callbackParam == nullptr)
-      throw gcnew ArgumentNullException("callbackParam");
+SrGramNotifySink::~SrGramNotifySink() {
 
-   _phraseFinishCallback = phraseFinishCallback;
-   _callbackParam = callbackParam;
 }
 
-// ISrGramNotifySink Methods
-void SrGramNotifySink::BookMark(DWORD) {
-   Debug::WriteLine(__FUNCTION__);
+void SrGramNotifySink::Detach() {
+   _phraseFinishCallback = nullptr;
+   _context = nullptr;
 }
 
-void SrGramNotifySink::Paused() {
-   Debug::WriteLine(__FUNCTION__);
+// IUnknown Methods
+HRESULT SrGramNotifySink::QueryInterface(REFIID riid, void **ppvObject) {
+   if (ppvObject == nullptr)
+      return E_POINTER;
+
+   if (riid == IID_IUnknown || riid == __uuidof(INativeSrGramNotifySink)) {
+      *ppvObject = static_cast<INativeSrGramNotifySink *>(this);
+   } else if (riid == __uuidof(INativeDgnGetSinkFlags)) {
+      *ppvObject = static_cast<INativeDgnGetSinkFlags *>(this);
+   } else {
+      *ppvObject = nullptr;
+      return E_NOINTERFACE;
+   }
+
+   AddRef();
+
+   return S_OK;
 }
 
-void SrGramNotifySink::PhraseFinish(DWORD flags, QWORD, QWORD, PSRPHRASEW pSrPhrase, LPUNKNOWN pIUnknown) {
-   Debug::WriteLine(__FUNCTION__);
+ULONG SrGramNotifySink::AddRef() {
+   return InterlockedIncrement(&_references);
+}
 
-   // Check if a results object was provided, and silently return if not
-   if (pIUnknown == nullptr)
-      return;
+ULONG SrGramNotifySink::Release() {
+   auto references = InterlockedDecrement(&_references);
 
-   // Debugging (for now)
-   if (pSrPhrase != nullptr) {
+   if (references == 0)
+      delete this;
 
-      UInt32 offset = 0;
+   return references;
+}
 
-      while (offset < (pSrPhrase->dwSize - sizeof(DWORD))) {
-         PSRWORDW word = (PSRWORDW)(pSrPhrase->abWords + offset);
+// ISrGramNotifySink Methods
+HRESULT SrGramNotifySink::BookMark(DWORD) {
+   return S_OK;
+}
 
-         Debug::WriteLine(
-            "Word (# {0}, Length: {1}): {2}",
-            word->dwWordNum,
-            word->dwSize,
-            gcnew String((PWCHAR)word->szWord)
-         );
+HRESULT SrGramNotifySink::Paused() {
+   return S_OK;
+}
 
-         offset += word->dwSize;
-      }
-   }
+HRESULT SrGramNotifySink::PhraseFinish(DWORD flags, QWORD, QWORD, PSRPHRASEW pSrPhrase, LPUNKNOWN pIUnknown) {
 
-   auto isrResBasic = (ISrResBasic^)Marshal::GetObjectForIUnknown(IntPtr(pIUnknown));
+   // Check if a results object was provided, and silently return if not
+   if (pIUnknown == nullptr || _phraseFinishCallback == nullptr)
+      return S_OK;
 
-   _phraseFinishCallback(flags, _callbackParam, isrResBasic);
+   _words.clear();
 
-   // TODO: Move to a more appropriate place (if this _isn't_ appropriate).
-   Marshal::ReleaseComObject(isrResBasic);
-}
+   PhraseResult result;
+   result.Flags = flags;
+   result.HasPhrase = pSrPhrase != nullptr && DecodePhrase(pSrPhrase, _words) == true;
+   result.WordCount = result.HasPhrase == true ? static_cast<DWORD>(_words.size()) : 0;
+   result.Words = result.HasPhrase == true ? _words.data() : nullptr;
+   result.Results = pIUnknown;
+
+   _phraseFinishCallback(_context, &result);
 
-void SrGramNotifySink::PhraseHypothesis(DWORD, QWORD, QWORD, PSRPHRASEW, LPUNKNOWN) {
-   Debug::WriteLine(__FUNCTION__);
+   return S_OK;
 }
 
-void SrGramNotifySink::PhraseStart(QWORD) {
-   Debug::WriteLine(__FUNCTION__);
+HRESULT SrGramNotifySink::PhraseHypothesis(DWORD, QWORD, QWORD, PSRPHRASEW, LPUNKNOWN) {
+   return S_OK;
 }
 
-void SrGramNotifySink::ReEvaluate(LPUNKNOWN) {
-   Debug::WriteLine(__FUNCTION__);
+HRESULT SrGramNotifySink::PhraseStart(QWORD) {
+   return S_OK;
 }
 
-void SrGramNotifySink::SinkFlagsGet(DWORD *pdwFlags) {
-   Debug::WriteLine(__FUNCTION__);
+HRESULT SrGramNotifySink::ReEvaluate(LPUNKNOWN) {
+   return S_OK;
+}
 
+HRESULT SrGramNotifySink::SinkFlagsGet(DWORD *pdwFlags) {
    if (pdwFlags == nullptr)
-      return;
+      return E_POINTER;
 
    // These are the notifications handled by this sink
    *pdwFlags = DGNSRGRAMSINKFLAG_SENDPHRASEFINISH;
@@ -107,12 +128,46 @@ void SrGramNotifySink::SinkFlagsGet(DWORD *pdwFlags) {
    /* TODO: Decide if I'll support this...
    if ( hypothesis wanted )
       *pdwFlags |= DGNSRGRAMSINKFLAG_SENDPHRASEHYPO; */
+
+   return S_OK;
 }
 
-void SrGramNotifySink::Training(DWORD) {
-   Debug::WriteLine(__FUNCTION__);
+HRESULT SrGramNotifySink::Training(DWORD) {
+   return S_OK;
 }
 
-void SrGramNotifySink::UnArchive(LPUNKNOWN) {
-   Debug::WriteLine(__FUNCTION__);
+HRESULT SrGramNotifySink::UnArchive(LPUNKNOWN) {
+   return S_OK;
+}
+
+// Splits the phrase into its words, which point into the phrase itself. Returns
+// false if the phrase isn't well formed.
+bool SrGramNotifySink::DecodePhrase(const SRPHRASEW *pSrPhrase, std::vector<const wchar_t *> &words) {
+   if (pSrPhrase->dwSize < sizeof(DWORD))
+      return false;
+
+   DWORD length = pSrPhrase->dwSize - sizeof(DWORD);
+   DWORD offset = 0;
+
+   while (offset < length) {
+      if (length - offset < sizeof(SRWORDW))
+         return false;
+
+      auto word = reinterpret_cast<const SRWORDW *>(pSrPhrase->abWords + offset);
+
+      if (word->dwSize < sizeof(SRWORDW) || word->dwSize > length - offset)
+         return false;
+
+      // The word has to be terminated inside its own record
+      auto characters = (word->dwSize - sizeof(SRWORDW)) / sizeof(WCHAR);
+
+      if (wmemchr(word->szWord, L'\0', characters) == nullptr)
+         return false;
+
+      words.push_back(word->szWord);
+
+      offset += word->dwSize;
+   }
+
+   return true;
 }
\ No newline at end of file
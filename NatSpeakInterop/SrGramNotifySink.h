@@ -15,34 +15,110 @@
 // along with this program.If not, see<http://www.gnu.org/licenses/>.
 //
 
+
 #pragma once
 
-#include "IDgnGetSinkFlags.h"
-#include "ISrGramNotifySink.h"
-#include "ISrResBasic.h"
+#include <Windows.h>
+
+#include <vector>
+
+typedef unsigned __int64 QWORD, *PQWORD;
+
+#include "sinfo.h"
 
 namespace Renfrew::NatSpeakInterop::Sinks {
-   public ref class SrGramNotifySink :
-      public Dragon::ComInterfaces::ISrGramNotifySink,
-      public Dragon::ComInterfaces::IDgnGetSinkFlags {
 
-      private: Object ^_callbackParam;
-      private: Action<UInt32, Object^, Dragon::ComInterfaces::ISrResBasic^> ^_phraseFinishCallback;
-      public: SrGramNotifySink(Action<UInt32, Object^,
-                               Dragon::ComInterfaces::ISrResBasic^> ^phraseFinishCallback,
-                               Object ^callbackParam);
+   /// <summary>
+   /// A phrase recognized by the engine, as handed to the grammar service. It's only
+   /// valid for the duration of the callback.
+   /// </summary>
+   struct PhraseResult {
+      DWORD Flags;
+
+      // Whether the engine sent the phrase with the results. If it didn't, the
+      // words have to be read from the results object instead.
+      bool HasPhrase;
+
+      DWORD WordCount;
+      const wchar_t *const *Words;
+
+      // The engine's results object (not AddRef'd)
+      LPUNKNOWN Results;
+   };
+
+   typedef void (__stdcall *PhraseFinishCallback)(void *context, const PhraseResult *result);
+
+   // Native declarations of the interfaces the engine calls back on. The method
+   // order has to match the managed interfaces (and so the engine's vtables).
+   struct __declspec(uuid("f106bfa0-c743-11cd-80e5-00aa003e4b50"))
+   INativeSrGramNotifySink : public IUnknown {
+      public: STDMETHOD(BookMark)(DWORD) = 0;
+      public: STDMETHOD(Paused)() = 0;
+      public: STDMETHOD(PhraseFinish)(DWORD, QWORD, QWORD, PSRPHRASEW, LPUNKNOWN) = 0;
+      public: STDMETHOD(PhraseHypothesis)(DWORD, QWORD, QWORD, PSRPHRASEW, LPUNKNOWN) = 0;
+      public: STDMETHOD(PhraseStart)(QWORD) = 0;
+      public: STDMETHOD(ReEvaluate)(LPUNKNOWN) = 0;
+      public: STDMETHOD(Training)(DWORD) = 0;
+      public: STDMETHOD(UnArchive)(LPUNKNOWN) = 0;
+   };
+
+   struct __declspec(uuid("dd108010-6205-11cf-ae61-0000e8a28647"))
+   INativeDgnGetSinkFlags : public IUnknown {
+      public: STDMETHOD(SinkFlagsGet)(DWORD *pdwFlags) = 0;
+   };
+
+   /// <summary>
+   /// Receives a grammar's notifications from the engine. This is a plain COM object
+   /// rather than a managed one behind a COM callable wrapper, so the notifications
+   /// we don't handle never reach managed code, and a finished phrase is decoded here
+   /// and passed on in a single call.
+   /// </summary>
+   class SrGramNotifySink :
+      public INativeSrGramNotifySink,
+      public INativeDgnGetSinkFlags {
+
+      private: volatile LONG _references;
+
+      private: PhraseFinishCallback _phraseFinishCallback;
+      private: void *_context;
+
+      // Reused for every phrase
+      private: std::vector<const wchar_t *> _words;
+
+      /// <summary>
+      /// Creates a sink with one reference, owned by the caller.
+      /// </summary>
+      public: SrGramNotifySink(PhraseFinishCallback phraseFinishCallback, void *context);
+
+      public: SrGramNotifySink(const SrGramNotifySink &) = delete;
+      public: SrGramNotifySink &operator=(const SrGramNotifySink &) = delete;
+
+      private: ~SrGramNotifySink();
+
+      /// <summary>
+      /// Stops the callbacks. The engine may hold on to the sink for a while after
+      /// the grammar is released.
+      /// </summary>
+      public: void Detach();
+
+      // IUnknown Methods
+      public: STDMETHOD(QueryInterface)(REFIID riid, void **ppvObject) override;
+      public: STDMETHOD_(ULONG, AddRef)() override;
+      public: STDMETHOD_(ULONG, Release)() override;
 
       // IDgnGetSinkFlags Methods
-      public: void virtual SinkFlagsGet(DWORD *pdwFlags);
+      public: STDMETHOD(SinkFlagsGet)(DWORD *pdwFlags) override;
 
       // ISrGramNotifySink Methods
-      public: void virtual BookMark(DWORD);
-      public: void virtual Paused();
-      public: void virtual PhraseFinish(DWORD flags, QWORD, QWORD, PSRPHRASEW pSrPhrase, LPUNKNOWN pIUnknown);
-      public: void virtual PhraseHypothesis(DWORD, QWORD, QWORD, PSRPHRASEW, LPUNKNOWN);
-      public: void virtual PhraseStart(QWORD);
-      public: void virtual ReEvaluate(LPUNKNOWN);
-      public: void virtual Training(DWORD);
-      public: void virtual UnArchive(LPUNKNOWN);
+      public: STDMETHOD(BookMark)(DWORD) override;
+      public: STDMETHOD(Paused)() override;
+      public: STDMETHOD(PhraseFinish)(DWORD flags, QWORD, QWORD, PSRPHRASEW pSrPhrase, LPUNKNOWN pIUnknown) override;
+      public: STDMETHOD(PhraseHypothesis)(DWORD, QWORD, QWORD, PSRPHRASEW, LPUNKNOWN) override;
+      public: STDMETHOD(PhraseStart)(QWORD) override;
+      public: STDMETHOD(ReEvaluate)(LPUNKNOWN) override;
+      public: STDMETHOD(Training)(DWORD) override;
+      public: STDMETHOD(UnArchive)(LPUNKNOWN) override;
+
+      private: static bool DecodePhrase(const SRPHRASEW *pSrPhrase, std::vector<const wchar_t *> &words);
    };
 }
\ No newline at end of file
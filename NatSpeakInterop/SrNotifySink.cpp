@@ -23,18 +23,22 @@
 
 using namespace Renfrew::NatSpeakInterop::Sinks;
 
-SrNotifySink::SrNotifySink(Action<UInt64> ^pausedProcessingCallback) {
+SrNotifySink::SrNotifySink(Action<UInt64> ^pausedProcessingCallback,
+                           Action<UInt32> ^attributeChangedCallback) {
    if (pausedProcessingCallback == nullptr)
       throw gcnew ArgumentNullException("pausedProcessingCallback");
 
    _pausedProcessingCallback = pausedProcessingCallback;
+   _attributeChangedCallback = attributeChangedCallback;
 }
 
-void SrNotifySink::AttribChanged(DWORD) {
+void SrNotifySink::AttribChanged(DWORD dwAttributes) {
    Debug::WriteLine(__FUNCTION__);
 
    // TODO: Can this callback be triggered?
 
+   if (_attributeChangedCallback != nullptr)
+      _attributeChangedCallback(dwAttributes);
 }
 
 void SrNotifySink::AttribChanged2(DWORD dwAttributes) {
@@ -50,11 +54,16 @@ void SrNotifySink::AttribChanged2(DWORD dwAttributes) {
       case DGNSRAC_MICSTATE:
          Debug::WriteLine("Microphone state changed.");
          break;
+      case ISRNSAC_SPEAKER:
+         Debug::WriteLine("Speaker (user profile) changed.");
+         break;
       default:
          Debug::WriteLine("Unhandled attribute(s): {0:x4}.", dwAttributes);
          break;
    }
 
+   if (_attributeChangedCallback != nullptr)
+      _attributeChangedCallback(dwAttributes);
 }
 
 void SrNotifySink::ErrorHappened(LPUNKNOWN) {
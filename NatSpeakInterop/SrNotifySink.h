@@ -28,8 +28,10 @@ namespace Renfrew::NatSpeakInterop::Sinks {
       public Dragon::ComInterfaces::ISrNotifySink {
 
       private: Action<UInt64> ^_pausedProcessingCallback;
+      private: Action<UInt32> ^_attributeChangedCallback;
 
-      public: SrNotifySink(Action<UInt64> ^pausedProcessingCallback);
+      public: SrNotifySink(Action<UInt64> ^pausedProcessingCallback,
+                           Action<UInt32> ^attributeChangedCallback);
       public: void virtual SinkFlagsGet(DWORD *pdwFlags);
 
       // IDgnSREngineNotifySink Methods
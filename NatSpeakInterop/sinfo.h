@@ -51,6 +51,16 @@
                          /*? 1012*/
 #define DGNSRAC_MUTE         1013
 
+// Related to ISrNotifySink (also delivered through IDgnSREngineNotifySink::AttribChanged2)
+#define ISRNSAC_AUTOGAINENABLE 1
+#define ISRNSAC_THRESHOLD      2
+#define ISRNSAC_ECHO           3
+#define ISRNSAC_ENERGYFLOOR    4
+#define ISRNSAC_MICROPHONE     5
+#define ISRNSAC_REALTIME       6
+#define ISRNSAC_SPEAKER        7
+#define ISRNSAC_TIMEOUT        8
+
 typedef enum {
    SRGRMFMT_CFG                 = 0x0000,
    SRGRMFMT_LIMITEDDOMAIN       = 0x0001,
@@ -0,0 +1,77 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include <random>
+#include <vector>
+
+#include "AnimationPath.h"
+#include "Benchmark.h"
+
+using namespace Renfrew::Win32::Interop;
+using namespace Renfrew::Tests;
+
+// Working out each frame of a gesture. The input thread asks for one point per
+// frame, so this only needs to be far below a frame (~16 ms); it's measured per
+// point, for each easing.
+int main() {
+   std::mt19937 random(7);
+   std::uniform_int_distribution<int> x(-2560, 4479);
+   std::uniform_int_distribution<int> y(-1440, 2159);
+
+   const Easing easings[] = { Easing::Linear, Easing::EaseIn, Easing::EaseOut, Easing::EaseInOut };
+   const char *names[] = {
+      "PointAt, Linear (1,000,000 points)",
+      "PointAt, EaseIn (1,000,000 points)",
+      "PointAt, EaseOut (1,000,000 points)",
+      "PointAt, EaseInOut (1,000,000 points)",
+   };
+
+   volatile int sink = 0;
+
+   for (auto e = 0; e < 4; e++) {
+      std::vector<AnimationPath> paths;
+
+      for (auto i = 0; i < 1000; i++)
+         paths.emplace_back(PathPoint { x(random), y(random) }, PathPoint { x(random), y(random) }, 250.0, easings[e]);
+
+      // 1,000 samples along each path, to the end and just past it
+      auto ms = MedianMilliseconds([&] {
+         for (auto &path : paths) {
+            for (auto i = 0; i < 1000; i++) {
+               auto point = path.PointAt(i * 0.2575);
+               sink = sink + point.X + point.Y;
+            }
+         }
+      }, 11);
+
+      Report(names[e], ms, "point", 1000000);
+   }
+
+   // A whole gesture at 60 Hz, constructed and played, as Mouse::Animate does
+   auto ms = MedianMilliseconds([&] {
+      for (auto i = 0; i < 10000; i++) {
+         AnimationPath path(PathPoint { x(random), y(random) }, PathPoint { x(random), y(random) }, 250.0, Easing::EaseInOut);
+
+         for (auto elapsed = 0.0; path.IsComplete(elapsed) == false; elapsed += 1000.0 / 60)
+            sink = sink + path.PointAt(elapsed).X;
+      }
+   }, 11);
+
+   Report("Gesture of 250 ms at 60 Hz (10,000)", ms, "gesture", 10000);
+
+   return 0;
+}
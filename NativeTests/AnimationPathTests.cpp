@@ -0,0 +1,196 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "AnimationPath.h"
+#include "Check.h"
+
+using namespace Renfrew::Win32::Interop;
+
+static const Easing easings[] = { Easing::Linear, Easing::EaseIn, Easing::EaseOut, Easing::EaseInOut };
+
+// Paths across a desktop with screens either side of the primary, in every direction
+static std::vector<AnimationPath> RandomPaths(std::mt19937 &random, int count, double durationMs) {
+   std::uniform_int_distribution<int> x(-2560, 4479);
+   std::uniform_int_distribution<int> y(-1440, 2159);
+
+   std::vector<AnimationPath> paths;
+
+   for (auto i = 0; i < count; i++) {
+      PathPoint start { x(random), y(random) };
+      PathPoint end { x(random), y(random) };
+
+      paths.emplace_back(start, end, durationMs, easings[i % 4]);
+   }
+
+   return paths;
+}
+
+static bool IsBetween(int value, int from, int to) {
+   return from <= to ?
+      from <= value && value <= to :
+      to <= value && value <= from;
+}
+
+static void PathsShouldStartAndEndExactlyOnTheirEndPoints() {
+   std::mt19937 random(31);
+
+   for (auto duration : { 1.0, 16.0, 250.0, 333.3 }) {
+      for (auto i = 0; i < 2000; i++) {
+         std::uniform_int_distribution<int> x(-2560, 4479);
+         std::uniform_int_distribution<int> y(-1440, 2159);
+
+         PathPoint start { x(random), y(random) };
+         PathPoint end { x(random), y(random) };
+
+         AnimationPath path(start, end, duration, easings[i % 4]);
+
+         CHECK(path.PointAt(0.0) == start);
+         CHECK(path.PointAt(duration) == end);
+         CHECK(path.PointAt(duration * 10) == end);
+      }
+   }
+}
+
+static void EasingShouldBeMonotonicWithoutOvershoot() {
+   for (auto easing : easings) {
+      CHECK(AnimationPath::Ease(easing, 0.0) == 0.0);
+      CHECK(AnimationPath::Ease(easing, 1.0) == 1.0);
+
+      // Clamped outside the path, rather than extrapolated
+      CHECK(AnimationPath::Ease(easing, -0.5) == 0.0);
+      CHECK(AnimationPath::Ease(easing, 1.5) == 1.0);
+
+      auto previous = 0.0;
+      auto decreases = 0;
+      auto overshoots = 0;
+
+      for (auto i = 0; i <= 100000; i++) {
+         auto progress = AnimationPath::Ease(easing, i / 100000.0);
+
+         if (progress < previous)
+            decreases++;
+         if (progress < 0.0 || progress > 1.0)
+            overshoots++;
+
+         previous = progress;
+      }
+
+      CHECK(decreases == 0);
+      CHECK(overshoots == 0);
+   }
+}
+
+static void PointsShouldOnlyMoveTowardsTheEnd() {
+   std::mt19937 random(32);
+
+   auto paths = RandomPaths(random, 2000, 250.0);
+   auto backwards = 0;
+   auto outside = 0;
+
+   for (auto &path : paths) {
+      auto start = path.PointAt(0.0);
+      auto end = path.PointAt(path.Duration());
+      auto previous = start;
+
+      // A frame at a time, with a little jitter, as the input thread plays it
+      for (auto elapsed = 0.0; elapsed <= path.Duration() + 16.0; elapsed += 15.0 + (random() % 20) / 10.0) {
+         auto point = path.PointAt(elapsed);
+
+         if (IsBetween(point.X, start.X, end.X) == false || IsBetween(point.Y, start.Y, end.Y) == false)
+            outside++;
+         if (IsBetween(point.X, previous.X, end.X) == false || IsBetween(point.Y, previous.Y, end.Y) == false)
+            backwards++;
+
+         previous = point;
+      }
+   }
+
+   CHECK(outside == 0);
+   CHECK(backwards == 0);
+}
+
+static void DurationShouldNotDependOnDistance() {
+   PathPoint origin { 100, 100 };
+
+   for (auto easing : easings) {
+      AnimationPath near(origin, PathPoint { 103, 101 }, 250.0, easing);
+      AnimationPath far(origin, PathPoint { 3940, -980 }, 250.0, easing);
+
+      CHECK(near.Duration() == 250.0);
+      CHECK(far.Duration() == 250.0);
+
+      CHECK(near.IsComplete(249.9) == false);
+      CHECK(far.IsComplete(249.9) == false);
+      CHECK(near.IsComplete(250.0) == true);
+      CHECK(far.IsComplete(250.0) == true);
+
+      // Both are the same share of the way along at the same time
+      auto progress = AnimationPath::Ease(easing, 0.4);
+      auto farPoint = far.PointAt(100.0);
+
+      CHECK(farPoint.X == static_cast<int>(std::lround(100 + 3840 * progress)));
+      CHECK(farPoint.Y == static_cast<int>(std::lround(100 - 1080 * progress)));
+   }
+
+   // Halfway through a linear path is halfway along it
+   AnimationPath linear(PathPoint { 0, 0 }, PathPoint { 2000, -1000 }, 400.0, Easing::Linear);
+
+   CHECK(linear.PointAt(200.0) == (PathPoint { 1000, -500 }));
+}
+
+static void ZeroOrNegativeDurationShouldJumpToTheEnd() {
+   PathPoint start { -1200, 40 };
+   PathPoint end { 2400, 900 };
+
+   for (auto duration : { 0.0, -1.0, -250.0 }) {
+      for (auto easing : easings) {
+         AnimationPath path(start, end, duration, easing);
+
+         CHECK(path.Duration() == 0.0);
+         CHECK(path.IsComplete(0.0) == true);
+         CHECK(path.PointAt(0.0) == end);
+         CHECK(path.PointAt(16.0) == end);
+      }
+   }
+}
+
+static void ZeroLengthPathsShouldStayPut() {
+   PathPoint point { 640, -360 };
+
+   for (auto easing : easings) {
+      AnimationPath path(point, point, 250.0, easing);
+
+      for (auto elapsed = 0.0; elapsed <= 260.0; elapsed += 16.0)
+         CHECK(path.PointAt(elapsed) == point);
+   }
+}
+
+int main() {
+   RUN(PathsShouldStartAndEndExactlyOnTheirEndPoints);
+   RUN(EasingShouldBeMonotonicWithoutOvershoot);
+   RUN(PointsShouldOnlyMoveTowardsTheEnd);
+   RUN(DurationShouldNotDependOnDistance);
+   RUN(ZeroOrNegativeDurationShouldJumpToTheEnd);
+   RUN(ZeroLengthPathsShouldStayPut);
+
+   return Renfrew::Tests::Result();
+}
@@ -0,0 +1,58 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// Times a piece of work for the native benchmarks. The work is run a few times
+// first (to warm the caches), then timed repeatedly; the median is reported, as
+// it's the least disturbed by whatever else the machine is doing.
+
+namespace Renfrew::Tests {
+
+   template <typename Work>
+   double MedianMilliseconds(Work work, int runs = 21) {
+      for (auto i = 0; i < 3; i++)
+         work();
+
+      std::vector<double> times;
+
+      for (auto i = 0; i < runs; i++) {
+         auto start = std::chrono::steady_clock::now();
+         work();
+         auto end = std::chrono::steady_clock::now();
+
+         times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+      }
+
+      std::sort(times.begin(), times.end());
+      return times[times.size() / 2];
+   }
+
+   inline void Report(const char *name, double milliseconds, const char *per = nullptr, double count = 1) {
+      if (per == nullptr) {
+         std::printf("%-40s %10.3f ms\n", name, milliseconds);
+         return;
+      }
+
+      std::printf("%-40s %10.3f ms  (%.1f ns/%s)\n", name, milliseconds, milliseconds * 1e6 / count, per);
+   }
+}
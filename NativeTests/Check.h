@@ -0,0 +1,61 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <cstdio>
+
+// Just enough to write the native tests without a framework. A failed check is
+// reported and the test carries on; the exit code is the number of failures.
+
+namespace Renfrew::Tests {
+
+   inline int &Failures() {
+      static int failures = 0;
+      return failures;
+   }
+
+   inline void Check(bool condition, const char *expression, const char *file, int line) {
+      if (condition == true)
+         return;
+
+      std::fprintf(stderr, "%s(%d): check failed: %s\n", file, line, expression);
+      Failures()++;
+   }
+
+   /// <summary>
+   /// Runs a test, naming it if any of its checks fail.
+   /// </summary>
+   template <typename Test>
+   void Run(const char *name, Test test) {
+      auto before = Failures();
+
+      test();
+
+      if (Failures() != before)
+         std::fprintf(stderr, "FAILED: %s\n", name);
+      else
+         std::printf("passed: %s\n", name);
+   }
+
+   inline int Result() {
+      return Failures() < 255 ? Failures() : 255;
+   }
+}
+
+#define CHECK(expression) ::Renfrew::Tests::Check((expression), #expression, __FILE__, __LINE__)
+#define RUN(test) ::Renfrew::Tests::Run(#test, test)
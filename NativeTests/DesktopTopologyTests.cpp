@@ -0,0 +1,240 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include <stdexcept>
+#include <vector>
+
+#include "Check.h"
+#include "DesktopTopology.h"
+
+using namespace Renfrew::Win32::Interop;
+
+// A primary screen with a 1440p screen to its left, raised a little, at 150%
+static const std::vector<MonitorLayout> leftAndAbove = {
+   { { 0, 0, 1920, 1080 }, 96 },
+   { { -2560, -360, 0, 1080 }, 144 },
+};
+
+// Where Windows puts the cursor for a normalized point: the pixel at
+// (n * size) / 65536 from the virtual desktop's origin, rounded down
+static void FromAbsolute(const DesktopTopology &topology, AbsolutePoint point, int &x, int &y) {
+   auto &bounds = topology.VirtualBounds();
+
+   x = bounds.Left + static_cast<int>((static_cast<long long>(point.X) * (bounds.Right - bounds.Left)) / 65536);
+   y = bounds.Top + static_cast<int>((static_cast<long long>(point.Y) * (bounds.Bottom - bounds.Top)) / 65536);
+}
+
+static bool RoundTrips(const DesktopTopology &topology, int x, int y) {
+   int backX, backY;
+
+   FromAbsolute(topology, topology.ToAbsolute(x, y), backX, backY);
+
+   return backX == x && backY == y;
+}
+
+// Every pixel along the top and left of the desktop, which between them cover
+// every column and row, and the corners and edges of each monitor
+static int RoundTripFailures(const DesktopTopology &topology) {
+   auto &bounds = topology.VirtualBounds();
+   auto failures = 0;
+
+   for (auto x = bounds.Left; x < bounds.Right; x++) {
+      if (RoundTrips(topology, x, bounds.Top) == false || RoundTrips(topology, x, bounds.Bottom - 1) == false)
+         failures++;
+   }
+
+   for (auto y = bounds.Top; y < bounds.Bottom; y++) {
+      if (RoundTrips(topology, bounds.Left, y) == false || RoundTrips(topology, bounds.Right - 1, y) == false)
+         failures++;
+   }
+
+   for (std::size_t i = 0; i < topology.MonitorCount(); i++) {
+      auto &m = topology.MonitorAt(i).Bounds;
+
+      for (auto x : { m.Left, m.Left + 1, m.Right - 2, m.Right - 1 }) {
+         for (auto y : { m.Top, m.Top + 1, m.Bottom - 2, m.Bottom - 1 }) {
+            if (m.Contains(x, y) == true && RoundTrips(topology, x, y) == false)
+               failures++;
+         }
+      }
+   }
+
+   return failures;
+}
+
+static bool SameAbsolute(AbsolutePoint a, AbsolutePoint b) {
+   return a.X == b.X && a.Y == b.Y;
+}
+
+static void SingleMonitorShouldMapOntoTheWholeRange() {
+   DesktopTopology topology({ { { 0, 0, 1920, 1080 }, 96 } });
+
+   auto &bounds = topology.VirtualBounds();
+
+   CHECK(bounds.Left == 0 && bounds.Top == 0 && bounds.Right == 1920 && bounds.Bottom == 1080);
+
+   CHECK(topology.MonitorFromPoint(0, 0) == 0);
+   CHECK(topology.MonitorFromPoint(5000, -100) == 0);
+   CHECK(topology.ScaleAt(960, 540) == 1.0);
+
+   CHECK(SameAbsolute(topology.ToAbsolute(0, 0), AbsolutePoint { 0, 0 }));
+
+   auto last = topology.ToAbsolute(1919, 1079);
+
+   CHECK(last.X > 65000 && last.X <= DesktopTopology::AbsoluteMax);
+   CHECK(last.Y > 65000 && last.Y <= DesktopTopology::AbsoluteMax);
+
+   // Off the desktop is clamped to its edges
+   CHECK(SameAbsolute(topology.ToAbsolute(-50, -50), AbsolutePoint { 0, 0 }));
+   CHECK(SameAbsolute(topology.ToAbsolute(4000, 4000), last));
+
+   CHECK(RoundTripFailures(topology) == 0);
+}
+
+static void SideBySideMonitorsShouldShareTheRange() {
+   DesktopTopology topology({
+      { { 0, 0, 1920, 1080 }, 96 },
+      { { 1920, 0, 3840, 1080 }, 96 },
+   });
+
+   auto &bounds = topology.VirtualBounds();
+
+   CHECK(bounds.Left == 0 && bounds.Right == 3840 && bounds.Bottom == 1080);
+
+   // Right is exclusive, so the boundary belongs to the second monitor
+   CHECK(topology.MonitorFromPoint(1919, 500) == 0);
+   CHECK(topology.MonitorFromPoint(1920, 500) == 1);
+
+   // The second monitor starts halfway across
+   CHECK(topology.ToAbsolute(1920, 0).X == 32768);
+
+   CHECK(SameAbsolute(topology.ToAbsolute(1, 0, 0), topology.ToAbsolute(1920, 0)));
+   CHECK(SameAbsolute(topology.ToAbsolute(1, 1919, 1079), topology.ToAbsolute(3839, 1079)));
+
+   CHECK(RoundTripFailures(topology) == 0);
+}
+
+static void NegativeOriginShouldBeTheStartOfTheRange() {
+   DesktopTopology topology(leftAndAbove);
+
+   auto &bounds = topology.VirtualBounds();
+
+   CHECK(bounds.Left == -2560 && bounds.Top == -360 && bounds.Right == 1920 && bounds.Bottom == 1080);
+
+   CHECK(SameAbsolute(topology.ToAbsolute(-2560, -360), AbsolutePoint { 0, 0 }));
+   CHECK(SameAbsolute(topology.ToAbsolute(1, 0, 0), AbsolutePoint { 0, 0 }));
+
+   // The primary's origin isn't the desktop's
+   auto primary = topology.ToAbsolute(0, 0);
+
+   CHECK(primary.X > 0 && primary.Y > 0);
+   CHECK(SameAbsolute(topology.ToAbsolute(0, 0, 0), primary));
+
+   // Monitor-relative points match the same points given on the desktop
+   for (auto x : { 0, 1, 1279, 2558, 2559 }) {
+      for (auto y : { 0, 1, 719, 1438, 1439 })
+         CHECK(SameAbsolute(topology.ToAbsolute(1, x, y), topology.ToAbsolute(-2560 + x, -360 + y)));
+   }
+
+   // Above the primary goes to whichever monitor is nearer
+   CHECK(topology.MonitorFromPoint(1000, -200) == 0);
+   CHECK(topology.MonitorFromPoint(100, -200) == 1);
+   CHECK(topology.MonitorFromPoint(-1, -200) == 1);
+
+   CHECK(RoundTripFailures(topology) == 0);
+}
+
+static void MixedDpiShouldScaleByMonitor() {
+   DesktopTopology topology({
+      { { 0, 0, 1920, 1080 }, 96 },
+      { { -2560, -360, 0, 1080 }, 144 },
+      { { 1920, 0, 5760, 2160 }, 192 },
+      { { 0, 1080, 1280, 1880 }, 0 },
+   });
+
+   CHECK(topology.ScaleAt(500, 500) == 1.0);
+   CHECK(topology.ScaleAt(-1, 0) == 1.5);
+   CHECK(topology.ScaleAt(1920, 2159) == 2.0);
+
+   // An unknown DPI counts as 100%
+   CHECK(topology.ScaleAt(10, 1500) == 1.0);
+
+   // Off the desktop, the nearest monitor's scale
+   CHECK(topology.ScaleAt(9000, 100) == 2.0);
+   CHECK(topology.ScaleAt(-9000, 100) == 1.5);
+
+   // Scale doesn't change the mapping, which is in physical pixels
+   CHECK(SameAbsolute(topology.ToAbsolute(2, 0, 0), topology.ToAbsolute(1920, 0)));
+
+   CHECK(RoundTripFailures(topology) == 0);
+}
+
+static void PixelsShouldRoundTripOnOddSizedDesktops() {
+   // Sizes that don't divide 65536, so every pixel's normalized point is rounded
+   for (auto width : { 1, 3, 1366, 1921, 3007, 7680 }) {
+      for (auto height : { 1, 7, 768, 1081 }) {
+         DesktopTopology topology({ { { -width / 3, -height / 2, width - width / 3, height - height / 2 }, 96 } });
+
+         auto failures = 0;
+
+         for (auto x = topology.VirtualBounds().Left; x < topology.VirtualBounds().Right; x++) {
+            for (auto y : { topology.VirtualBounds().Top, topology.VirtualBounds().Bottom - 1 }) {
+               if (RoundTrips(topology, x, y) == false)
+                  failures++;
+            }
+         }
+
+         CHECK(failures == 0);
+         CHECK(RoundTripFailures(topology) == 0);
+      }
+   }
+}
+
+static void NoMonitorsShouldStillConvert() {
+   DesktopTopology topology({});
+
+   CHECK(topology.MonitorCount() == 0);
+   CHECK(topology.MonitorFromPoint(0, 0) == -1);
+   CHECK(topology.ScaleAt(0, 0) == 1.0);
+   CHECK(SameAbsolute(topology.ToAbsolute(100, 100), AbsolutePoint { 0, 0 }));
+}
+
+static void UnknownMonitorShouldThrow() {
+   DesktopTopology topology(leftAndAbove);
+
+   auto threw = false;
+
+   try {
+      topology.ToAbsolute(2, 0, 0);
+   } catch (const std::out_of_range &) {
+      threw = true;
+   }
+
+   CHECK(threw == true);
+}
+
+int main() {
+   RUN(SingleMonitorShouldMapOntoTheWholeRange);
+   RUN(SideBySideMonitorsShouldShareTheRange);
+   RUN(NegativeOriginShouldBeTheStartOfTheRange);
+   RUN(MixedDpiShouldScaleByMonitor);
+   RUN(PixelsShouldRoundTripOnOddSizedDesktops);
+   RUN(NoMonitorsShouldStillConvert);
+   RUN(UnknownMonitorShouldThrow);
+
+   return Renfrew::Tests::Result();
+}
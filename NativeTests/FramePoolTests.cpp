@@ -0,0 +1,136 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "Check.h"
+#include "FramePool.h"
+
+using namespace Renfrew::Utility;
+
+static void ReservedFramesShouldBeReused() {
+   FramePool pool(2);
+
+   pool.Reserve(100, 50);
+   CHECK(pool.Allocations() == 2);
+
+   for (auto i = 0; i < 10; i++) {
+      auto a = pool.Acquire(100, 50);
+      auto b = pool.Acquire(100, 50);
+
+      CHECK(a->Pixels() != b->Pixels());
+   }
+
+   CHECK(pool.Allocations() == 2);
+}
+
+static void RowsShouldBeAligned() {
+   FramePool pool(1);
+
+   for (auto width : { 1, 7, 8, 100, 333 }) {
+      auto frame = pool.Acquire(width, 3);
+
+      CHECK(reinterpret_cast<std::uintptr_t>(frame->Pixels()) % 32 == 0);
+      CHECK(frame->Stride() >= width && frame->Stride() % 8 == 0);
+      CHECK(frame->View().Stride == frame->Stride() && frame->ConstView().Width == width);
+   }
+}
+
+static void ExtraFramesShouldNotBeKept() {
+   FramePool pool(2);
+
+   pool.Reserve(100, 50);
+
+   {
+      auto a = pool.Acquire(100, 50);
+      auto b = pool.Acquire(100, 50);
+      auto c = pool.Acquire(100, 50);
+
+      CHECK(pool.Allocations() == 3);
+   }
+
+   auto a = pool.Acquire(100, 50);
+   auto b = pool.Acquire(100, 50);
+
+   CHECK(pool.Allocations() == 3);
+
+   // Still full, so the extra frame must have been freed, not pooled
+   auto c = pool.Acquire(100, 50);
+   CHECK(pool.Allocations() == 4);
+}
+
+static void NewSizesShouldReplaceIdleFrames() {
+   FramePool pool(1);
+
+   pool.Reserve(100, 50);
+
+   {
+      auto frame = pool.Acquire(10, 10);
+      CHECK(frame->Width() == 10 && frame->Height() == 10);
+   }
+
+   CHECK(pool.Allocations() == 2);
+
+   auto frame = pool.Acquire(10, 10);
+   CHECK(pool.Allocations() == 2);
+}
+
+static void FramesShouldOutliveTheirPool() {
+   FrameHandle frame;
+
+   {
+      FramePool pool(1);
+      frame = pool.Acquire(5, 5);
+   }
+
+   frame->Pixels()[24] = 1;
+   frame.reset();
+}
+
+static void ThreadsShouldShareThePool() {
+   FramePool pool(4);
+   std::vector<std::thread> threads;
+
+   pool.Reserve(100, 50);
+
+   for (auto t = 0; t < 4; t++) {
+      threads.emplace_back([&pool] {
+         for (auto i = 0; i < 10000; i++) {
+            auto frame = pool.Acquire(100, 50);
+            frame->Pixels()[0] = i;
+         }
+      });
+   }
+
+   for (auto &thread : threads)
+      thread.join();
+
+   CHECK(pool.Allocations() == 4);
+}
+
+int main() {
+   RUN(ReservedFramesShouldBeReused);
+   RUN(RowsShouldBeAligned);
+   RUN(ExtraFramesShouldNotBeKept);
+   RUN(NewSizesShouldReplaceIdleFrames);
+   RUN(FramesShouldOutliveTheirPool);
+   RUN(ThreadsShouldShareThePool);
+
+   return Renfrew::Tests::Result();
+}
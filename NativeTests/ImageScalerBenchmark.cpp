@@ -0,0 +1,82 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "ImageScaler.h"
+
+using namespace Renfrew::Tests;
+using namespace Renfrew::Utility;
+
+// Each scaling path against the reference, for the sizes the magnifier uses: a
+// cell zoomed 3x at 100% and 150% display scale, and a whole screen.
+int main() {
+   const char *PathNames[] = { "scalar", "sse2", "avx2" };
+   const char *FilterNames[] = { "nearest", "bilinear" };
+
+   const int Sizes[][4] = {
+      { 100, 100, 300, 300 },
+      { 150, 150, 450, 450 },
+      { 640, 360, 1920, 1080 },
+   };
+
+   std::printf("Best path on this processor: %s\n\n", PathNames[static_cast<int>(DetectSimdLevel())]);
+
+   std::mt19937 random(1);
+
+   for (auto &size : Sizes) {
+      std::vector<std::uint32_t> source(size[0] * size[1]);
+      std::vector<std::uint32_t> destination(size[2] * size[3]);
+
+      for (auto &pixel : source)
+         pixel = random();
+
+      ConstImageView sourceView { source.data(), size[0], size[1], size[0] };
+      ImageView destinationView { destination.data(), size[2], size[3], size[2] };
+
+      for (auto filter : { ScaleFilter::Nearest, ScaleFilter::Bilinear }) {
+         auto prefix = std::to_string(size[0]) + "x" + std::to_string(size[1]) + " -> " +
+                       std::to_string(size[2]) + "x" + std::to_string(size[3]) + " " +
+                       FilterNames[static_cast<int>(filter)];
+
+         auto reference = MedianMilliseconds([&] {
+            ImageScaler::ScaleReference(sourceView, destinationView, filter);
+         });
+
+         Report((prefix + " reference").c_str(), reference);
+
+         for (auto path : { SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2 }) {
+            ImageScaler scaler(path);
+
+            if (scaler.Path() != path)
+               continue;
+
+            auto time = MedianMilliseconds([&] {
+               scaler.Scale(sourceView, destinationView, filter);
+            });
+
+            std::printf("%-40s %10.3f ms  (%.1fx the reference)\n",
+                        (prefix + " " + PathNames[static_cast<int>(path)]).c_str(), time, reference / time);
+         }
+      }
+   }
+
+   return 0;
+}
@@ -0,0 +1,161 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include <random>
+#include <vector>
+
+#include "Check.h"
+#include "ImageScaler.h"
+
+using namespace Renfrew::Utility;
+
+static const SimdLevel Paths[] = { SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2 };
+static const ScaleFilter Filters[] = { ScaleFilter::Nearest, ScaleFilter::Bilinear };
+
+// Scales a random image with every path, checking each against the reference.
+// The rows are given extra room on both sides (a stride wider than the image)
+// and the destination's spare pixels must be left alone.
+static int CountMismatches(std::mt19937 &random, int sourceWidth, int sourceHeight,
+                           int width, int height, ScaleFilter filter) {
+   const std::uint32_t Untouched = 0xDEADBEEF;
+
+   auto sourceStride = sourceWidth + 3;
+   auto stride = width + 5;
+
+   std::vector<std::uint32_t> source(sourceStride * sourceHeight);
+
+   for (auto &pixel : source)
+      pixel = random();
+
+   ConstImageView sourceView { source.data(), sourceWidth, sourceHeight, sourceStride };
+
+   std::vector<std::uint32_t> expected(stride * height, Untouched);
+   ImageScaler::ScaleReference(sourceView, ImageView { expected.data(), width, height, stride }, filter);
+
+   auto mismatches = 0;
+
+   for (auto path : Paths) {
+      ImageScaler scaler(path);
+      std::vector<std::uint32_t> actual(stride * height, Untouched);
+
+      scaler.Scale(sourceView, ImageView { actual.data(), width, height, stride }, filter);
+
+      if (actual != expected) {
+         std::fprintf(stderr, "   %dx%d -> %dx%d, filter %d, path %d\n",
+                      sourceWidth, sourceHeight, width, height, static_cast<int>(filter), static_cast<int>(path));
+         mismatches++;
+      }
+   }
+
+   return mismatches;
+}
+
+static void EveryPathShouldMatchTheReference() {
+   std::mt19937 random(1);
+
+   const int Sizes[][4] = {
+      { 100, 100, 300, 300 },    // 3x zoom
+      { 150, 150, 450, 450 },    // 3x zoom of a cell on a 150% screen
+      { 150, 150, 337, 341 },    // Fractional, and not the same both ways
+      { 37, 23, 111, 70 },
+      { 64, 64, 64, 64 },        // Same size
+      { 300, 300, 450, 450 },
+      { 5, 3, 1, 1 },            // Shrinking
+      { 1, 1, 5, 7 },            // A single source pixel
+      { 7, 9, 300, 2 },
+      { 33, 17, 67, 35 },        // Widths that aren't a multiple of any vector
+   };
+
+   for (auto &size : Sizes) {
+      for (auto filter : Filters)
+         CHECK(CountMismatches(random, size[0], size[1], size[2], size[3], filter) == 0);
+   }
+}
+
+static void RandomSizesShouldMatchTheReference() {
+   std::mt19937 random(2);
+   std::uniform_int_distribution<int> dimension(1, 200);
+
+   auto mismatches = 0;
+
+   for (auto i = 0; i < 200; i++) {
+      for (auto filter : Filters)
+         mismatches += CountMismatches(random, dimension(random), dimension(random), dimension(random), dimension(random), filter);
+   }
+
+   CHECK(mismatches == 0);
+}
+
+static void WholeNumberNearestShouldRepeatPixels() {
+   const std::uint32_t Source[] = { 0xFF112233, 0xFF445566, 0x80778899, 0x00AABBCC };
+
+   for (auto path : Paths) {
+      ImageScaler scaler(path);
+      std::vector<std::uint32_t> destination(6 * 6);
+
+      scaler.Scale(ConstImageView { Source, 2, 2, 2 }, ImageView { destination.data(), 6, 6, 6 }, ScaleFilter::Nearest);
+
+      auto wrong = 0;
+
+      for (auto y = 0; y < 6; y++) {
+         for (auto x = 0; x < 6; x++) {
+            if (destination[y * 6 + x] != Source[(y / 3) * 2 + x / 3])
+               wrong++;
+         }
+      }
+
+      CHECK(wrong == 0);
+   }
+}
+
+static void BilinearShouldKeepAFlatImageFlat() {
+   std::vector<std::uint32_t> source(40 * 30, 0x7F3A9CE1);
+
+   for (auto path : Paths) {
+      ImageScaler scaler(path);
+      std::vector<std::uint32_t> destination(113 * 97);
+
+      scaler.Scale(ConstImageView { source.data(), 40, 30, 40 }, ImageView { destination.data(), 113, 97, 113 }, ScaleFilter::Bilinear);
+
+      auto wrong = 0;
+
+      for (auto pixel : destination) {
+         if (pixel != 0x7F3A9CE1)
+            wrong++;
+      }
+
+      CHECK(wrong == 0);
+   }
+}
+
+static void PathShouldFallBackToWhatTheProcessorSupports() {
+   auto best = DetectSimdLevel();
+
+   CHECK(ImageScaler().Path() == best);
+   CHECK(ImageScaler(SimdLevel::Scalar).Path() == SimdLevel::Scalar);
+   CHECK(ImageScaler(SimdLevel::Avx2).Path() <= best);
+}
+
+int main() {
+   RUN(EveryPathShouldMatchTheReference);
+   RUN(RandomSizesShouldMatchTheReference);
+   RUN(WholeNumberNearestShouldRepeatPixels);
+   RUN(BilinearShouldKeepAFlatImageFlat);
+   RUN(PathShouldFallBackToWhatTheProcessorSupports);
+
+   return Renfrew::Tests::Result();
+}
@@ -0,0 +1,281 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Screenshots.h"
+
+using namespace Renfrew::Tests;
+using namespace Renfrew::Utility;
+
+// Draws the target detection screenshots: plot cells over the usual Windows 10
+// controls, in the light and dark themes, at 100% and 150% display scale. They
+// are drawn rather than captured so that what should be found in each is known
+// exactly (and so they can be remade the same way on any machine).
+//
+//    MakeTargetFixtures <fixtures directory>
+
+namespace {
+
+   struct Theme {
+      std::uint32_t Window;
+      std::uint32_t Text;
+      std::uint32_t Fringe;
+      std::uint32_t Button;
+      std::uint32_t ButtonBorder;
+      std::uint32_t Box;
+      std::uint32_t BoxBorder;
+   };
+
+   const Theme Light {
+      0xFFF0F0F0, 0xFF000000, 0xFF8A8A8A, 0xFFE1E1E1, 0xFFADADAD, 0xFFFFFFFF, 0xFF7A7A7A
+   };
+
+   const Theme Dark {
+      0xFF202020, 0xFFFFFFFF, 0xFF909090, 0xFF333333, 0xFF9B9B9B, 0xFF191919, 0xFF858585
+   };
+
+   class Canvas {
+      private: double _scale;
+      private: Theme _theme;
+
+      public: Screenshot Image;
+
+      public: Canvas(const std::string &name, double scale, const Theme &theme) {
+         _scale = scale;
+         _theme = theme;
+
+         // A plot cell is 100 x 100 DIPs
+         Image.Name = name;
+         Image.Width = Scale(100);
+         Image.Height = Scale(100);
+         Image.Pixels.assign(static_cast<std::size_t>(Image.Width) * Image.Height, theme.Window);
+      }
+
+      public: int Scale(double dips) const {
+         return static_cast<int>(std::lround(dips * _scale));
+      }
+
+      public: void Fill(int left, int top, int width, int height, std::uint32_t colour) {
+         for (auto y = std::max(0, top); y < std::min(Image.Height, top + height); y++) {
+            for (auto x = std::max(0, left); x < std::min(Image.Width, left + width); x++)
+               Image.Pixels[y * Image.Width + x] = colour;
+         }
+      }
+
+      public: void Frame(int left, int top, int width, int height, std::uint32_t colour) {
+         auto thickness = std::max(1, Scale(1));
+
+         Fill(left, top, width, thickness, colour);
+         Fill(left, top + height - thickness, width, thickness, colour);
+         Fill(left, top, thickness, height, colour);
+         Fill(left + width - thickness, top, thickness, height, colour);
+      }
+
+      // Text is stood in for by made-up letters (stems and bars picked from the
+      // character), with a half-tone fringe on the right like ClearType leaves.
+      public: Target Text(double leftDips, double topDips, const std::string &text) {
+         auto glyphWidth = Scale(5);
+         auto glyphHeight = Scale(7);
+         auto stroke = std::max(1, Scale(1));
+         auto left = Scale(leftDips);
+         auto top = Scale(topDips);
+         auto x = left;
+
+         for (auto c : text) {
+            if (c == ' ') {
+               x += Scale(4);
+               continue;
+            }
+
+            auto bits = static_cast<unsigned>(c) * 2654435761u;
+
+            Fill(x, top, stroke, glyphHeight, _theme.Text);
+
+            if ((bits & 0x100) != 0)
+               Fill(x + glyphWidth - stroke, top, stroke, glyphHeight, _theme.Text);
+
+            Fill(x, top + ((bits & 0x200) != 0 ? 0 : glyphHeight / 2), glyphWidth, stroke, _theme.Text);
+
+            if ((bits & 0x400) != 0)
+               Fill(x, top + glyphHeight - stroke, glyphWidth, stroke, _theme.Text);
+
+            Fill(x + glyphWidth, top, 1, glyphHeight, _theme.Fringe);
+
+            x += glyphWidth + Scale(1.5);
+         }
+
+         return Target { left, top, x - Scale(1.5) + 1 - left, glyphHeight };
+      }
+
+      public: Target Button(double left, double top, double width, double height, const std::string &label) {
+         Target bounds { Scale(left), Scale(top), Scale(width), Scale(height) };
+
+         Fill(bounds.Left, bounds.Top, bounds.Width, bounds.Height, _theme.Button);
+         Frame(bounds.Left, bounds.Top, bounds.Width, bounds.Height, _theme.ButtonBorder);
+         Text(left + 6, top + (height - 7) / 2, label);
+
+         return bounds;
+      }
+
+      public: Target TextBox(double left, double top, double width, double height, const std::string &text) {
+         Target bounds { Scale(left), Scale(top), Scale(width), Scale(height) };
+
+         Fill(bounds.Left, bounds.Top, bounds.Width, bounds.Height, _theme.Box);
+         Frame(bounds.Left, bounds.Top, bounds.Width, bounds.Height, _theme.BoxBorder);
+         Text(left + 4, top + (height - 7) / 2, text);
+
+         return bounds;
+      }
+
+      // The box and its label are separate targets
+      public: std::vector<Target> CheckBox(double left, double top, bool checked, const std::string &label) {
+         Target box { Scale(left), Scale(top), Scale(13), Scale(13) };
+
+         Fill(box.Left, box.Top, box.Width, box.Height, _theme.Box);
+         Frame(box.Left, box.Top, box.Width, box.Height, _theme.Text);
+
+         if (checked == true)
+            Fill(Scale(left + 3), Scale(top + 3), Scale(7), Scale(7), _theme.Text);
+
+         return { box, Text(left + 18, top + 3, label) };
+      }
+
+      public: Target Icon(double left, double top, std::uint32_t colour) {
+         Target bounds { Scale(left), Scale(top), Scale(16), Scale(16) };
+
+         Fill(bounds.Left, bounds.Top, bounds.Width, bounds.Height, colour);
+         Fill(Scale(left + 4), Scale(top + 4), Scale(8), Scale(8), _theme.Window);
+
+         return bounds;
+      }
+
+      // Keeps only the on-screen part of a target (it's what the detector sees)
+      public: static Target Clip(const Target &target, int width, int height) {
+         auto left = std::max(0, target.Left);
+         auto top = std::max(0, target.Top);
+         auto right = std::min(width, target.Left + target.Width);
+         auto bottom = std::min(height, target.Top + target.Height);
+
+         return Target { left, top, right - left, bottom - top };
+      }
+   };
+
+   struct Fixture {
+      Screenshot Image;
+      std::vector<Target> Targets;
+   };
+
+   // A dialog: two buttons, a check box and a text box
+   Fixture Dialog(const std::string &name, double scale, const Theme &theme) {
+      Canvas canvas(name, scale, theme);
+      std::vector<Target> targets;
+
+      targets.push_back(canvas.Button(6, 8, 40, 22, "OK"));
+      targets.push_back(canvas.Button(52, 8, 42, 22, "Apply"));
+
+      for (auto &target : canvas.CheckBox(8, 44, true, "Wrap"))
+         targets.push_back(target);
+
+      targets.push_back(canvas.TextBox(6, 70, 88, 20, "Name"));
+
+      return Fixture { canvas.Image, targets };
+   }
+
+   // A toolbar of icons over a row of menu words, cut off by the cell's edges
+   Fixture Toolbar(const std::string &name, double scale, const Theme &theme) {
+      Canvas canvas(name, scale, theme);
+      std::vector<Target> targets;
+
+      targets.push_back(canvas.Text(4, 6, "File"));
+      targets.push_back(canvas.Text(38, 6, "Edit"));
+      targets.push_back(canvas.Text(72, 6, "View"));
+
+      targets.push_back(canvas.Icon(-8, 30, 0xFF2B79D0));
+      targets.push_back(canvas.Icon(16, 30, 0xFF3A9A3A));
+      targets.push_back(canvas.Icon(40, 30, 0xFFD04040));
+      targets.push_back(canvas.Icon(64, 30, 0xFFE0A020));
+      targets.push_back(canvas.Icon(88, 30, 0xFF7A3AB0));
+
+      targets.push_back(canvas.Button(10, 66, 60, 24, "Cancel"));
+
+      for (auto &target : targets)
+         target = Canvas::Clip(target, canvas.Image.Width, canvas.Image.Height);
+
+      return Fixture { canvas.Image, targets };
+   }
+
+   // Nothing to click: a plain window with a gentle gradient
+   Fixture Empty(const std::string &name, double scale, const Theme &theme) {
+      Canvas canvas(name, scale, theme);
+
+      for (auto y = 0; y < canvas.Image.Height; y++) {
+         auto shade = static_cast<std::uint32_t>(y * 12 / canvas.Image.Height);
+
+         for (auto x = 0; x < canvas.Image.Width; x++)
+            canvas.Image.Pixels[y * canvas.Image.Width + x] = theme.Window - shade * 0x010101;
+      }
+
+      return Fixture { canvas.Image, {} };
+   }
+}
+
+int main(int argc, char *argv[]) {
+   if (argc < 2) {
+      std::fprintf(stderr, "Usage: MakeTargetFixtures <fixtures directory>\n");
+      return 1;
+   }
+
+   std::string directory = argv[1];
+   std::vector<Fixture> fixtures;
+
+   for (auto scale : { 100, 150 }) {
+      auto suffix = "_" + std::to_string(scale) + ".ppm";
+
+      fixtures.push_back(Dialog("DialogLight" + suffix, scale / 100.0, Light));
+      fixtures.push_back(Dialog("DialogDark" + suffix, scale / 100.0, Dark));
+      fixtures.push_back(Toolbar("ToolbarLight" + suffix, scale / 100.0, Light));
+      fixtures.push_back(Empty("EmptyLight" + suffix, scale / 100.0, Light));
+   }
+
+   std::ofstream list(directory + "/Targets.txt");
+
+   list << "# Made by MakeTargetFixtures. A line per target: file, left, top, width, height\n";
+   list << "# (in pixels). A file with nothing to find is listed with an empty target.\n";
+
+   for (auto &fixture : fixtures) {
+      if (WritePpm(directory + "/" + fixture.Image.Name, fixture.Image) == false) {
+         std::fprintf(stderr, "Couldn't write %s.\n", fixture.Image.Name.c_str());
+         return 1;
+      }
+
+      if (fixture.Targets.empty() == true)
+         list << fixture.Image.Name << " 0 0 0 0\n";
+
+      for (auto &target : fixture.Targets) {
+         list << fixture.Image.Name << " " << target.Left << " " << target.Top << " "
+              << target.Width << " " << target.Height << "\n";
+      }
+   }
+
+   return list.good() == true ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "TargetDetector.h"
+
+// The stored screenshots the target detection is checked (and timed) against.
+// Each is a binary PPM; Targets.txt lists what should be found in each one.
+
+namespace Renfrew::Tests {
+
+   struct Screenshot {
+      std::string Name;
+      int Width = 0;
+      int Height = 0;
+
+      // BGRA, as captured
+      std::vector<std::uint32_t> Pixels;
+
+      std::vector<Renfrew::Utility::Target> Expected;
+
+      Renfrew::Utility::ConstImageView View() const {
+         return Renfrew::Utility::ConstImageView { Pixels.data(), Width, Height, Width };
+      }
+   };
+
+   inline std::string FixturePath(const std::string &name) {
+      return std::string(RENFREW_FIXTURES_DIR) + "/" + name;
+   }
+
+   inline bool ReadPpm(const std::string &path, Screenshot &screenshot) {
+      std::ifstream file(path, std::ios::binary);
+      std::string magic;
+      int maximum = 0;
+
+      file >> magic >> screenshot.Width >> screenshot.Height >> maximum;
+      file.get();
+
+      if (file.good() == false || magic != "P6" || maximum != 255)
+         return false;
+
+      std::vector<unsigned char> rgb(static_cast<std::size_t>(screenshot.Width) * screenshot.Height * 3);
+      file.read(reinterpret_cast<char *>(rgb.data()), rgb.size());
+
+      if (file.gcount() != static_cast<std::streamsize>(rgb.size()))
+         return false;
+
+      screenshot.Pixels.resize(rgb.size() / 3);
+
+      for (std::size_t i = 0; i < screenshot.Pixels.size(); i++) {
+         screenshot.Pixels[i] = 0xFF000000u |
+            (static_cast<std::uint32_t>(rgb[i * 3]) << 16) |
+            (static_cast<std::uint32_t>(rgb[i * 3 + 1]) << 8) |
+            rgb[i * 3 + 2];
+      }
+
+      return true;
+   }
+
+   inline bool WritePpm(const std::string &path, const Screenshot &screenshot) {
+      std::ofstream file(path, std::ios::binary);
+
+      file << "P6\n" << screenshot.Width << " " << screenshot.Height << "\n255\n";
+
+      for (auto pixel : screenshot.Pixels) {
+         file.put(static_cast<char>((pixel >> 16) & 0xFF));
+         file.put(static_cast<char>((pixel >> 8) & 0xFF));
+         file.put(static_cast<char>(pixel & 0xFF));
+      }
+
+      return file.good();
+   }
+
+   /// <summary>
+   /// Loads every screenshot listed in Targets.txt, which has a line per target:
+   /// the file, then the target's left, top, width and height.
+   /// </summary>
+   inline std::vector<Screenshot> LoadScreenshots() {
+      std::vector<Screenshot> screenshots;
+      std::ifstream list(FixturePath("Targets.txt"));
+      std::string line;
+
+      while (std::getline(list, line)) {
+         if (line.empty() == true || line[0] == '#')
+            continue;
+
+         std::istringstream fields(line);
+         std::string name;
+         Renfrew::Utility::Target target;
+
+         fields >> name >> target.Left >> target.Top >> target.Width >> target.Height;
+
+         if (screenshots.empty() == true || screenshots.back().Name != name) {
+            screenshots.emplace_back();
+            screenshots.back().Name = name;
+
+            if (ReadPpm(FixturePath(name), screenshots.back()) == false) {
+               screenshots.pop_back();
+               continue;
+            }
+         }
+
+         // An empty target just lists a screenshot with nothing to find
+         if (target.Width > 0 && target.Height > 0)
+            screenshots.back().Expected.push_back(target);
+      }
+
+      return screenshots;
+   }
+}
@@ -0,0 +1,90 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Screenshots.h"
+#include "TargetDetector.h"
+
+using namespace Renfrew::Tests;
+using namespace Renfrew::Utility;
+
+// Target detection on each of the stored screenshots with each path, then the
+// stages on their own for the largest (a cell at 150% display scale). A zoom
+// has to find its targets in well under a frame.
+int main() {
+   const char *PathNames[] = { "scalar", "sse2", "avx2" };
+   auto screenshots = LoadScreenshots();
+
+   if (screenshots.empty() == true) {
+      std::fprintf(stderr, "No screenshots in %s.\n", RENFREW_FIXTURES_DIR);
+      return 1;
+   }
+
+   for (auto &screenshot : screenshots) {
+      for (auto path : { SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2 }) {
+         TargetDetector detector(TargetOptions(), path);
+         std::vector<Target> targets;
+
+         if (detector.Path() != path)
+            continue;
+
+         auto time = MedianMilliseconds([&] {
+            detector.Detect(screenshot.View(), targets);
+         });
+
+         Report((screenshot.Name + " " + PathNames[static_cast<int>(path)]).c_str(), time);
+      }
+   }
+
+   auto &largest = screenshots.back();
+   auto width = largest.Width;
+   auto height = largest.Height;
+
+   std::printf("\nStages, %dx%d:\n", width, height);
+
+   for (auto path : { SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2 }) {
+      TargetDetector detector(TargetOptions(), path);
+      std::vector<std::uint8_t> grey, edges, thick;
+      std::vector<Target> components;
+
+      if (detector.Path() != path)
+         continue;
+
+      std::string name = PathNames[static_cast<int>(path)];
+
+      Report(("grey " + name).c_str(), MedianMilliseconds([&] {
+         detector.Grey(largest.View(), grey);
+      }));
+
+      Report(("edges " + name).c_str(), MedianMilliseconds([&] {
+         detector.Edges(grey, width, height, edges);
+      }));
+
+      Report(("thicken " + name).c_str(), MedianMilliseconds([&] {
+         detector.Thicken(edges, width, height, thick);
+      }));
+
+      Report(("components " + name).c_str(), MedianMilliseconds([&] {
+         detector.Components(thick, width, height, components);
+      }));
+   }
+
+   return 0;
+}
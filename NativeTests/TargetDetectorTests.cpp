@@ -0,0 +1,240 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "Check.h"
+#include "Screenshots.h"
+#include "TargetDetector.h"
+
+using namespace Renfrew::Tests;
+using namespace Renfrew::Utility;
+
+static const SimdLevel Paths[] = { SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2 };
+
+// Random noise, or blocks of black and white (plenty of edges), in images of
+// awkward sizes with strides wider than they are. The padding past the width is
+// a bright colour that would show up as edges if a path read into it.
+static std::vector<std::uint32_t> RandomImage(std::mt19937 &random, int width, int height, int stride, bool blocky) {
+   std::vector<std::uint32_t> image(stride * height);
+
+   for (auto y = 0; y < height; y++) {
+      for (auto x = 0; x < stride; x++) {
+         if (x >= width)
+            image[y * stride + x] = 0xFFFF00FF;
+         else if (blocky == true)
+            image[y * stride + x] = (x / 7 + y / 5) % 3 == 0 ? 0xFFFFFFFF : 0xFF202020;
+         else
+            image[y * stride + x] = random();
+      }
+   }
+
+   return image;
+}
+
+static void EveryPathShouldMatchTheScalarStages() {
+   std::mt19937 random(5);
+   auto mismatches = 0;
+
+   for (auto i = 0; i < 300; i++) {
+      auto width = 3 + static_cast<int>(random() % 120);
+      auto height = 3 + static_cast<int>(random() % 60);
+      auto stride = width + static_cast<int>(random() % 5);
+      auto image = RandomImage(random, width, height, stride, i % 2 == 1);
+
+      ConstImageView view { image.data(), width, height, stride };
+
+      TargetDetector scalar(TargetOptions(), SimdLevel::Scalar);
+      std::vector<std::uint8_t> grey, edges, thick;
+
+      scalar.Grey(view, grey);
+      scalar.Edges(grey, width, height, edges);
+      scalar.Thicken(edges, width, height, thick);
+
+      for (auto path : Paths) {
+         TargetDetector detector(TargetOptions(), path);
+         std::vector<std::uint8_t> pathGrey, pathEdges, pathThick;
+
+         detector.Grey(view, pathGrey);
+         detector.Edges(grey, width, height, pathEdges);
+         detector.Thicken(edges, width, height, pathThick);
+
+         if (pathGrey != grey || pathEdges != edges || pathThick != thick)
+            mismatches++;
+      }
+   }
+
+   CHECK(mismatches == 0);
+}
+
+static void ThickenShouldTakeTheMaximumOfEachBlock() {
+   std::mt19937 random(6);
+
+   auto width = 37;
+   auto height = 23;
+   std::vector<std::uint8_t> edges(width * height);
+
+   for (auto &e : edges)
+      e = random() % 10 == 0 ? 255 : 0;
+
+   for (auto path : Paths) {
+      TargetDetector detector(TargetOptions(), path);
+      std::vector<std::uint8_t> thick;
+
+      detector.Thicken(edges, width, height, thick);
+
+      auto wrong = 0;
+
+      for (auto y = 0; y < height; y++) {
+         for (auto x = 0; x < width; x++) {
+            std::uint8_t maximum = 0;
+
+            for (auto dy = -1; dy <= 1; dy++) {
+               for (auto dx = -1; dx <= 1; dx++) {
+                  if (y + dy >= 0 && y + dy < height && x + dx >= 0 && x + dx < width)
+                     maximum = std::max(maximum, edges[(y + dy) * width + x + dx]);
+               }
+            }
+
+            if (thick[y * width + x] != maximum)
+               wrong++;
+         }
+      }
+
+      CHECK(wrong == 0);
+   }
+}
+
+static void ScreenshotsShouldAllHaveLoaded() {
+   CHECK(LoadScreenshots().size() == 8);
+}
+
+static void EveryPathShouldFindTheSameTargets() {
+   for (auto &screenshot : LoadScreenshots()) {
+      std::vector<Target> expected;
+      TargetDetector(TargetOptions(), SimdLevel::Scalar).Detect(screenshot.View(), expected);
+
+      for (auto path : Paths) {
+         std::vector<Target> targets;
+         TargetDetector(TargetOptions(), path).Detect(screenshot.View(), targets);
+
+         auto same = targets.size() == expected.size() &&
+            std::equal(targets.begin(), targets.end(), expected.begin(), [](const Target &a, const Target &b) {
+               return a.Left == b.Left && a.Top == b.Top && a.Width == b.Width && a.Height == b.Height;
+            });
+
+         CHECK(same == true);
+      }
+   }
+}
+
+// Every control in the screenshots must be found (once), close enough to its
+// real bounds that the cursor snaps to its middle; nothing else may be found.
+static void TargetsInScreenshotsShouldBeFound() {
+   const int Slack = 2;
+
+   auto expected = 0;
+   auto found = 0;
+   auto spurious = 0;
+
+   for (auto &screenshot : LoadScreenshots()) {
+      TargetDetector detector;
+      std::vector<Target> targets;
+
+      detector.Detect(screenshot.View(), targets);
+
+      std::vector<bool> used(targets.size(), false);
+
+      for (auto &control : screenshot.Expected) {
+         expected++;
+
+         for (std::size_t i = 0; i < targets.size(); i++) {
+            auto &t = targets[i];
+
+            auto close = std::abs(t.Left - control.Left) <= Slack &&
+                         std::abs(t.Top - control.Top) <= Slack &&
+                         std::abs(t.Left + t.Width - control.Left - control.Width) <= Slack &&
+                         std::abs(t.Top + t.Height - control.Top - control.Height) <= Slack;
+
+            if (close == true && used[i] == false) {
+               used[i] = true;
+               found++;
+               break;
+            }
+         }
+      }
+
+      spurious += static_cast<int>(std::count(used.begin(), used.end(), false));
+
+      if (static_cast<int>(targets.size()) != static_cast<int>(screenshot.Expected.size()))
+         std::fprintf(stderr, "   %s: %zu targets, expected %zu\n", screenshot.Name.c_str(), targets.size(), screenshot.Expected.size());
+   }
+
+   std::printf("   %d of %d targets found, %d spurious\n", found, expected, spurious);
+
+   CHECK(found == expected);
+   CHECK(spurious == 0);
+}
+
+static void TargetsShouldBeLimited() {
+   const int Size = 150;
+
+   // A row of five squares, well apart
+   std::vector<std::uint32_t> image(Size * Size, 0xFFF0F0F0);
+
+   for (auto square = 0; square < 5; square++) {
+      for (auto y = 60; y < 75; y++) {
+         for (auto x = 0; x < 15; x++)
+            image[y * Size + 10 + square * 28 + x] = 0xFF202020;
+      }
+   }
+
+   std::vector<Target> targets;
+
+   TargetDetector().Detect(ConstImageView { image.data(), Size, Size, Size }, targets);
+   CHECK(targets.size() == 5);
+
+   TargetOptions options;
+   options.MaximumTargets = 3;
+
+   TargetDetector(options).Detect(ConstImageView { image.data(), Size, Size, Size }, targets);
+   CHECK(targets.size() == 3);
+}
+
+static void TinyImagesShouldHaveNoTargets() {
+   std::uint32_t pixels[4] = { 0, 0xFFFFFFFF, 0, 0xFFFFFFFF };
+   std::vector<Target> targets = { Target { 1, 2, 3, 4 } };
+
+   TargetDetector().Detect(ConstImageView { pixels, 2, 2, 2 }, targets);
+
+   CHECK(targets.empty() == true);
+}
+
+int main() {
+   RUN(EveryPathShouldMatchTheScalarStages);
+   RUN(ThickenShouldTakeTheMaximumOfEachBlock);
+   RUN(ScreenshotsShouldAllHaveLoaded);
+   RUN(EveryPathShouldFindTheSameTargets);
+   RUN(TargetsInScreenshotsShouldBeFound);
+   RUN(TargetsShouldBeLimited);
+   RUN(TinyImagesShouldHaveNoTargets);
+
+   return Renfrew::Tests::Result();
+}
@@ -0,0 +1,95 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "FramePool.h"
+#include "TileHasher.h"
+
+using namespace Renfrew::Tests;
+using namespace Renfrew::Utility;
+
+// Hashing with each path, comparing the hashes of two frames, and a whole
+// unchanged-frame check (what the capture does on every refresh), for a cell at
+// 100% and 150% display scale and for a whole screen.
+int main() {
+   const char *PathNames[] = { "scalar", "sse2", "avx2" };
+   const int Sizes[][2] = { { 150, 150 }, { 450, 450 }, { 1920, 1080 } };
+
+   std::mt19937 random(2);
+
+   for (auto &size : Sizes) {
+      auto width = size[0];
+      auto height = size[1];
+      auto prefix = std::to_string(width) + "x" + std::to_string(height);
+
+      std::vector<std::uint32_t> image(width * height);
+
+      for (auto &pixel : image)
+         pixel = random();
+
+      ConstImageView view { image.data(), width, height, width };
+
+      for (auto path : { SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2 }) {
+         TileHasher hasher(TileHasher::DefaultTileSize, path);
+         std::vector<std::uint64_t> hashes;
+
+         if (hasher.Path() != path)
+            continue;
+
+         auto time = MedianMilliseconds([&] {
+            hasher.Hash(view, hashes);
+         });
+
+         std::printf("%-40s %10.3f ms  (%.1f GB/s)\n", (prefix + " hash " + PathNames[static_cast<int>(path)]).c_str(),
+                     time, width * height * 4.0 / time / 1e6);
+      }
+
+      std::vector<std::uint64_t> previous, current;
+      TileHasher().Hash(view, previous);
+
+      current = previous;
+      current[current.size() / 2] ^= 1;
+
+      TileChanges changes;
+
+      Report((prefix + " diff").c_str(), MedianMilliseconds([&] {
+         changes.Reset(TileHasher::DefaultTileSize, 1, 1, false);
+         ChangeDetector::Diff(previous, current, changes);
+      }), "tile", static_cast<double>(previous.size()));
+
+      ChangeDetector detector;
+      detector.Update(view, changes);
+
+      Report((prefix + " unchanged frame").c_str(), MedianMilliseconds([&] {
+         detector.Update(view, changes);
+      }));
+
+      FramePool pool(3);
+      pool.Reserve(width, height);
+
+      Report((prefix + " pooled frame (x1000)").c_str(), MedianMilliseconds([&] {
+         for (auto i = 0; i < 1000; i++)
+            pool.Acquire(width, height);
+      }), "frame", 1000);
+   }
+
+   return 0;
+}
@@ -0,0 +1,201 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include <random>
+#include <vector>
+
+#include "Check.h"
+#include "TileHasher.h"
+
+using namespace Renfrew::Utility;
+
+static const SimdLevel Paths[] = { SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2 };
+
+static std::vector<std::uint32_t> RandomImage(std::mt19937 &random, int stride, int height) {
+   std::vector<std::uint32_t> image(stride * height);
+
+   for (auto &pixel : image)
+      pixel = random();
+
+   return image;
+}
+
+static void EveryPathShouldGiveTheScalarHashes() {
+   std::mt19937 random(2);
+
+   const int Sizes[][2] = {
+      { 300, 300 }, { 450, 450 }, { 33, 17 }, { 7, 5 }, { 1920, 1080 }, { 100, 64 }, { 1, 1 }, { 65, 200 },
+   };
+
+   for (auto tileSize : { 32, 64 }) {
+      for (auto &size : Sizes) {
+
+         // A stride wider than the image, so that the padding is seen to be ignored
+         auto stride = size[0] + 7;
+         auto image = RandomImage(random, stride, size[1]);
+         ConstImageView view { image.data(), size[0], size[1], stride };
+
+         std::vector<std::uint64_t> expected;
+         TileHasher(tileSize, SimdLevel::Scalar).Hash(view, expected);
+
+         CHECK(static_cast<int>(expected.size()) == TileHasher(tileSize).Columns(size[0]) * TileHasher(tileSize).Rows(size[1]));
+
+         for (auto path : Paths) {
+            std::vector<std::uint64_t> actual;
+            TileHasher(tileSize, path).Hash(view, actual);
+
+            CHECK(actual == expected);
+         }
+      }
+   }
+}
+
+static void PaddingShouldNotAffectTheHashes() {
+   std::mt19937 random(3);
+
+   auto image = RandomImage(random, 100 + 9, 50);
+   ConstImageView view { image.data(), 100, 50, 109 };
+
+   std::vector<std::uint64_t> before, after;
+   TileHasher().Hash(view, before);
+
+   for (auto y = 0; y < 50; y++) {
+      for (auto x = 100; x < 109; x++)
+         image[y * 109 + x] = random();
+   }
+
+   TileHasher().Hash(view, after);
+
+   CHECK(before == after);
+}
+
+static void TileSizeShouldBeRoundedUpToAMultipleOf32() {
+   CHECK(TileHasher(40).TileSize() == 64);
+   CHECK(TileHasher(32).TileSize() == 32);
+   CHECK(TileHasher(1).TileSize() == 32);
+   CHECK(TileHasher(32).Columns(65) == 3);
+   CHECK(TileHasher(32).Rows(64) == 2);
+}
+
+static void FirstFrameAndNewSizesShouldCountAsAllChanged() {
+   std::mt19937 random(4);
+
+   auto image = RandomImage(random, 200, 100);
+   ChangeDetector detector;
+   TileChanges changes;
+
+   detector.Update(ConstImageView { image.data(), 200, 100, 200 }, changes);
+   CHECK(changes.All() == true);
+   CHECK(changes.Any() == true);
+
+   detector.Update(ConstImageView { image.data(), 200, 100, 200 }, changes);
+   CHECK(changes.Any() == false);
+
+   detector.Update(ConstImageView { image.data(), 100, 100, 200 }, changes);
+   CHECK(changes.All() == true);
+
+   detector.Reset();
+   detector.Update(ConstImageView { image.data(), 100, 100, 200 }, changes);
+   CHECK(changes.All() == true);
+}
+
+// Every path must catch a change to any single bit of any pixel
+static void EverySinglePixelChangeShouldBeDetected() {
+   std::mt19937 random(5);
+
+   for (auto path : Paths) {
+      for (auto size : { 33, 450 }) {
+         auto image = RandomImage(random, size, size);
+         ConstImageView view { image.data(), size, size, size };
+
+         ChangeDetector detector(TileHasher(TileHasher::DefaultTileSize, path));
+         TileChanges changes;
+
+         detector.Update(view, changes);
+
+         auto columns = (size + 31) / 32;
+         auto missed = 0;
+
+         for (auto i = 0; i < 300; i++) {
+            auto x = static_cast<int>(random() % size);
+            auto y = static_cast<int>(random() % size);
+            auto original = image[y * size + x];
+
+            image[y * size + x] ^= 1u << (random() % 32);
+            detector.Update(view, changes);
+
+            if (changes.Changed().size() != 1 || changes.Changed()[0] != (y / 32) * columns + x / 32)
+               missed++;
+
+            if (changes.Intersects(x, y, 1, 1) == false)
+               missed++;
+
+            // Nothing changed in the next tile over
+            if (x / 32 + 1 < columns && changes.Intersects((x / 32 + 1) * 32, y, 5, 1) == true)
+               missed++;
+
+            image[y * size + x] = original;
+            detector.Update(view, changes);
+
+            if (changes.Changed().size() != 1)
+               missed++;
+         }
+
+         CHECK(missed == 0);
+      }
+   }
+}
+
+static void IntersectsShouldCoverTheWholeRectangle() {
+   TileChanges changes;
+
+   changes.Reset(32, 10, 10, false);
+   changes.Add(5 * 10 + 7);
+
+   CHECK(changes.Intersects(0, 0, 320, 320) == true);
+   CHECK(changes.Intersects(224, 160, 32, 32) == true);
+   CHECK(changes.Intersects(200, 150, 25, 11) == true);
+   CHECK(changes.Intersects(200, 150, 24, 10) == false);
+   CHECK(changes.Intersects(224, 160, 0, 32) == false);
+
+   changes.Reset(32, 10, 10, true);
+   CHECK(changes.Intersects(0, 0, 1, 1) == true);
+}
+
+static void DiffShouldListTilesThatDiffer() {
+   std::vector<std::uint64_t> previous = { 1, 2, 3, 4, 5 };
+   std::vector<std::uint64_t> current = { 1, 0, 3, 4, 0 };
+
+   TileChanges changes;
+   changes.Reset(32, 5, 1, false);
+
+   ChangeDetector::Diff(previous, current, changes);
+
+   CHECK(changes.Changed() == std::vector<int>({ 1, 4 }));
+}
+
+int main() {
+   RUN(EveryPathShouldGiveTheScalarHashes);
+   RUN(PaddingShouldNotAffectTheHashes);
+   RUN(TileSizeShouldBeRoundedUpToAMultipleOf32);
+   RUN(FirstFrameAndNewSizesShouldCountAsAllChanged);
+   RUN(EverySinglePixelChangeShouldBeDetected);
+   RUN(IntersectsShouldCoverTheWholeRectangle);
+   RUN(DiffShouldListTilesThatDiffer);
+
+   return Renfrew::Tests::Result();
+}
@@ -0,0 +1,118 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include "TraceFile.h"
+#include "TraceReplay.h"
+
+using namespace Renfrew::Win32::Interop;
+
+// Replays a trace against a simulated input backend, and reports the jitter and
+// duration it would have had. Without a file, a gesture like the one "mouse
+// drag" produces is made up (a press, 400 ms of moves at 60 Hz, a release).
+//
+//    TraceReplaySimulation [trace file] [mean wake-up latency, ms]
+
+// A simulated clock. Waking up is late by a random amount (exponentially
+// distributed, like a busy system's scheduler), and each injection takes a
+// little time, as SendInput does.
+class SimulatedBackend : public InjectionBackend {
+   private: std::mt19937 _random { 1 };
+   private: std::exponential_distribution<double> _lateness;
+   private: double _time = 0.0;
+
+   public: std::size_t Events = 0;
+
+   public: explicit SimulatedBackend(double meanLatenessMs) :
+      _lateness(1.0 / meanLatenessMs) {
+   }
+
+   public: double Now() override {
+      return _time;
+   }
+
+   public: void WaitUntil(double timeMs) override {
+      if (timeMs > _time)
+         _time = timeMs;
+
+      _time += _lateness(_random);
+   }
+
+   public: void Inject(const std::vector<TraceEvent> &events) override {
+      Events += events.size();
+      _time += 0.02 * events.size();
+   }
+};
+
+static std::vector<TraceEvent> MakeDrag() {
+   std::vector<TraceEvent> events;
+   std::int64_t time = 0;
+
+   events.push_back(TraceEvent { time, TraceEventKind::ButtonDown, TraceSource::Down, 1, 0, 0, 0 });
+
+   for (auto frame = 1; frame <= 24; frame++) {
+      time = frame * 16667;
+      events.push_back(TraceEvent { time, TraceEventKind::Move, TraceSource::Animate, 0, frame * 1000, frame * 500, 0 });
+   }
+
+   events.push_back(TraceEvent { time, TraceEventKind::ButtonUp, TraceSource::Up, 1, 0, 0, 0 });
+
+   return events;
+}
+
+static void Print(const char *name, const TimingReport &report) {
+   std::printf(
+      "%-9s %3zu injections over %8.3f ms, %6.3f ms apart, jitter %6.3f ms (max %6.3f ms)\n",
+      name, report.Injections, report.DurationMs, report.MeanIntervalMs, report.JitterMs, report.MaxJitterMs
+   );
+}
+
+int main(int argc, char *argv[]) {
+   std::vector<TraceEvent> events;
+
+   if (argc > 1) {
+      std::ifstream file(argv[1], std::ios::binary);
+
+      if (TraceFile::Read(file, events) == false) {
+         std::fprintf(stderr, "%s isn't an input trace.\n", argv[1]);
+         return 1;
+      }
+   } else {
+      events = MakeDrag();
+   }
+
+   auto latency = argc > 2 ? std::atof(argv[2]) : 0.5;
+
+   if (latency <= 0.0) {
+      std::fprintf(stderr, "The wake-up latency must be positive.\n");
+      return 1;
+   }
+
+   SimulatedBackend backend(latency);
+   auto report = TraceReplay::Replay(events, backend);
+
+   std::printf("%zu events, simulated wake-up latency %.3f ms\n", report.Events, latency);
+   Print("Recorded", report.Recorded);
+   Print("Replayed", report.Replayed);
+   std::printf("Drifted at most %.3f ms from the recording\n", report.MaxDriftMs);
+
+   return backend.Events == events.size() ? 0 : 1;
+}
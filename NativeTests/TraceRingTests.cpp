@@ -0,0 +1,186 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "Check.h"
+#include "TraceRing.h"
+
+using namespace Renfrew::Win32::Interop;
+
+// Built a second time with ThreadSanitizer (where the compiler has it), which
+// is the real check on the ring's lock-free copying.
+
+// Every field is derived from the event's number, so a torn event (half from
+// one write, half from another) doesn't add up.
+static TraceEvent MakeEvent(int producer, std::int32_t i) {
+   return TraceEvent {
+      i, TraceEventKind::Wheel, TraceSource::SmoothScroll,
+      static_cast<std::uint16_t>(producer), i, -i, i * 7
+   };
+}
+
+static bool IsWhole(const TraceEvent &e) {
+   return e.Time == e.X && e.Y == -e.X && e.Data == e.X * 7 &&
+          e.Kind == TraceEventKind::Wheel && e.Source == TraceSource::SmoothScroll;
+}
+
+static void PushingAloneShouldNeverDrop() {
+   TraceRing ring(8);
+
+   for (auto i = 0; i < 1000; i++)
+      ring.Push(MakeEvent(0, i));
+
+   auto events = ring.Snapshot();
+
+   CHECK(ring.Dropped() == 0);
+   CHECK(events.size() == 8);
+   CHECK(events.front().Time == 992 && events.back().Time == 999);
+}
+
+static void ProducersAndReaders(std::size_t capacity, int producers, int eventsEach,
+                                int &torn, std::size_t &last, std::uint64_t &dropped) {
+   TraceRing ring(capacity);
+   std::atomic<bool> done { false };
+   std::vector<std::thread> threads;
+
+   torn = 0;
+
+   for (auto p = 0; p < producers; p++) {
+      threads.emplace_back([&ring, p, eventsEach] {
+         for (auto i = 0; i < eventsEach; i++)
+            ring.Push(MakeEvent(p, i));
+      });
+   }
+
+   std::thread reader([&] {
+      while (done.load() == false) {
+         for (auto &e : ring.Snapshot()) {
+            if (IsWhole(e) == false)
+               torn++;
+         }
+      }
+   });
+
+   for (auto &thread : threads)
+      thread.join();
+
+   done.store(true);
+   reader.join();
+
+   auto events = ring.Snapshot();
+
+   for (auto &e : events) {
+      if (IsWhole(e) == false)
+         torn++;
+   }
+
+   last = events.size();
+   dropped = ring.Dropped();
+}
+
+static void ConcurrentPushesShouldAllBeKeptWhenTheyFit() {
+   int torn;
+   std::size_t count;
+   std::uint64_t dropped;
+
+   ProducersAndReaders(1 << 16, 4, 10000, torn, count, dropped);
+
+   CHECK(torn == 0);
+   CHECK(count == 40000);
+   CHECK(dropped == 0);
+}
+
+static void ConcurrentPushesShouldNeverTearWhenTheRingWraps() {
+   int torn;
+   std::size_t count;
+   std::uint64_t dropped;
+
+   // Small enough that the producers lap each other constantly. An event can be
+   // dropped when its slot is still being written, so the last lap may be short.
+   ProducersAndReaders(16, 4, 50000, torn, count, dropped);
+
+   CHECK(torn == 0);
+   CHECK(count > 0 && count <= 16);
+   CHECK(dropped < 200000);
+}
+
+static void SlotsShouldStillBeUsableAfterDrops() {
+   TraceRing ring(4);
+   std::vector<std::thread> threads;
+
+   for (auto p = 0; p < 8; p++) {
+      threads.emplace_back([&ring, p] {
+         for (auto i = 0; i < 50000; i++)
+            ring.Push(MakeEvent(p, i));
+      });
+   }
+
+   for (auto &thread : threads)
+      thread.join();
+
+   // Nothing is left half-claimed by a drop, so one more lap from a single
+   // thread fills every slot again
+   for (auto i = 0; i < 4; i++)
+      ring.Push(MakeEvent(0, i));
+
+   auto events = ring.Snapshot();
+
+   CHECK(events.size() == 4);
+   CHECK(events.front().Time == 0 && events.back().Time == 3);
+}
+
+static void EventsFromEachProducerShouldStayInOrder() {
+   TraceRing ring(1 << 16);
+   std::vector<std::thread> threads;
+
+   for (auto p = 0; p < 4; p++) {
+      threads.emplace_back([&ring, p] {
+         for (auto i = 0; i < 5000; i++)
+            ring.Push(MakeEvent(p, i));
+      });
+   }
+
+   for (auto &thread : threads)
+      thread.join();
+
+   std::int64_t next[4] = { 0, 0, 0, 0 };
+   auto outOfOrder = 0;
+
+   for (auto &e : ring.Snapshot()) {
+      if (e.Time != next[e.Buttons])
+         outOfOrder++;
+
+      next[e.Buttons] = e.Time + 1;
+   }
+
+   CHECK(outOfOrder == 0);
+   CHECK(next[0] == 5000 && next[1] == 5000 && next[2] == 5000 && next[3] == 5000);
+}
+
+int main() {
+   RUN(PushingAloneShouldNeverDrop);
+   RUN(ConcurrentPushesShouldAllBeKeptWhenTheyFit);
+   RUN(ConcurrentPushesShouldNeverTearWhenTheRingWraps);
+   RUN(SlotsShouldStillBeUsableAfterDrops);
+   RUN(EventsFromEachProducerShouldStayInOrder);
+
+   return Renfrew::Tests::Result();
+}
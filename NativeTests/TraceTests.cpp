@@ -0,0 +1,193 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Check.h"
+#include "TraceFile.h"
+#include "TraceRecorder.h"
+#include "TraceReplay.h"
+#include "TraceRing.h"
+
+using namespace Renfrew::Win32::Interop;
+
+// A clock that only moves when the replay waits or injects. Every third wake-up
+// is late by 1 ms (and every other one by 0.5 ms), and injecting takes 10 us.
+class LateWakingBackend : public InjectionBackend {
+   public: double Time = 1000.0;
+   public: int Wakes = 0;
+   public: std::vector<std::vector<TraceEvent>> Injected;
+
+   public: double Now() override {
+      return Time;
+   }
+
+   public: void WaitUntil(double timeMs) override {
+      if (timeMs > Time)
+         Time = timeMs;
+
+      Time += (Wakes++ % 3) * 0.5;
+   }
+
+   public: void Inject(const std::vector<TraceEvent> &events) override {
+      Injected.push_back(events);
+      Time += 0.01;
+   }
+};
+
+// 50 moves 8 ms apart, with a button press sent alongside every tenth one
+static std::vector<TraceEvent> MakeGesture() {
+   std::vector<TraceEvent> events;
+
+   for (auto i = 0; i < 50; i++) {
+      std::int64_t time = 100000 + i * 8000;
+
+      events.push_back(TraceEvent { time, TraceEventKind::Move, TraceSource::Animate, 0, i * 100, 65535 - i, 0 });
+
+      if (i % 10 == 0)
+         events.push_back(TraceEvent { time, TraceEventKind::ButtonDown, TraceSource::Down, 1, -5, 0, -120 });
+   }
+
+   return events;
+}
+
+static bool AreEqual(const TraceEvent &a, const TraceEvent &b) {
+   return a.Time == b.Time && a.Kind == b.Kind && a.Source == b.Source && a.Buttons == b.Buttons &&
+          a.X == b.X && a.Y == b.Y && a.Data == b.Data;
+}
+
+static void RingCapacityShouldBeRoundedUpToAPowerOfTwo() {
+   CHECK(TraceRing(5).Capacity() == 8);
+   CHECK(TraceRing(8).Capacity() == 8);
+   CHECK(TraceRing(1).Capacity() == 1);
+}
+
+static void FullRingShouldKeepTheNewestEvents() {
+   TraceRing ring(5);
+
+   for (auto i = 0; i < 20; i++)
+      ring.Push(TraceEvent { i, TraceEventKind::Move, TraceSource::Animate, 0, i, -i, 0 });
+
+   auto events = ring.Snapshot();
+
+   CHECK(events.size() == 8);
+   CHECK(events.front().Time == 12);
+   CHECK(events.back().Time == 19);
+}
+
+static void RecorderShouldOnlyRecordWhileStarted() {
+   TraceRecorder::Record(1, TraceEventKind::Move, TraceSource::MoveTo, 0, 1, 2, 3);
+   CHECK(TraceRecorder::Snapshot().empty() == true);
+   CHECK(TraceRecorder::IsRecording() == false);
+
+   TraceRecorder::Start(100);
+   TraceRecorder::Record(2, TraceEventKind::ButtonDown, TraceSource::Click, 1, 5, 6, 0);
+   TraceRecorder::Stop();
+   TraceRecorder::Record(3, TraceEventKind::ButtonUp, TraceSource::Click, 1, 5, 6, 0);
+
+   auto events = TraceRecorder::Snapshot();
+
+   CHECK(events.size() == 1);
+   CHECK(events.size() == 1 && events[0].Time == 2 && events[0].Buttons == 1);
+}
+
+static void FileShouldRoundTrip() {
+   auto events = MakeGesture();
+   std::stringstream stream;
+
+   CHECK(TraceFile::Write(stream, events) == true);
+   CHECK(stream.str().size() == 12 + TraceFile::RecordSize * events.size());
+
+   std::vector<TraceEvent> read;
+
+   CHECK(TraceFile::Read(stream, read) == true);
+   CHECK(read.size() == events.size());
+
+   auto mismatches = 0;
+
+   for (std::size_t i = 0; i < read.size() && i < events.size(); i++) {
+      if (AreEqual(read[i], events[i]) == false)
+         mismatches++;
+   }
+
+   CHECK(mismatches == 0);
+}
+
+static void ReadShouldRejectWhatIsNotATrace() {
+   std::vector<TraceEvent> events;
+
+   std::stringstream wrongMagic("RNFX");
+   CHECK(TraceFile::Read(wrongMagic, events) == false);
+
+   std::stringstream whole;
+   TraceFile::Write(whole, MakeGesture());
+
+   std::stringstream truncated(whole.str().substr(0, 40));
+   CHECK(TraceFile::Read(truncated, events) == false);
+}
+
+static void EventsSentTogetherShouldBeReplayedTogether() {
+   auto blocks = TraceReplay::Blocks(MakeGesture());
+
+   CHECK(blocks.size() == 50);
+   CHECK(blocks.size() == 50 && blocks[0].size() == 2 && blocks[1].size() == 1);
+}
+
+static void ReplayShouldReportRecordedAndReplayedTiming() {
+   auto events = MakeGesture();
+   LateWakingBackend backend;
+
+   auto report = TraceReplay::Replay(events, backend);
+
+   CHECK(backend.Injected.size() == 50);
+   CHECK(report.Events == 55);
+
+   // The recording is perfectly regular...
+   CHECK(std::abs(report.Recorded.DurationMs - 392) < 1e-9);
+   CHECK(std::abs(report.Recorded.MeanIntervalMs - 8) < 1e-9);
+   CHECK(report.Recorded.JitterMs < 1e-9);
+
+   // ...the replay is as late as the backend's wake-ups: gaps of 8.5, 8.5 and
+   // 7 ms, over and over
+   CHECK(std::abs(report.Replayed.DurationMs - 392.5) < 1e-6);
+   CHECK(std::abs(report.Replayed.JitterMs - 0.7034) < 1e-3);
+   CHECK(std::abs(report.Replayed.MaxJitterMs - 1.0102) < 1e-3);
+   CHECK(std::abs(report.MaxDriftMs - 1.01) < 1e-6);
+}
+
+static void MeasureTimingShouldNeedTwoTimes() {
+   auto report = TraceReplay::MeasureTiming({ 5.0 });
+
+   CHECK(report.Injections == 1);
+   CHECK(report.DurationMs == 0.0 && report.JitterMs == 0.0);
+}
+
+int main() {
+   RUN(RingCapacityShouldBeRoundedUpToAPowerOfTwo);
+   RUN(FullRingShouldKeepTheNewestEvents);
+   RUN(RecorderShouldOnlyRecordWhileStarted);
+   RUN(FileShouldRoundTrip);
+   RUN(ReadShouldRejectWhatIsNotATrace);
+   RUN(EventsSentTogetherShouldBeReplayedTogether);
+   RUN(ReplayShouldReportRecordedAndReplayedTiming);
+   RUN(MeasureTimingShouldNeedTwoTimes);
+
+   return Renfrew::Tests::Result();
+}
@@ -0,0 +1,87 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.h"
+#include "WindowIndex.h"
+
+using namespace Renfrew::Tests;
+using namespace Renfrew::Win32::Interop;
+
+// Point queries against a busy desktop (two screens, a few hundred top-level
+// windows), compared with walking the z-order, which is what asking the system
+// amounts to.
+int main() {
+   std::mt19937 random(7);
+   std::uniform_int_distribution<int> position(-2560, 4479);
+   std::uniform_int_distribution<int> size(50, 1500);
+
+   std::vector<WindowIndex::Entry> windows;
+
+   for (WindowIndex::WindowId id = 1; id <= 300; id++) {
+      auto left = position(random);
+      auto top = position(random) / 2;
+
+      windows.push_back({ id, { left, top, left + size(random), top + size(random) } });
+   }
+
+   std::vector<std::pair<int, int>> points;
+
+   for (auto i = 0; i < 1000000; i++)
+      points.emplace_back(position(random), position(random) / 2);
+
+   WindowIndex index;
+   volatile WindowIndex::WindowId sink = 0;
+
+   Report("Rebuild (300 windows)", MedianMilliseconds([&] {
+      index.Rebuild(windows);
+   }));
+
+   Report("Update (one window)", MedianMilliseconds([&] {
+      for (auto i = 0; i < 1000; i++)
+         index.Update(windows[i % windows.size()].Id, windows[(i + 1) % windows.size()].Bounds);
+   }) / 1000);
+
+   index.Rebuild(windows);
+
+   auto indexed = MedianMilliseconds([&] {
+      for (auto &point : points)
+         sink = sink + index.TopmostAt(point.first, point.second);
+   }, 5);
+
+   Report("TopmostAt (1,000,000 points)", indexed, "query", static_cast<double>(points.size()));
+
+   auto bruteForce = MedianMilliseconds([&] {
+      for (auto i = 0; i < 100000; i++) {
+         auto &point = points[i];
+
+         for (auto &window : windows) {
+            if (window.Bounds.Contains(point.first, point.second) == true) {
+               sink = sink + window.Id;
+               break;
+            }
+         }
+      }
+   }, 5);
+
+   Report("Brute force (100,000 points)", bruteForce, "query", 100000);
+
+   return 0;
+}
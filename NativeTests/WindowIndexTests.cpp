@@ -0,0 +1,266 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+
+#include <random>
+#include <vector>
+
+#include "Check.h"
+#include "WindowIndex.h"
+
+using namespace Renfrew::Win32::Interop;
+
+using WindowId = WindowIndex::WindowId;
+using Entry = WindowIndex::Entry;
+
+// What the index should answer, worked out the slow way
+static WindowId BruteForceTopmostAt(const std::vector<Entry> &windows, int x, int y) {
+   for (auto &window : windows) {
+      if (window.Bounds.Contains(x, y) == true)
+         return window.Id;
+   }
+
+   return 0;
+}
+
+static std::vector<WindowId> BruteForceIntersecting(const std::vector<Entry> &windows, const DesktopRect &rect) {
+   std::vector<WindowId> ids;
+
+   for (auto &window : windows) {
+      auto &b = window.Bounds;
+
+      if (b.Left < rect.Right && rect.Left < b.Right && b.Top < rect.Bottom && rect.Top < b.Bottom)
+         ids.push_back(window.Id);
+   }
+
+   return ids;
+}
+
+// A desktop with a secondary screen to the left of (and above) the primary
+static std::vector<Entry> RandomWindows(std::mt19937 &random, int count) {
+   std::uniform_int_distribution<int> position(-2560, 4479);
+   std::uniform_int_distribution<int> size(1, 1500);
+
+   std::vector<Entry> windows;
+
+   for (WindowId id = 1; id <= static_cast<WindowId>(count); id++) {
+      auto left = position(random);
+      auto top = position(random) / 2;
+
+      windows.push_back(Entry { id, { left, top, left + size(random), top + size(random) } });
+   }
+
+   return windows;
+}
+
+static void TopmostWindowShouldWinWhereWindowsOverlap() {
+   WindowIndex index;
+
+   index.Rebuild({
+      { 1, { 0, 0, 100, 100 } },
+      { 2, { 50, 50, 300, 300 } },
+      { 3, { -500, -20, 10, 10 } },
+      { 4, { 0, 0, 1920, 1080 } },
+   });
+
+   CHECK(index.TopmostAt(60, 60) == 1);
+   CHECK(index.TopmostAt(150, 150) == 2);
+   CHECK(index.TopmostAt(-300, 0) == 3);
+   CHECK(index.TopmostAt(5, 5) == 1);
+   CHECK(index.TopmostAt(1000, 1000) == 4);
+   CHECK(index.TopmostAt(5000, 5) == 0);
+   CHECK(index.Count() == 4);
+}
+
+static void EdgesShouldBeHalfOpen() {
+   WindowIndex index;
+
+   index.Rebuild({ { 1, { 0, 0, 256, 256 } } });
+
+   CHECK(index.TopmostAt(0, 0) == 1);
+   CHECK(index.TopmostAt(255, 255) == 1);
+   CHECK(index.TopmostAt(256, 0) == 0);
+   CHECK(index.TopmostAt(0, 256) == 0);
+   CHECK(index.TopmostAt(-1, 0) == 0);
+}
+
+static void UpdateShouldMoveWindowAndKeepItsZOrder() {
+   WindowIndex index;
+
+   index.Rebuild({
+      { 1, { 0, 0, 100, 100 } },
+      { 2, { 50, 50, 300, 300 } },
+      { 4, { 0, 0, 1920, 1080 } },
+   });
+
+   CHECK(index.Update(1, { 1000, 1000, 1100, 1100 }) == true);
+   CHECK(index.TopmostAt(60, 60) == 2);
+   CHECK(index.TopmostAt(1050, 1050) == 1);
+
+   CHECK(index.Update(99, { 0, 0, 1, 1 }) == false);
+}
+
+static void RemovedWindowsShouldNotBeFound() {
+   WindowIndex index;
+
+   index.Rebuild({
+      { 1, { 1000, 1000, 1100, 1100 } },
+      { 4, { 0, 0, 1920, 1080 } },
+   });
+
+   CHECK(index.Remove(1) == true);
+   CHECK(index.Remove(1) == false);
+   CHECK(index.TopmostAt(1050, 1050) == 4);
+   CHECK(index.Count() == 1);
+   CHECK(index.Update(1, { 0, 0, 10, 10 }) == false);
+}
+
+static void OnlyTheTopmostCopyOfAWindowShouldCount() {
+   WindowIndex index;
+
+   index.Rebuild({
+      { 1, { 0, 0, 100, 100 } },
+      { 2, { 0, 0, 200, 200 } },
+      { 1, { 0, 0, 300, 300 } },
+   });
+
+   CHECK(index.Count() == 2);
+   CHECK(index.TopmostAt(250, 250) == 0);
+}
+
+static void IntersectingShouldListWindowsTopmostFirst() {
+   WindowIndex index;
+
+   index.Rebuild({
+      { 2, { 50, 50, 300, 300 } },
+      { 3, { -500, -20, 10, 10 } },
+      { 4, { 0, 0, 1920, 1080 } },
+      { 5, { 2000, 0, 2100, 100 } },
+   });
+
+   auto ids = index.Intersecting({ -10, -10, 60, 60 });
+
+   CHECK(ids.size() == 3);
+   CHECK(ids.size() == 3 && ids[0] == 2 && ids[1] == 3 && ids[2] == 4);
+}
+
+static void PointQueriesShouldMatchBruteForce() {
+   std::mt19937 random(7);
+   std::uniform_int_distribution<int> position(-2560, 4479);
+
+   for (auto cellSize : { 16, 64, WindowIndex::DefaultCellSize, 4096 }) {
+      auto windows = RandomWindows(random, 300);
+      WindowIndex index(cellSize);
+
+      index.Rebuild(windows);
+
+      auto mismatches = 0;
+
+      for (auto i = 0; i < 20000; i++) {
+         auto x = position(random);
+         auto y = position(random) / 2;
+
+         if (index.TopmostAt(x, y) != BruteForceTopmostAt(windows, x, y))
+            mismatches++;
+      }
+
+      CHECK(mismatches == 0);
+   }
+}
+
+static void PointQueriesShouldMatchBruteForceAfterUpdates() {
+   std::mt19937 random(11);
+   std::uniform_int_distribution<int> position(-2560, 4479);
+
+   auto windows = RandomWindows(random, 200);
+   WindowIndex index;
+
+   index.Rebuild(windows);
+
+   // Move, resize and close windows the way the tracker's hooks would
+   for (auto i = 0; i < 500; i++) {
+      auto &window = windows[random() % windows.size()];
+      auto removed = window.Bounds.Right == window.Bounds.Left;
+
+      if (removed == true) {
+         CHECK(index.Update(window.Id, { 0, 0, 10, 10 }) == false);
+         continue;
+      }
+
+      // Removed windows are left in the list (empty, so they can't be hit)
+      if (i % 10 == 0) {
+         CHECK(index.Remove(window.Id) == true);
+         window.Bounds = { 0, 0, 0, 0 };
+         continue;
+      }
+
+      auto left = position(random);
+      auto top = position(random) / 2;
+
+      window.Bounds = { left, top, left + 1 + static_cast<int>(random() % 800), top + 1 + static_cast<int>(random() % 800) };
+      CHECK(index.Update(window.Id, window.Bounds) == true);
+   }
+
+   auto mismatches = 0;
+
+   for (auto i = 0; i < 20000; i++) {
+      auto x = position(random);
+      auto y = position(random) / 2;
+
+      if (index.TopmostAt(x, y) != BruteForceTopmostAt(windows, x, y))
+         mismatches++;
+   }
+
+   CHECK(mismatches == 0);
+}
+
+static void RectangleQueriesShouldMatchBruteForce() {
+   std::mt19937 random(13);
+   std::uniform_int_distribution<int> position(-2560, 4479);
+   std::uniform_int_distribution<int> size(1, 600);
+
+   auto windows = RandomWindows(random, 300);
+   WindowIndex index;
+
+   index.Rebuild(windows);
+
+   auto mismatches = 0;
+
+   for (auto i = 0; i < 2000; i++) {
+      auto left = position(random);
+      auto top = position(random) / 2;
+      DesktopRect rect { left, top, left + size(random), top + size(random) };
+
+      if (index.Intersecting(rect) != BruteForceIntersecting(windows, rect))
+         mismatches++;
+   }
+
+   CHECK(mismatches == 0);
+}
+
+int main() {
+   RUN(TopmostWindowShouldWinWhereWindowsOverlap);
+   RUN(EdgesShouldBeHalfOpen);
+   RUN(UpdateShouldMoveWindowAndKeepItsZOrder);
+   RUN(RemovedWindowsShouldNotBeFound);
+   RUN(OnlyTheTopmostCopyOfAWindowShouldCount);
+   RUN(IntersectingShouldListWindowsTopmostFirst);
+   RUN(PointQueriesShouldMatchBruteForce);
+   RUN(PointQueriesShouldMatchBruteForceAfterUpdates);
+   RUN(RectangleQueriesShouldMatchBruteForce);
+
+   return Renfrew::Tests::Result();
+}
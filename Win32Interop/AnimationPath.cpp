@@ -0,0 +1,76 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#include "AnimationPath.h"
+
+#include <cmath>
+
+using namespace Renfrew::Win32::Interop;
+
+AnimationPath::AnimationPath(PathPoint start, PathPoint end, double durationMs, Easing easing) {
+   _start = start;
+   _end = end;
+   _duration = durationMs > 0.0 ? durationMs : 0.0;
+   _easing = easing;
+}
+
+double AnimationPath::Duration() const {
+   return _duration;
+}
+
+double AnimationPath::Ease(Easing easing, double t) {
+   if (t <= 0.0)
+      return 0.0;
+   if (t >= 1.0)
+      return 1.0;
+
+   switch (easing) {
+      case Easing::EaseIn:
+         return t * t * t;
+      case Easing::EaseOut: {
+         double u = 1.0 - t;
+         return 1.0 - u * u * u;
+      }
+      case Easing::EaseInOut:
+         return t < 0.5 ?
+            4.0 * t * t * t :
+            1.0 - std::pow(-2.0 * t + 2.0, 3.0) / 2.0;
+      case Easing::Linear:
+      default:
+         return t;
+   }
+}
+
+bool AnimationPath::IsComplete(double elapsedMs) const {
+   return elapsedMs >= _duration;
+}
+
+PathPoint AnimationPath::PointAt(double elapsedMs) const {
+
+   // Land exactly on the end point, whatever the floating point error.
+   if (IsComplete(elapsedMs) == true)
+      return _end;
+
+   double progress = Ease(_easing, elapsedMs / _duration);
+
+   double x = _start.X + (_end.X - _start.X) * progress;
+   double y = _start.Y + (_end.Y - _start.Y) * progress;
+
+   return PathPoint {
+      static_cast<int>(std::lround(x)),
+      static_cast<int>(std::lround(y))
+   };
+}
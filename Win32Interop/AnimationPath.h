@@ -0,0 +1,69 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#pragma once
+
+// Plain C++ (no Windows or CLR dependencies), so that it can be built and
+// tested on its own.
+
+namespace Renfrew::Win32::Interop {
+
+   enum class Easing {
+      Linear, EaseIn, EaseOut, EaseInOut
+   };
+
+   struct PathPoint {
+      int X;
+      int Y;
+
+      bool operator ==(const PathPoint &other) const {
+         return X == other.X && Y == other.Y;
+      }
+
+      bool operator !=(const PathPoint &other) const {
+         return !(*this == other);
+      }
+   };
+
+   /// <summary>
+   /// A straight cursor path that takes a fixed amount of time to travel, no matter
+   /// how long it is. Positions are calculated from the exact (sub-pixel) position
+   /// along the path, rather than by adding up rounded steps, so rounding errors
+   /// never accumulate and the path always ends exactly on its end point.
+   /// </summary>
+   class AnimationPath {
+      private: PathPoint _start;
+      private: PathPoint _end;
+      private: double _duration;
+      private: Easing _easing;
+
+      public: AnimationPath(PathPoint start, PathPoint end, double durationMs, Easing easing);
+
+      /// <summary>
+      /// Gets the point the cursor should be at, the given time after the start.
+      /// </summary>
+      public: PathPoint PointAt(double elapsedMs) const;
+
+      public: bool IsComplete(double elapsedMs) const;
+
+      public: double Duration() const;
+
+      /// <summary>
+      /// Maps a linear progress value (0 to 1) onto the easing curve.
+      /// </summary>
+      public: static double Ease(Easing easing, double t);
+   };
+}
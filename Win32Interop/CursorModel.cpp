@@ -0,0 +1,164 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#include "CursorModel.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Renfrew::Win32::Interop;
+
+CursorModel::CursorModel() {
+   _x = 0.5;
+   _y = 0.5;
+   _placed = false;
+
+   _previousX = 0;
+   _previousY = 0;
+
+   _bounds = DesktopRect { 0, 0, 0, 0 };
+   _clamp = DesktopRect { 0, 0, 0, 0 };
+   _hasBounds = false;
+   _hasClamp = false;
+
+   _velocityX = 0.0;
+   _velocityY = 0.0;
+   _lastMs = 0.0;
+   _moving = false;
+}
+
+bool CursorModel::IsPlaced() const {
+   return _placed;
+}
+
+int CursorModel::X() const {
+   return static_cast<int>(std::floor(_x));
+}
+
+int CursorModel::Y() const {
+   return static_cast<int>(std::floor(_y));
+}
+
+void CursorModel::Place(int x, int y) {
+   _x = x + 0.5;
+   _y = y + 0.5;
+
+   _previousX = x;
+   _previousY = y;
+
+   _placed = true;
+}
+
+void CursorModel::Sync(int x, int y) {
+   if (_placed == true) {
+      if (x == X() && y == Y())
+         return;
+      if (x == _previousX && y == _previousY)
+         return;
+   }
+
+   Place(x, y);
+}
+
+void CursorModel::SetBounds(const DesktopRect &bounds) {
+   _bounds = bounds;
+   _hasBounds = bounds.Right > bounds.Left && bounds.Bottom > bounds.Top;
+}
+
+void CursorModel::SetClamp(const DesktopRect &region) {
+   _clamp = region;
+   _hasClamp = region.Right > region.Left && region.Bottom > region.Top;
+}
+
+void CursorModel::ClearClamp() {
+   _hasClamp = false;
+}
+
+bool CursorModel::HasClamp() const {
+   return _hasClamp;
+}
+
+CursorStep CursorModel::Move(double dx, double dy) {
+   _previousX = X();
+   _previousY = Y();
+
+   _x += dx;
+   _y += dy;
+
+   // Keep to the middle of the edge pixels, so that a move back the other way
+   // takes effect straight away.
+   auto region = Region();
+
+   if (region != nullptr) {
+      _x = std::clamp(_x, region->Left + 0.5, region->Right - 0.5);
+      _y = std::clamp(_y, region->Top + 0.5, region->Bottom - 0.5);
+   }
+
+   return Step();
+}
+
+void CursorModel::StartMotion(double velocityX, double velocityY, double nowMs) {
+   _velocityX = velocityX;
+   _velocityY = velocityY;
+   _lastMs = nowMs;
+   _moving = velocityX != 0.0 || velocityY != 0.0;
+}
+
+void CursorModel::StopMotion() {
+   _moving = false;
+}
+
+bool CursorModel::IsMoving() const {
+   return _moving;
+}
+
+CursorStep CursorModel::Advance(double nowMs) {
+   if (_moving == false)
+      return CursorStep { X(), Y(), false };
+
+   double seconds = std::max(0.0, nowMs - _lastMs) / 1000.0;
+   _lastMs = nowMs;
+
+   double x = _x;
+   double y = _y;
+
+   auto step = Move(_velocityX * seconds, _velocityY * seconds);
+
+   // Stop once every axis that's moving has run into the edge.
+   bool stuckX = _velocityX == 0.0 || _x == x;
+   bool stuckY = _velocityY == 0.0 || _y == y;
+
+   if (seconds > 0.0 && stuckX == true && stuckY == true)
+      _moving = false;
+
+   return step;
+}
+
+const DesktopRect *CursorModel::Region() const {
+   if (_hasClamp == true)
+      return &_clamp;
+   if (_hasBounds == true)
+      return &_bounds;
+
+   return nullptr;
+}
+
+CursorStep CursorModel::Step() const {
+   int x = X();
+   int y = Y();
+
+   return CursorStep { x, y, x != _previousX || y != _previousY };
+}
@@ -0,0 +1,108 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include "DesktopTopology.h"
+
+// Plain C++ (no Windows or CLR dependencies), so that it can be built and
+// tested on its own.
+
+namespace Renfrew::Win32::Interop {
+
+   /// <summary>
+   /// Where the cursor ended up after a move, and whether it crossed into a
+   /// different pixel (and so needs to be sent to the system).
+   /// </summary>
+   struct CursorStep {
+      int X;
+      int Y;
+      bool Moved;
+   };
+
+   /// <summary>
+   /// Keeps track of the cursor position with sub-pixel precision, so that small
+   /// or slow movements aren't lost to rounding. The cursor is kept inside a
+   /// region: the clamp region if one is set, otherwise the bounds (normally the
+   /// virtual desktop).
+   /// </summary>
+   class CursorModel {
+      private: double _x;
+      private: double _y;
+      private: bool _placed;
+
+      // The pixel the cursor was on before the last move, which the system may
+      // not have caught up with yet.
+      private: int _previousX;
+      private: int _previousY;
+
+      private: DesktopRect _bounds;
+      private: DesktopRect _clamp;
+      private: bool _hasBounds;
+      private: bool _hasClamp;
+
+      // Continuous motion, in pixels per second
+      private: double _velocityX;
+      private: double _velocityY;
+      private: double _lastMs;
+      private: bool _moving;
+
+      public: CursorModel();
+
+      public: bool IsPlaced() const;
+
+      public: int X() const;
+      public: int Y() const;
+
+      /// <summary>
+      /// Puts the cursor in the middle of the given pixel, dropping any fraction.
+      /// </summary>
+      public: void Place(int x, int y);
+
+      /// <summary>
+      /// Brings the model in line with where the system says the cursor is. Nothing
+      /// changes if the cursor is on the model's pixel, or still on the one it was
+      /// on before the last move; otherwise it's been moved by something else.
+      /// </summary>
+      public: void Sync(int x, int y);
+
+      public: void SetBounds(const DesktopRect &bounds);
+
+      public: void SetClamp(const DesktopRect &region);
+      public: void ClearClamp();
+      public: bool HasClamp() const;
+
+      /// <summary>
+      /// Moves the cursor by the given number of pixels (which needn't be whole),
+      /// keeping it inside the clamp region.
+      /// </summary>
+      public: CursorStep Move(double dx, double dy);
+
+      public: void StartMotion(double velocityX, double velocityY, double nowMs);
+      public: void StopMotion();
+      public: bool IsMoving() const;
+
+      /// <summary>
+      /// Moves the cursor as far as it should have gone by the given time. The
+      /// motion stops by itself once the cursor is pinned against the edge of
+      /// the clamp region.
+      /// </summary>
+      public: CursorStep Advance(double nowMs);
+
+      private: const DesktopRect *Region() const;
+      private: CursorStep Step() const;
+   };
+}
@@ -0,0 +1,190 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#include "stdafx.h"
+#include "CursorMover.h"
+#include "FrameTimer.h"
+#include "InputThread.h"
+#include "ScreenTopology.h"
+#include "Win32InteropException.h"
+
+using namespace System;
+using namespace System::Diagnostics;
+using namespace System::Threading;
+
+using namespace Renfrew::Win32::Interop;
+
+CursorMover::CursorMover() {
+   _lock = gcnew Object();
+   _wake = gcnew AutoResetEvent(false);
+
+   _model = new CursorModel();
+   _sequence = gcnew InputSequence(1);
+}
+
+// The move is worked out on the input thread rather than here, so that it
+// starts from wherever a gesture queued ahead of it left the cursor
+void CursorMover::Nudge(double dx, double dy) {
+   Monitor::Enter(_lock);
+
+   try {
+      _pendingX += dx;
+      _pendingY += dy;
+   } finally {
+      Monitor::Exit(_lock);
+   }
+
+   InputThread::Default->InvokeAndWait(gcnew Action(this, &CursorMover::ApplyNudge));
+}
+
+void CursorMover::SetClamp(DesktopRect region) {
+   Monitor::Enter(_lock);
+
+   try {
+      _model->SetClamp(region);
+   } finally {
+      Monitor::Exit(_lock);
+   }
+}
+
+void CursorMover::ClearClamp() {
+   Monitor::Enter(_lock);
+
+   try {
+      _model->ClearClamp();
+   } finally {
+      Monitor::Exit(_lock);
+   }
+}
+
+void CursorMover::Start(double velocityX, double velocityY) {
+   Monitor::Enter(_lock);
+
+   try {
+      Sync();
+      _model->StartMotion(velocityX, velocityY, FrameTimer::Now());
+
+      if (_thread == nullptr) {
+         _thread = gcnew Thread(gcnew ThreadStart(this, &CursorMover::Run));
+         _thread->Name = "Cursor Mover";
+         _thread->IsBackground = true;
+         _thread->Start();
+      }
+   } finally {
+      Monitor::Exit(_lock);
+   }
+
+   _wake->Set();
+}
+
+void CursorMover::Stop() {
+   Monitor::Enter(_lock);
+
+   try {
+      _model->StopMotion();
+   } finally {
+      Monitor::Exit(_lock);
+   }
+}
+
+void CursorMover::Run() {
+   FrameTimer timer;
+
+   for (;;) {
+      _wake->WaitOne();
+
+      bool moving = true;
+
+      while (moving == true) {
+         auto task = InputThread::Default->Invoke(gcnew Action(this, &CursorMover::Advance));
+
+         try {
+            task->Wait();
+         } catch (AggregateException ^) {
+            // Dropped by InputThread::Cancel; the model says whether to go on
+         }
+
+         Monitor::Enter(_lock);
+
+         try {
+            moving = _model->IsMoving();
+         } finally {
+            Monitor::Exit(_lock);
+         }
+
+         if (moving == true)
+            timer.Wait(FrameTimer::DefaultInterval);
+      }
+   }
+}
+
+// Runs on the input thread. Several nudges queued behind a gesture are applied
+// by the first one to run, and the rest find nothing left to do.
+void CursorMover::ApplyNudge() {
+   Monitor::Enter(_lock);
+
+   try {
+      if (_pendingX == 0 && _pendingY == 0)
+         return;
+
+      double dx = _pendingX;
+      double dy = _pendingY;
+
+      _pendingX = 0;
+      _pendingY = 0;
+
+      Sync();
+      Send(_model->Move(dx, dy));
+   } finally {
+      Monitor::Exit(_lock);
+   }
+}
+
+// Runs on the input thread
+void CursorMover::Advance() {
+   Monitor::Enter(_lock);
+
+   try {
+      Sync();
+      Send(_model->Advance(FrameTimer::Now()));
+   } catch (Win32InteropException ^e) {
+      Debug::WriteLine("CursorMover: Could not send input: " + e->Message);
+
+      _model->StopMotion();
+   } finally {
+      Monitor::Exit(_lock);
+   }
+}
+
+// Must be called with the lock held. Picks up any movement made by the user, or
+// by anything other than the mover, since the last step.
+void CursorMover::Sync() {
+   _model->SetBounds(ScreenTopology::VirtualBounds());
+
+   POINT position;
+
+   if (GetCursorPos(&position) == TRUE)
+      _model->Sync(position.x, position.y);
+}
+
+// Must be called on the input thread with the lock held
+void CursorMover::Send(CursorStep step) {
+   if (step.Moved == false)
+      return;
+
+   _sequence->Clear();
+   _sequence->MoveTo(step.X, step.Y)->Send(TraceSource::Nudge);
+}
@@ -0,0 +1,74 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include "CursorModel.h"
+#include "InputSequence.h"
+
+namespace Renfrew::Win32::Interop {
+
+   /// <summary>
+   /// Moves the cursor by relative amounts, keeping track of the fractions of a
+   /// pixel in between, and plays continuous motion on a background thread. Each
+   /// move is sent as a single absolute event from the <see cref="InputThread"/>,
+   /// so that it waits for any gesture that's playing instead of landing in the
+   /// middle of a drag.
+   /// </summary>
+   ref class CursorMover sealed {
+      private: static CursorMover ^_default;
+
+      private: System::Object ^_lock;
+      private: System::Threading::Thread ^_thread;
+      private: System::Threading::AutoResetEvent ^_wake;
+
+      // Guarded by _lock
+      private: CursorModel *_model;
+      private: double _pendingX;
+      private: double _pendingY;
+
+      // Only used on the input thread
+      private: InputSequence ^_sequence;
+
+      static CursorMover() {
+         _default = gcnew CursorMover();
+      }
+
+      private: CursorMover();
+
+      public: static property CursorMover ^Default {
+         CursorMover ^get() {
+            return _default;
+         }
+      }
+
+      public: void Nudge(double dx, double dy);
+
+      public: void SetClamp(DesktopRect region);
+      public: void ClearClamp();
+
+      public: void Start(double velocityX, double velocityY);
+      public: void Stop();
+
+      private: void Run();
+
+      private: void ApplyNudge();
+      private: void Advance();
+
+      private: void Sync();
+      private: void Send(CursorStep step);
+   };
+}
@@ -0,0 +1,127 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#include "DesktopTopology.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <stdexcept>
+
+using namespace Renfrew::Win32::Interop;
+
+DesktopTopology::DesktopTopology(const std::vector<MonitorLayout> &monitors)
+   : _monitors(monitors) {
+
+   if (_monitors.empty() == true) {
+      _virtualBounds = DesktopRect { 0, 0, 1, 1 };
+   } else {
+      _virtualBounds = _monitors[0].Bounds;
+
+      for (auto &m : _monitors) {
+         _virtualBounds.Left   = std::min(_virtualBounds.Left,   m.Bounds.Left);
+         _virtualBounds.Top    = std::min(_virtualBounds.Top,    m.Bounds.Top);
+         _virtualBounds.Right  = std::max(_virtualBounds.Right,  m.Bounds.Right);
+         _virtualBounds.Bottom = std::max(_virtualBounds.Bottom, m.Bounds.Bottom);
+      }
+   }
+
+   int width  = _virtualBounds.Right - _virtualBounds.Left;
+   int height = _virtualBounds.Bottom - _virtualBounds.Top;
+
+   // Windows maps a normalized coordinate back to a pixel with (n * width) / 65536,
+   // rounding down, so round up here to land on the same pixel.
+   _scaleX = (AbsoluteMax + 1.0) / std::max(width, 1);
+   _scaleY = (AbsoluteMax + 1.0) / std::max(height, 1);
+
+   for (auto &m : _monitors) {
+      _mappings.push_back(Mapping {
+         (m.Bounds.Left - _virtualBounds.Left) * _scaleX,
+         (m.Bounds.Top - _virtualBounds.Top) * _scaleY
+      });
+   }
+}
+
+const DesktopRect &DesktopTopology::VirtualBounds() const {
+   return _virtualBounds;
+}
+
+std::size_t DesktopTopology::MonitorCount() const {
+   return _monitors.size();
+}
+
+const MonitorLayout &DesktopTopology::MonitorAt(std::size_t index) const {
+   return _monitors.at(index);
+}
+
+int DesktopTopology::MonitorFromPoint(int x, int y) const {
+   int nearest = -1;
+   long long nearestDistance = LLONG_MAX;
+
+   for (std::size_t i = 0; i < _monitors.size(); i++) {
+      auto &bounds = _monitors[i].Bounds;
+
+      if (bounds.Contains(x, y) == true)
+         return static_cast<int>(i);
+
+      long long dx = x < bounds.Left ? bounds.Left - x : (x >= bounds.Right ? x - bounds.Right + 1 : 0);
+      long long dy = y < bounds.Top ? bounds.Top - y : (y >= bounds.Bottom ? y - bounds.Bottom + 1 : 0);
+
+      long long distance = dx * dx + dy * dy;
+
+      if (distance < nearestDistance) {
+         nearest = static_cast<int>(i);
+         nearestDistance = distance;
+      }
+   }
+
+   return nearest;
+}
+
+double DesktopTopology::ScaleAt(int x, int y) const {
+   int monitor = MonitorFromPoint(x, y);
+
+   if (monitor < 0 || _monitors[monitor].Dpi == 0)
+      return 1.0;
+
+   return static_cast<double>(_monitors[monitor].Dpi) / DefaultDpi;
+}
+
+AbsolutePoint DesktopTopology::ToAbsolute(int x, int y) const {
+   x = std::clamp(x, _virtualBounds.Left, _virtualBounds.Right - 1);
+   y = std::clamp(y, _virtualBounds.Top, _virtualBounds.Bottom - 1);
+
+   return AbsolutePoint {
+      Normalize((x - _virtualBounds.Left) * _scaleX),
+      Normalize((y - _virtualBounds.Top) * _scaleY)
+   };
+}
+
+AbsolutePoint DesktopTopology::ToAbsolute(std::size_t monitor, int x, int y) const {
+   if (monitor >= _mappings.size())
+      throw std::out_of_range("monitor");
+
+   auto &mapping = _mappings[monitor];
+
+   return AbsolutePoint {
+      Normalize(mapping.OriginX + x * _scaleX),
+      Normalize(mapping.OriginY + y * _scaleY)
+   };
+}
+
+long DesktopTopology::Normalize(double value) {
+   return std::clamp(static_cast<long>(std::ceil(value)), 0L, AbsoluteMax);
+}
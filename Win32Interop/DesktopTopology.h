@@ -0,0 +1,108 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Plain C++ (no Windows or CLR dependencies), so that it can be built and
+// tested on its own.
+
+namespace Renfrew::Win32::Interop {
+
+   /// <summary>
+   /// A rectangle in physical pixels. Right and Bottom are exclusive.
+   /// </summary>
+   struct DesktopRect {
+      int Left;
+      int Top;
+      int Right;
+      int Bottom;
+
+      bool Contains(int x, int y) const {
+         return x >= Left && x < Right && y >= Top && y < Bottom;
+      }
+   };
+
+   struct MonitorLayout {
+      DesktopRect Bounds;
+      unsigned int Dpi;
+   };
+
+   /// <summary>
+   /// A point in normalized virtual desktop coordinates (0 - 65535), as expected
+   /// by SendInput with MOUSEEVENTF_ABSOLUTE | MOUSEEVENTF_VIRTUALDESK.
+   /// </summary>
+   struct AbsolutePoint {
+      long X;
+      long Y;
+   };
+
+   /// <summary>
+   /// The layout of the monitors that make up the virtual desktop. The mapping
+   /// from screen to normalized coordinates is worked out up front, so converting
+   /// a point is a single multiply-add.
+   /// </summary>
+   class DesktopTopology {
+      public: static constexpr unsigned int DefaultDpi = 96;
+      public: static constexpr long AbsoluteMax = 65535;
+
+      private: struct Mapping {
+         double OriginX;
+         double OriginY;
+      };
+
+      private: std::vector<MonitorLayout> _monitors;
+      private: std::vector<Mapping> _mappings;
+
+      private: DesktopRect _virtualBounds;
+
+      private: double _scaleX;
+      private: double _scaleY;
+
+      public: DesktopTopology(const std::vector<MonitorLayout> &monitors);
+
+      public: const DesktopRect &VirtualBounds() const;
+
+      public: std::size_t MonitorCount() const;
+      public: const MonitorLayout &MonitorAt(std::size_t index) const;
+
+      /// <summary>
+      /// Gets the index of the monitor containing the point, or the one nearest
+      /// to it if the point is off the desktop. Returns -1 if there are no monitors.
+      /// </summary>
+      public: int MonitorFromPoint(int x, int y) const;
+
+      /// <summary>
+      /// Gets the DPI scale (1.0 at 96 DPI) of the monitor containing the point.
+      /// </summary>
+      public: double ScaleAt(int x, int y) const;
+
+      /// <summary>
+      /// Converts a point on the desktop to normalized coordinates. Points off the
+      /// desktop are clamped to its edges.
+      /// </summary>
+      public: AbsolutePoint ToAbsolute(int x, int y) const;
+
+      /// <summary>
+      /// Converts a point relative to the top-left corner of a monitor.
+      /// </summary>
+      public: AbsolutePoint ToAbsolute(std::size_t monitor, int x, int y) const;
+
+      private: static long Normalize(double value);
+   };
+}
@@ -0,0 +1,67 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#include "stdafx.h"
+#include "FrameTimer.h"
+
+using namespace Renfrew::Win32::Interop;
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+FrameTimer::FrameTimer() {
+
+   // High resolution timers need Windows 10 1803; fall back to a regular one.
+   _timer = CreateWaitableTimerExW(
+      nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS
+   );
+
+   if (_timer == nullptr)
+      _timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+}
+
+FrameTimer::~FrameTimer() {
+   if (_timer != nullptr)
+      CloseHandle(_timer);
+}
+
+double FrameTimer::Now() {
+   static LARGE_INTEGER frequency = [] {
+      LARGE_INTEGER f;
+      QueryPerformanceFrequency(&f);
+      return f;
+   }();
+
+   LARGE_INTEGER now;
+   QueryPerformanceCounter(&now);
+
+   return now.QuadPart * 1000.0 / frequency.QuadPart;
+}
+
+void FrameTimer::Wait(double milliseconds) {
+   if (_timer == nullptr) {
+      Sleep(static_cast<DWORD>(milliseconds));
+      return;
+   }
+
+   // Relative time, in 100 ns units
+   LARGE_INTEGER dueTime;
+   dueTime.QuadPart = -static_cast<LONGLONG>(milliseconds * 10000);
+
+   SetWaitableTimer(_timer, &dueTime, 0, nullptr, nullptr, FALSE);
+   WaitForSingleObject(_timer, INFINITE);
+}
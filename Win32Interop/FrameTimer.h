@@ -0,0 +1,44 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#pragma once
+
+namespace Renfrew::Win32::Interop {
+
+   /// <summary>
+   /// Paces animation frames. Time is measured with the performance counter, and
+   /// waits use a high resolution waitable timer where the system has one.
+   /// </summary>
+   class FrameTimer {
+      // Time between frames (~120 Hz)
+      public: static constexpr double DefaultInterval = 8.0;
+
+      private: HANDLE _timer;
+
+      public: FrameTimer();
+      public: ~FrameTimer();
+
+      FrameTimer(const FrameTimer &) = delete;
+      FrameTimer &operator =(const FrameTimer &) = delete;
+
+      /// <summary>
+      /// Gets the current time in milliseconds, from an arbitrary starting point.
+      /// </summary>
+      public: static double Now();
+
+      public: void Wait(double milliseconds);
+   };
+}
@@ -0,0 +1,112 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#include "stdafx.h"
+#include "Gesture.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+using namespace Renfrew::Win32::Interop;
+
+Gesture::Gesture() {
+   _steps = gcnew List<Step>();
+}
+
+Gesture ^Gesture::MoveTo(int x, int y) {
+   Step step;
+
+   step.Kind = StepKind::MoveTo;
+   step.X = x;
+   step.Y = y;
+
+   return Add(step);
+}
+
+Gesture ^Gesture::Animate(int startX, int startY, int endX, int endY, TimeSpan duration) {
+   return Animate(startX, startY, endX, endY, duration, MouseEasing::EaseInOut);
+}
+
+Gesture ^Gesture::Animate(int startX, int startY, int endX, int endY,
+                          TimeSpan duration, MouseEasing easing) {
+   Step step;
+
+   step.Kind = StepKind::Animate;
+   step.X = startX;
+   step.Y = startY;
+   step.EndX = endX;
+   step.EndY = endY;
+   step.Duration = duration;
+   step.Easing = easing;
+
+   return Add(step);
+}
+
+Gesture ^Gesture::Down(MouseButtons buttons) {
+   Step step;
+
+   step.Kind = StepKind::Down;
+   step.Buttons = buttons;
+
+   return Add(step);
+}
+
+Gesture ^Gesture::Up(MouseButtons buttons) {
+   Step step;
+
+   step.Kind = StepKind::Up;
+   step.Buttons = buttons;
+
+   return Add(step);
+}
+
+Gesture ^Gesture::Click(MouseButtons buttons) {
+   return Click(buttons, 1);
+}
+
+Gesture ^Gesture::Click(MouseButtons buttons, int times) {
+   if (times < 0)
+      throw gcnew ArgumentOutOfRangeException("times");
+
+   Step step;
+
+   step.Kind = StepKind::Click;
+   step.Buttons = buttons;
+   step.Times = times;
+
+   return Add(step);
+}
+
+Gesture ^Gesture::Delay(TimeSpan delay) {
+   if (delay < TimeSpan::Zero)
+      throw gcnew ArgumentOutOfRangeException("delay");
+
+   Step step;
+
+   step.Kind = StepKind::Delay;
+   step.Duration = delay;
+
+   return Add(step);
+}
+
+IList<Gesture::Step> ^Gesture::Steps::get() {
+   return _steps->AsReadOnly();
+}
+
+Gesture ^Gesture::Add(Step step) {
+   _steps->Add(step);
+   return this;
+}
@@ -0,0 +1,73 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include "MouseButtons.h"
+#include "MouseEasing.h"
+
+namespace Renfrew::Win32::Interop {
+
+   /// <summary>
+   /// A series of cursor movements and button presses, played as one unit
+   /// by the <see cref="InputThread"/>.
+   /// </summary>
+   public ref class Gesture sealed {
+      internal: enum class StepKind {
+         MoveTo, Animate, Down, Up, Click, Delay
+      };
+
+      internal: value struct Step {
+         StepKind Kind;
+
+         int X;
+         int Y;
+         int EndX;
+         int EndY;
+
+         MouseButtons Buttons;
+         int Times;
+
+         System::TimeSpan Duration;
+         MouseEasing Easing;
+      };
+
+      private: System::Collections::Generic::List<Step> ^_steps;
+
+      public: Gesture();
+
+      public: Gesture ^MoveTo(int x, int y);
+
+      public: Gesture ^Animate(int startX, int startY, int endX, int endY,
+                               System::TimeSpan duration);
+      public: Gesture ^Animate(int startX, int startY, int endX, int endY,
+                               System::TimeSpan duration, MouseEasing easing);
+
+      public: Gesture ^Down(MouseButtons buttons);
+      public: Gesture ^Up(MouseButtons buttons);
+
+      public: Gesture ^Click(MouseButtons buttons);
+      public: Gesture ^Click(MouseButtons buttons, int times);
+
+      public: Gesture ^Delay(System::TimeSpan delay);
+
+      internal: property System::Collections::Generic::IList<Step> ^Steps {
+         System::Collections::Generic::IList<Step> ^get();
+      }
+
+      private: Gesture ^Add(Step step);
+   };
+}
@@ -0,0 +1,240 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#include "stdafx.h"
+#include "InputSequence.h"
+#include "ScreenTopology.h"
+#include "TraceRecorder.h"
+#include "Win32InteropException.h"
+
+using namespace System;
+using namespace Renfrew::Win32::Interop;
+
+InputSequence::InputSequence() {
+   Initialize(DefaultCapacity);
+}
+
+InputSequence::InputSequence(int capacity) {
+   if (capacity < 1)
+      throw gcnew ArgumentOutOfRangeException("capacity");
+
+   Initialize(capacity);
+}
+
+void InputSequence::Initialize(int capacity) {
+   _inputs = new INPUT[capacity];
+   _delays = new DWORD[capacity];
+
+   _capacity = capacity;
+   _count = 0;
+   _initialDelay = 0;
+}
+
+InputSequence::~InputSequence() {
+   this->!InputSequence();
+}
+
+InputSequence::!InputSequence() {
+   delete[] _inputs;
+   delete[] _delays;
+
+   _inputs = nullptr;
+   _delays = nullptr;
+}
+
+int InputSequence::Count::get() {
+   return _count;
+}
+
+InputSequence ^InputSequence::MoveTo(int x, int y) {
+   auto point = ScreenTopology::ToAbsolute(x, y);
+   auto &input = AddMouseInput(MOUSEEVENTF_MOVE | MOUSEEVENTF_ABSOLUTE | MOUSEEVENTF_VIRTUALDESK);
+
+   input.mi.dx = point.X;
+   input.mi.dy = point.Y;
+
+   return this;
+}
+
+InputSequence ^InputSequence::Down(MouseButtons buttons) {
+   return AddButtons(buttons, true);
+}
+
+InputSequence ^InputSequence::Up(MouseButtons buttons) {
+   return AddButtons(buttons, false);
+}
+
+InputSequence ^InputSequence::Click(MouseButtons buttons) {
+   return Click(buttons, 1);
+}
+
+InputSequence ^InputSequence::Click(MouseButtons buttons, int times) {
+   if (times < 0)
+      throw gcnew ArgumentOutOfRangeException("times");
+
+   for (int i = 0; i < times; i++) {
+      AddButtons(buttons, true);
+      AddButtons(buttons, false);
+   }
+
+   return this;
+}
+
+InputSequence ^InputSequence::Wheel(int delta) {
+   AddMouseInput(MOUSEEVENTF_WHEEL).mi.mouseData = static_cast<DWORD>(delta);
+   return this;
+}
+
+InputSequence ^InputSequence::HorizontalWheel(int delta) {
+   AddMouseInput(MOUSEEVENTF_HWHEEL).mi.mouseData = static_cast<DWORD>(delta);
+   return this;
+}
+
+InputSequence ^InputSequence::Delay(TimeSpan delay) {
+   if (delay < TimeSpan::Zero)
+      throw gcnew ArgumentOutOfRangeException("delay");
+
+   auto milliseconds = static_cast<DWORD>(delay.TotalMilliseconds);
+
+   if (_count == 0)
+      _initialDelay += milliseconds;
+   else
+      _delays[_count - 1] += milliseconds;
+
+   return this;
+}
+
+void InputSequence::Clear() {
+   _count = 0;
+   _initialDelay = 0;
+}
+
+void InputSequence::Send() {
+   Send(TraceSource::Sequence);
+}
+
+void InputSequence::Send(TraceSource source) {
+   if (_inputs == nullptr)
+      throw gcnew ObjectDisposedException("InputSequence");
+
+   if (_initialDelay > 0)
+      Sleep(_initialDelay);
+
+   int start = 0;
+
+   while (start < _count) {
+      int end = start;
+
+      // Find the end of the block; it runs until the next delay
+      while (end < _count - 1 && _delays[end] == 0)
+         end++;
+
+      UINT length = static_cast<UINT>(end - start + 1);
+
+      if (SendInput(length, _inputs + start, sizeof(INPUT)) != length)
+         throw gcnew Win32InteropException(GetLastError());
+
+      if (TraceRecorder::IsRecording() == true)
+         Trace(_inputs + start, length, source);
+
+      if (_delays[end] > 0)
+         Sleep(_delays[end]);
+
+      start = end + 1;
+   }
+}
+
+void InputSequence::Trace(const INPUT *inputs, UINT count, TraceSource source) {
+   auto time = TraceRecorder::Now();
+
+   for (UINT i = 0; i < count; i++) {
+      auto &mi = inputs[i].mi;
+
+      int down = 0, up = 0;
+
+      if ((mi.dwFlags & MOUSEEVENTF_LEFTDOWN) != 0)   down |= static_cast<int>(MouseButtons::Left);
+      if ((mi.dwFlags & MOUSEEVENTF_RIGHTDOWN) != 0)  down |= static_cast<int>(MouseButtons::Right);
+      if ((mi.dwFlags & MOUSEEVENTF_MIDDLEDOWN) != 0) down |= static_cast<int>(MouseButtons::Middle);
+      if ((mi.dwFlags & MOUSEEVENTF_LEFTUP) != 0)     up |= static_cast<int>(MouseButtons::Left);
+      if ((mi.dwFlags & MOUSEEVENTF_RIGHTUP) != 0)    up |= static_cast<int>(MouseButtons::Right);
+      if ((mi.dwFlags & MOUSEEVENTF_MIDDLEUP) != 0)   up |= static_cast<int>(MouseButtons::Middle);
+
+      if ((mi.dwFlags & MOUSEEVENTF_MOVE) != 0)
+         TraceRecorder::Record(time, TraceEventKind::Move, source, 0, mi.dx, mi.dy, 0);
+      if (down != 0)
+         TraceRecorder::Record(time, TraceEventKind::ButtonDown, source, down, 0, 0, 0);
+      if (up != 0)
+         TraceRecorder::Record(time, TraceEventKind::ButtonUp, source, up, 0, 0, 0);
+      if ((mi.dwFlags & MOUSEEVENTF_WHEEL) != 0)
+         TraceRecorder::Record(time, TraceEventKind::Wheel, source, 0, 0, 0, static_cast<int>(mi.mouseData));
+      if ((mi.dwFlags & MOUSEEVENTF_HWHEEL) != 0)
+         TraceRecorder::Record(time, TraceEventKind::HorizontalWheel, source, 0, 0, 0, static_cast<int>(mi.mouseData));
+   }
+}
+
+InputSequence ^InputSequence::AddButtons(MouseButtons buttons, bool down) {
+   DWORD flags = 0;
+
+   if ((buttons & MouseButtons::Left) == MouseButtons::Left)
+      flags |= down ? MOUSEEVENTF_LEFTDOWN : MOUSEEVENTF_LEFTUP;
+   if ((buttons & MouseButtons::Right) == MouseButtons::Right)
+      flags |= down ? MOUSEEVENTF_RIGHTDOWN : MOUSEEVENTF_RIGHTUP;
+   if ((buttons & MouseButtons::Middle) == MouseButtons::Middle)
+      flags |= down ? MOUSEEVENTF_MIDDLEDOWN : MOUSEEVENTF_MIDDLEUP;
+
+   if (flags != 0)
+      AddMouseInput(flags);
+
+   return this;
+}
+
+INPUT &InputSequence::AddMouseInput(DWORD flags) {
+   if (_inputs == nullptr)
+      throw gcnew ObjectDisposedException("InputSequence");
+
+   EnsureCapacity(_count + 1);
+
+   auto &input = _inputs[_count];
+
+   ZeroMemory(&input, sizeof(INPUT));
+
+   input.type = INPUT_MOUSE;
+   input.mi.dwFlags = flags;
+
+   _delays[_count++] = 0;
+
+   return input;
+}
+
+void InputSequence::EnsureCapacity(int capacity) {
+   if (capacity <= _capacity)
+      return;
+
+   int newCapacity = max(capacity, _capacity * 2);
+
+   auto inputs = new INPUT[newCapacity];
+   auto delays = new DWORD[newCapacity];
+
+   CopyMemory(inputs, _inputs, _count * sizeof(INPUT));
+   CopyMemory(delays, _delays, _count * sizeof(DWORD));
+
+   delete[] _inputs;
+   delete[] _delays;
+
+   _inputs = inputs;
+   _delays = delays;
+   _capacity = newCapacity;
+}
@@ -0,0 +1,86 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include "MouseButtons.h"
+#include "TraceEvent.h"
+
+namespace Renfrew::Win32::Interop {
+
+   /// <summary>
+   /// Collects mouse input and submits it with as few calls to SendInput as possible.
+   /// Input between delays is sent as a single block, so the system sees it as one
+   /// uninterrupted gesture.
+   /// </summary>
+   public ref class InputSequence sealed {
+      private: static const int DefaultCapacity = 16;
+
+      private: INPUT *_inputs;
+      private: DWORD *_delays;
+
+      private: int _capacity;
+      private: int _count;
+
+      // A delay added before any input
+      private: DWORD _initialDelay;
+
+      public: InputSequence();
+      public: InputSequence(int capacity);
+      public: ~InputSequence();
+      public: !InputSequence();
+
+      public: property int Count {
+         int get();
+      }
+
+      public: InputSequence ^MoveTo(int x, int y);
+
+      public: InputSequence ^Down(MouseButtons buttons);
+      public: InputSequence ^Up(MouseButtons buttons);
+
+      public: InputSequence ^Click(MouseButtons buttons);
+      public: InputSequence ^Click(MouseButtons buttons, int times);
+
+      public: InputSequence ^Wheel(int delta);
+      public: InputSequence ^HorizontalWheel(int delta);
+
+      /// <summary>
+      /// Waits before sending the rest of the sequence. This splits the sequence
+      /// into separate calls to SendInput.
+      /// </summary>
+      public: InputSequence ^Delay(System::TimeSpan delay);
+
+      public: void Clear();
+
+      /// <summary>
+      /// Sends the sequence. The sequence can be sent again, or cleared and reused.
+      /// </summary>
+      public: void Send();
+
+      /// <summary>
+      /// Sends the sequence, recording it in the input trace (if it's on) as
+      /// coming from the given source.
+      /// </summary>
+      internal: void Send(TraceSource source);
+
+      private: InputSequence ^AddButtons(MouseButtons buttons, bool down);
+      private: INPUT &AddMouseInput(DWORD flags);
+      private: void EnsureCapacity(int capacity);
+      private: void Initialize(int capacity);
+      private: static void Trace(const INPUT *inputs, UINT count, TraceSource source);
+   };
+}
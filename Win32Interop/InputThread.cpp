@@ -0,0 +1,257 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#include "stdafx.h"
+#include "AnimationPath.h"
+#include "InputThread.h"
+
+using namespace System;
+using namespace System::Collections::Concurrent;
+using namespace System::Diagnostics;
+using namespace System::Runtime::ExceptionServices;
+using namespace System::Threading;
+using namespace System::Threading::Tasks;
+
+using namespace Renfrew::Win32::Interop;
+
+InputThread::InputThread() {
+   _lock = gcnew Object();
+   _wake = gcnew AutoResetEvent(false);
+   _queue = gcnew ConcurrentQueue<Entry^>();
+
+   _sequence = gcnew InputSequence(2);
+}
+
+Task ^InputThread::Enqueue(Gesture ^gesture) {
+   if (gesture == nullptr)
+      throw gcnew ArgumentNullException("gesture");
+
+   auto entry = gcnew Entry();
+
+   entry->Item = gesture;
+
+   return Add(entry);
+}
+
+Task ^InputThread::Invoke(Action ^work) {
+   if (work == nullptr)
+      throw gcnew ArgumentNullException("work");
+
+   auto entry = gcnew Entry();
+
+   entry->Work = work;
+
+   return Add(entry);
+}
+
+void InputThread::InvokeAndWait(Action ^work) {
+   auto task = Invoke(work);
+
+   try {
+      task->Wait();
+   } catch (AggregateException ^e) {
+      if (task->IsCanceled == true)
+         return;
+
+      ExceptionDispatchInfo::Capture(e->InnerException)->Throw();
+   }
+}
+
+Task ^InputThread::Add(Entry ^entry) {
+   entry->Completion = gcnew TaskCompletionSource<bool>();
+   entry->Generation = Volatile::Read(_generation);
+
+   _queue->Enqueue(entry);
+
+   Monitor::Enter(_lock);
+
+   try {
+      if (_thread == nullptr) {
+         _thread = gcnew Thread(gcnew ThreadStart(this, &InputThread::Run));
+         _thread->Name = "Input";
+         _thread->IsBackground = true;
+         _thread->Start();
+      }
+   } finally {
+      Monitor::Exit(_lock);
+   }
+
+   _wake->Set();
+
+   return entry->Completion->Task;
+}
+
+void InputThread::Cancel() {
+   Interlocked::Increment(_generation);
+
+   // Queued after the bump, so it isn't dropped along with everything else. The
+   // held buttons are only known to the input thread, so it's done there.
+   Invoke(gcnew Action(this, &InputThread::ReleaseButtons));
+}
+
+void InputThread::Run() {
+   FrameTimer timer;
+
+   for (;;) {
+      _wake->WaitOne();
+
+      Entry ^entry;
+
+      while (_queue->TryDequeue(entry) == true) {
+         if (IsCancelled(entry) == true) {
+            ReleaseButtons();
+            entry->Completion->TrySetCanceled();
+            continue;
+         }
+
+         // Work doesn't hold buttons, so a failure must not release the ones a
+         // gesture is holding down
+         if (entry->Work != nullptr) {
+            try {
+               entry->Work();
+               entry->Completion->TrySetResult(true);
+            } catch (Exception ^e) {
+               entry->Completion->TrySetException(e);
+            }
+
+            continue;
+         }
+
+         try {
+            if (Play(entry, timer) == true) {
+               entry->Completion->TrySetResult(true);
+            } else {
+               ReleaseButtons();
+               entry->Completion->TrySetCanceled();
+            }
+         } catch (Exception ^e) {
+            ReleaseButtons();
+            entry->Completion->TrySetException(e);
+         }
+      }
+   }
+}
+
+bool InputThread::Play(Entry ^entry, FrameTimer &timer) {
+   for each (auto step in entry->Item->Steps) {
+      if (IsCancelled(entry) == true)
+         return false;
+
+      switch (step.Kind) {
+         case Gesture::StepKind::MoveTo:
+            _sequence->Clear();
+            _sequence->MoveTo(step.X, step.Y)->Send(TraceSource::MoveTo);
+            break;
+
+         case Gesture::StepKind::Animate:
+            if (Animate(entry, step, timer) == false)
+               return false;
+            break;
+
+         case Gesture::StepKind::Down:
+            _sequence->Clear();
+            _sequence->Down(step.Buttons)->Send(TraceSource::Down);
+
+            _heldButtons |= static_cast<int>(step.Buttons);
+            break;
+
+         case Gesture::StepKind::Up:
+            _sequence->Clear();
+            _sequence->Up(step.Buttons)->Send(TraceSource::Up);
+
+            _heldButtons &= ~static_cast<int>(step.Buttons);
+            break;
+
+         case Gesture::StepKind::Click:
+            _sequence->Clear();
+            _sequence->Click(step.Buttons, step.Times)->Send(TraceSource::Click);
+            break;
+
+         case Gesture::StepKind::Delay:
+            if (Delay(entry, step.Duration, timer) == false)
+               return false;
+            break;
+      }
+   }
+
+   return true;
+}
+
+bool InputThread::Animate(Entry ^entry, Gesture::Step step, FrameTimer &timer) {
+   AnimationPath path(
+      PathPoint { step.X, step.Y }, PathPoint { step.EndX, step.EndY },
+      step.Duration.TotalMilliseconds, static_cast<Easing>(step.Easing)
+   );
+
+   double start = FrameTimer::Now();
+
+   PathPoint current { step.X, step.Y };
+
+   _sequence->Clear();
+   _sequence->MoveTo(current.X, current.Y)->Send(TraceSource::Animate);
+
+   for (;;) {
+      double elapsed = FrameTimer::Now() - start;
+      PathPoint next = path.PointAt(elapsed);
+
+      if (next != current) {
+         current = next;
+
+         _sequence->Clear();
+         _sequence->MoveTo(current.X, current.Y)->Send(TraceSource::Animate);
+      }
+
+      if (path.IsComplete(elapsed) == true)
+         return true;
+
+      if (IsCancelled(entry) == true)
+         return false;
+
+      timer.Wait(FrameTimer::DefaultInterval);
+   }
+}
+
+bool InputThread::Delay(Entry ^entry, TimeSpan delay, FrameTimer &timer) {
+   double end = FrameTimer::Now() + delay.TotalMilliseconds;
+
+   // Wait a frame at a time, so that a cancel is noticed quickly
+   for (double now = FrameTimer::Now(); now < end; now = FrameTimer::Now()) {
+      if (IsCancelled(entry) == true)
+         return false;
+
+      timer.Wait(Math::Min(end - now, FrameTimer::DefaultInterval));
+   }
+
+   return true;
+}
+
+bool InputThread::IsCancelled(Entry ^entry) {
+   return entry->Generation != Volatile::Read(_generation);
+}
+
+void InputThread::ReleaseButtons() {
+   if (_heldButtons == 0)
+      return;
+
+   try {
+      _sequence->Clear();
+      _sequence->Up(static_cast<MouseButtons>(_heldButtons))->Send(TraceSource::Up);
+   } catch (Exception ^e) {
+      Debug::WriteLine("InputThread: Could not release buttons: " + e->Message);
+   }
+
+   _heldButtons = 0;
+}
@@ -0,0 +1,103 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include "FrameTimer.h"
+#include "Gesture.h"
+#include "InputSequence.h"
+
+namespace Renfrew::Win32::Interop {
+
+   /// <summary>
+   /// Plays gestures on a dedicated thread, one at a time and in the order they
+   /// were queued, so that callers don't have to wait for a gesture to finish.
+   /// All mouse input is sent from this thread, so nothing can land in the middle
+   /// of a gesture.
+   /// </summary>
+   public ref class InputThread sealed {
+      private: ref class Entry {
+         public: Gesture ^Item;
+         public: System::Action ^Work;
+         public: System::Threading::Tasks::TaskCompletionSource<bool> ^Completion;
+         public: int Generation;
+      };
+
+      private: static InputThread ^_default;
+
+      private: System::Object ^_lock;
+      private: System::Threading::Thread ^_thread;
+      private: System::Threading::AutoResetEvent ^_wake;
+      private: System::Collections::Concurrent::ConcurrentQueue<Entry^> ^_queue;
+
+      // Bumped by Cancel; gestures queued before the bump are abandoned.
+      private: int _generation;
+
+      // Only used by the input thread
+      private: InputSequence ^_sequence;
+      private: int _heldButtons;
+
+      static InputThread() {
+         _default = gcnew InputThread();
+      }
+
+      private: InputThread();
+
+      public: static property InputThread ^Default {
+         InputThread ^get() {
+            return _default;
+         }
+      }
+
+      /// <summary>
+      /// Queues a gesture.
+      /// </summary>
+      /// <returns>
+      /// A task that completes when the gesture has been played, or is cancelled
+      /// if the gesture is interrupted by <see cref="Cancel"/>.
+      /// </returns>
+      public: System::Threading::Tasks::Task ^Enqueue(Gesture ^gesture);
+
+      /// <summary>
+      /// Queues work that sends input of its own, such as a cursor nudge, to run
+      /// on the input thread between gestures.
+      /// </summary>
+      internal: System::Threading::Tasks::Task ^Invoke(System::Action ^work);
+
+      /// <summary>
+      /// Runs work on the input thread and waits for it, rethrowing anything it
+      /// throws. Returns quietly if the work is dropped by <see cref="Cancel"/>.
+      /// </summary>
+      internal: void InvokeAndWait(System::Action ^work);
+
+      /// <summary>
+      /// Stops the gesture that's playing and drops any that are queued. Buttons
+      /// held down by the interrupted gesture, or left down by one that finished
+      /// (e.g. <see cref="Gesture::Down"/>), are released.
+      /// </summary>
+      public: void Cancel();
+
+      private: System::Threading::Tasks::Task ^Add(Entry ^entry);
+      private: void Run();
+
+      private: bool Play(Entry ^entry, FrameTimer &timer);
+      private: bool Animate(Entry ^entry, Gesture::Step step, FrameTimer &timer);
+      private: bool Delay(Entry ^entry, System::TimeSpan delay, FrameTimer &timer);
+
+      private: bool IsCancelled(Entry ^entry);
+      private: void ReleaseButtons();
+   };
+}
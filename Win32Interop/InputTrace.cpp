@@ -0,0 +1,189 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#include "stdafx.h"
+#include "FrameTimer.h"
+#include "InputTrace.h"
+#include "MouseButtons.h"
+#include "TraceFile.h"
+#include "TraceRecorder.h"
+#include "TraceReplay.h"
+#include "Win32InteropException.h"
+
+#include <fstream>
+#include <vcclr.h>
+
+using namespace System;
+using namespace System::Diagnostics;
+using namespace System::IO;
+
+using namespace Renfrew::Win32::Interop;
+
+namespace {
+
+   // Waits with the frame timer, and either sends the events or just pretends to.
+   class SystemBackend : public InjectionBackend {
+      private: FrameTimer _timer;
+      private: bool _inject;
+
+      public: SystemBackend(bool inject) {
+         _inject = inject;
+      }
+
+      public: double Now() override {
+         return FrameTimer::Now();
+      }
+
+      public: void WaitUntil(double timeMs) override {
+         for (double now = Now(); now < timeMs; now = Now())
+            _timer.Wait(timeMs - now);
+      }
+
+      public: void Inject(const std::vector<TraceEvent> &events) override {
+         if (_inject == false)
+            return;
+
+         std::vector<INPUT> inputs(events.size());
+         auto time = TraceRecorder::Now();
+
+         for (std::size_t i = 0; i < events.size(); i++) {
+            auto &e = events[i];
+            auto &mi = inputs[i].mi;
+
+            inputs[i].type = INPUT_MOUSE;
+
+            switch (e.Kind) {
+               case TraceEventKind::Move:
+                  mi.dwFlags = MOUSEEVENTF_MOVE | MOUSEEVENTF_ABSOLUTE | MOUSEEVENTF_VIRTUALDESK;
+                  mi.dx = e.X;
+                  mi.dy = e.Y;
+                  break;
+               case TraceEventKind::ButtonDown:
+               case TraceEventKind::ButtonUp: {
+                  bool down = e.Kind == TraceEventKind::ButtonDown;
+
+                  if ((e.Buttons & static_cast<int>(MouseButtons::Left)) != 0)
+                     mi.dwFlags |= down ? MOUSEEVENTF_LEFTDOWN : MOUSEEVENTF_LEFTUP;
+                  if ((e.Buttons & static_cast<int>(MouseButtons::Right)) != 0)
+                     mi.dwFlags |= down ? MOUSEEVENTF_RIGHTDOWN : MOUSEEVENTF_RIGHTUP;
+                  if ((e.Buttons & static_cast<int>(MouseButtons::Middle)) != 0)
+                     mi.dwFlags |= down ? MOUSEEVENTF_MIDDLEDOWN : MOUSEEVENTF_MIDDLEUP;
+                  break;
+               }
+               case TraceEventKind::Wheel:
+                  mi.dwFlags = MOUSEEVENTF_WHEEL;
+                  mi.mouseData = static_cast<DWORD>(e.Data);
+                  break;
+               case TraceEventKind::HorizontalWheel:
+                  mi.dwFlags = MOUSEEVENTF_HWHEEL;
+                  mi.mouseData = static_cast<DWORD>(e.Data);
+                  break;
+            }
+
+            TraceRecorder::Record(time, e.Kind, TraceSource::Replay, e.Buttons, e.X, e.Y, e.Data);
+         }
+
+         UINT count = static_cast<UINT>(inputs.size());
+
+         if (SendInput(count, inputs.data(), sizeof(INPUT)) != count)
+            throw gcnew Win32InteropException(GetLastError());
+      }
+   };
+}
+
+InputTraceReport::InputTraceReport(int events, TimeSpan recordedDuration,
+                                   TimeSpan replayedDuration, TimeSpan recordedJitter,
+                                   TimeSpan replayedJitter, TimeSpan maxDrift) {
+   Events = events;
+   RecordedDuration = recordedDuration;
+   ReplayedDuration = replayedDuration;
+   RecordedJitter = recordedJitter;
+   ReplayedJitter = replayedJitter;
+   MaxDrift = maxDrift;
+}
+
+String ^InputTraceReport::ToString() {
+   return String::Format(
+      "{0} events; recorded {1:F1} ms (jitter {2:F2} ms), "
+      "replayed {3:F1} ms (jitter {4:F2} ms), max drift {5:F2} ms",
+      Events,
+      RecordedDuration.TotalMilliseconds, RecordedJitter.TotalMilliseconds,
+      ReplayedDuration.TotalMilliseconds, ReplayedJitter.TotalMilliseconds,
+      MaxDrift.TotalMilliseconds
+   );
+}
+
+void InputTrace::Start(int capacity) {
+   if (capacity < 1)
+      throw gcnew ArgumentOutOfRangeException("capacity");
+
+   TraceRecorder::Start(static_cast<std::size_t>(capacity));
+}
+
+void InputTrace::Stop() {
+   TraceRecorder::Stop();
+}
+
+bool InputTrace::IsRecording::get() {
+   return TraceRecorder::IsRecording();
+}
+
+int InputTrace::Save(String ^path) {
+   if (String::IsNullOrWhiteSpace(path) == true)
+      throw gcnew ArgumentException("Value cannot be null or whitespace.", "path");
+
+   auto events = TraceRecorder::Snapshot();
+   auto dropped = TraceRecorder::Dropped();
+
+   if (dropped != 0)
+      Debug::WriteLine("InputTrace: {0} event(s) were dropped while recording.", dropped);
+
+   pin_ptr<const wchar_t> wstrPath = PtrToStringChars(path);
+   std::ofstream stream(wstrPath, std::ios::binary | std::ios::trunc);
+
+   if (TraceFile::Write(stream, events) == false)
+      throw gcnew IOException("Could not write input trace '" + path + "'.");
+
+   return static_cast<int>(events.size());
+}
+
+InputTraceReport ^InputTrace::Replay(String ^path, bool inject) {
+   if (String::IsNullOrWhiteSpace(path) == true)
+      throw gcnew ArgumentException("Value cannot be null or whitespace.", "path");
+
+   std::vector<TraceEvent> events;
+
+   {
+      pin_ptr<const wchar_t> wstrPath = PtrToStringChars(path);
+      std::ifstream stream(wstrPath, std::ios::binary);
+
+      if (TraceFile::Read(stream, events) == false)
+         throw gcnew InvalidDataException("'" + path + "' is not an input trace.");
+   }
+
+   SystemBackend backend(inject);
+
+   auto report = TraceReplay::Replay(events, backend);
+
+   return gcnew InputTraceReport(
+      static_cast<int>(report.Events),
+      TimeSpan::FromMilliseconds(report.Recorded.DurationMs),
+      TimeSpan::FromMilliseconds(report.Replayed.DurationMs),
+      TimeSpan::FromMilliseconds(report.Recorded.JitterMs),
+      TimeSpan::FromMilliseconds(report.Replayed.JitterMs),
+      TimeSpan::FromMilliseconds(report.MaxDriftMs)
+   );
+}
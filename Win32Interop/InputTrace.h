@@ -0,0 +1,76 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#pragma once
+
+namespace Renfrew::Win32::Interop {
+
+   /// <summary>
+   /// Timing of a replayed input trace.
+   /// </summary>
+   public ref class InputTraceReport sealed {
+      public: InputTraceReport(int events, System::TimeSpan recordedDuration,
+                               System::TimeSpan replayedDuration, System::TimeSpan recordedJitter,
+                               System::TimeSpan replayedJitter, System::TimeSpan maxDrift);
+
+      public: property int Events;
+
+      public: property System::TimeSpan RecordedDuration;
+      public: property System::TimeSpan ReplayedDuration;
+
+      /// <summary>
+      /// Standard deviation of the gaps between injections.
+      /// </summary>
+      public: property System::TimeSpan RecordedJitter;
+      public: property System::TimeSpan ReplayedJitter;
+
+      /// <summary>
+      /// The furthest any injection strayed from its recorded time.
+      /// </summary>
+      public: property System::TimeSpan MaxDrift;
+
+      public: virtual System::String ^ToString() override;
+   };
+
+   /// <summary>
+   /// Records every mouse event that's injected, so that gesture timing can be
+   /// looked at (and replayed) after the fact.
+   /// </summary>
+   public ref class InputTrace abstract sealed {
+
+      /// <summary>
+      /// Starts recording, keeping the most recent events up to the given capacity.
+      /// </summary>
+      public: static void Start(int capacity);
+      public: static void Stop();
+
+      public: static property bool IsRecording {
+         bool get();
+      }
+
+      /// <summary>
+      /// Writes the recorded events to a file.
+      /// </summary>
+      /// <returns>The number of events written.</returns>
+      public: static int Save(System::String ^path);
+
+      /// <summary>
+      /// Plays a saved trace back with its original timing. When inject is false,
+      /// nothing is sent to the system, and only the timing is simulated.
+      /// </summary>
+      public: static InputTraceReport ^Replay(System::String ^path, bool inject);
+   };
+}
@@ -16,118 +16,117 @@
 //
 
 #include "stdafx.h"
+#include "CursorMover.h"
+#include "InputThread.h"
 #include "Mouse.h"
+#include "WheelScroller.h"
 
 using namespace System;
-using namespace System::Threading;
+using namespace System::Runtime::ExceptionServices;
+using namespace System::Threading::Tasks;
 
 using namespace Renfrew::Win32::Interop;
 
-static int interval = 10;
+static WheelDelta GetWheelDelta(MouseScrollDirection scrollDirection, DWORD scrollDelta);
+static void Play(Gesture ^gesture);
+
+static const int defaultDuration = 250;
 
 void Mouse::Animate(int startX, int startY, int endX, int endY) {
-   Animate(startX, startY, endX, endY, 10);
+   Animate(startX, startY, endX, endY, TimeSpan::FromMilliseconds(defaultDuration));
 }
 
-void Mouse::Animate(int startX, int startY, int endX, int endY, int stepSize) {
-   double x = startX;
-   double y = startY;
-
-   double rise = Math::Abs(endY - startY);
-   double run  = Math::Abs(endX - startX);
-
-   double xi = 0.0;
-   double yi = 0.0;
-
-   if (rise == 0.0) {
-      xi = stepSize;
-   } else if (run == 0.0) {
-      yi = stepSize;
-   } else {
-      double theta = Math::Atan(rise / run);
-
-      xi = Math::Cos(theta) * stepSize;
-      yi = Math::Sin(theta) * stepSize;
-   }
-
-   // y screen coordinates are inverted
-   yi = -yi;
-
-   while ((int)x != endX || (int)y != endY) {
+void Mouse::Animate(int startX, int startY, int endX, int endY, TimeSpan duration) {
+   Animate(startX, startY, endX, endY, duration, MouseEasing::EaseInOut);
+}
 
-      if (endX >= startX) {
-         x += xi;
+void Mouse::Animate(int startX, int startY, int endX, int endY,
+                    TimeSpan duration, MouseEasing easing) {
+   Play((gcnew Gesture())->Animate(startX, startY, endX, endY, duration, easing));
+}
 
-         if (x > endX)
-            x = endX;
-      } else {
-         x -= xi;
+void Mouse::Click(MouseButtons buttons) {
+   Click(buttons, 1);
+}
 
-         if (x < endX)
-            x = endX;
-      }
+void Mouse::Click(MouseButtons buttons, int times) {
+   Play((gcnew Gesture())->Click(buttons, times));
+}
 
-      if (endY <= startY) {
-         y += yi;
+void Mouse::Down(MouseButtons buttons) {
+   Play((gcnew Gesture())->Down(buttons));
+}
 
-         if (y < endY)
-            y = endY;
-      } else {
-         y -= yi;
+void Mouse::Nudge(double deltaX, double deltaY) {
+   CursorMover::Default->Nudge(deltaX, deltaY);
+}
 
-         if (y > endY)
-            y = endY;
-      }
+void Mouse::SetClampRegion(int left, int top, int right, int bottom) {
+   CursorMover::Default->SetClamp(DesktopRect { left, top, right, bottom });
+}
 
-      SetCursorPos((int) x, (int) y);
+void Mouse::ClearClampRegion() {
+   CursorMover::Default->ClearClamp();
+}
 
-      Thread::Sleep(interval);
-   }
+void Mouse::StartMoving(double velocityX, double velocityY) {
+   CursorMover::Default->Start(velocityX, velocityY);
 }
 
-void Mouse::Click(MouseButtons buttons) {
-   Down(buttons);
+void Mouse::StopMoving() {
+   CursorMover::Default->Stop();
+}
 
-   Thread::Sleep(1);
+void Mouse::SetPosition(int x, int y) {
+   Play((gcnew Gesture())->MoveTo(x, y));
+}
 
-   Up(buttons);
+void Mouse::Up(MouseButtons buttons) {
+   Play((gcnew Gesture())->Up(buttons));
 }
 
-void Mouse::Down(MouseButtons buttons) {
-   DWORD flags = 0;
+void Mouse::Scroll(MouseScrollDirection scrollDirection, DWORD scrollDelta) {
+   WheelScroller::Default->Scroll(GetWheelDelta(scrollDirection, scrollDelta));
+}
 
-   if ((buttons & MouseButtons::Left) == MouseButtons::Left)
-      flags |= MOUSEEVENTF_LEFTDOWN;
-   if ((buttons & MouseButtons::Right) == MouseButtons::Right)
-      flags |= MOUSEEVENTF_RIGHTDOWN;
-   if ((buttons & MouseButtons::Middle) == MouseButtons::Middle)
-      flags |= MOUSEEVENTF_MIDDLEDOWN;
+void Mouse::Scroll(MouseScrollDirection scrollDirection, DWORD scrollDelta, TimeSpan duration) {
+   if (duration <= TimeSpan::Zero) {
+      Scroll(scrollDirection, scrollDelta);
+      return;
+   }
 
-   mouse_event(flags, 0, 0, 0, 0);
+   WheelScroller::Default->Scroll(GetWheelDelta(scrollDirection, scrollDelta), duration);
 }
 
-void Mouse::SetPosition(int x, int y) {
-   SetCursorPos(x, y);
+static WheelDelta GetWheelDelta(MouseScrollDirection scrollDirection, DWORD scrollDelta) {
+   auto delta = static_cast<int>(scrollDelta);
+
+   switch (scrollDirection) {
+      case MouseScrollDirection::Up:
+         return WheelDelta { 0, delta };
+      case MouseScrollDirection::Left:
+         return WheelDelta { -delta, 0 };
+      case MouseScrollDirection::Right:
+         return WheelDelta { delta, 0 };
+      case MouseScrollDirection::Down:
+      default:
+         return WheelDelta { 0, -delta };
+   }
 }
 
-void Mouse::Up(MouseButtons buttons) {
-   DWORD flags = 0;
+// Plays the gesture on the input thread and waits for it
+static void Play(Gesture ^gesture) {
+   auto task = InputThread::Default->Enqueue(gesture);
 
-   if ((buttons & MouseButtons::Left) == MouseButtons::Left)
-      flags |= MOUSEEVENTF_LEFTUP;
-   if ((buttons & MouseButtons::Right) == MouseButtons::Right)
-      flags |= MOUSEEVENTF_RIGHTUP;
-   if ((buttons & MouseButtons::Middle) == MouseButtons::Middle)
-      flags |= MOUSEEVENTF_MIDDLEUP;
+   try {
+      task->Wait();
+   } catch (AggregateException ^e) {
 
-   mouse_event(flags, 0, 0, 0, 0);
-}
+      // Interrupted by InputThread::Cancel
+      if (task->IsCanceled == true)
+         return;
 
-void Mouse::Scroll(MouseScrollDirection scrollDirection, DWORD scrollDelta) {
-   if (scrollDirection == MouseScrollDirection::Down) {
-      mouse_event(MOUSEEVENTF_WHEEL, 0, 0, -scrollDelta, 0);
-   }
-   if (scrollDirection == MouseScrollDirection::Up) {
-      mouse_event(MOUSEEVENTF_WHEEL, 0, 0, scrollDelta, 0);
+      // Keeps the stack trace from the input thread
+      ExceptionDispatchInfo::Capture(e->InnerException)->Throw();
    }
 }
@@ -18,20 +18,58 @@
 #pragma once
 
 #include "MouseButtons.h"
+#include "MouseEasing.h"
 #include "MouseScrollDirection.h"
 
 namespace Renfrew::Win32::Interop {
    public ref class Mouse abstract {
+      /// <summary>
+      /// Moves the cursor from one point to another over the given amount of time,
+      /// regardless of the distance.
+      /// </summary>
       public: static void Animate(int startX, int startY, int endX, int endY);
-      public: static void Animate(int startX, int startY, int endX, int endY, int stepSize);
+      public: static void Animate(int startX, int startY, int endX, int endY,
+                                  System::TimeSpan duration);
+      public: static void Animate(int startX, int startY, int endX, int endY,
+                                  System::TimeSpan duration, MouseEasing easing);
 
       public: static void Click(MouseButtons buttons);
+      public: static void Click(MouseButtons buttons, int times);
 
       public: static void Down(MouseButtons buttons);
       public: static void Up(MouseButtons buttons);
 
+      /// <summary>
+      /// Moves the cursor relative to where it is now. Fractions of a pixel are
+      /// kept, and added to the next nudge.
+      /// </summary>
+      public: static void Nudge(double deltaX, double deltaY);
+
+      /// <summary>
+      /// Keeps nudges and continuous motion inside the given rectangle, in screen
+      /// pixels. The right and bottom edges are exclusive.
+      /// </summary>
+      public: static void SetClampRegion(int left, int top, int right, int bottom);
+      public: static void ClearClampRegion();
+
+      /// <summary>
+      /// Starts moving the cursor at the given speed, in pixels per second, until
+      /// <see cref="StopMoving"/> is called or the cursor reaches the edge of the
+      /// clamp region (or the desktop). Returns straight away.
+      /// </summary>
+      public: static void StartMoving(double velocityX, double velocityY);
+      public: static void StopMoving();
+
       public: static void Scroll(MouseScrollDirection scrollDirection, DWORD scrollDelta);
 
+      /// <summary>
+      /// Scrolls smoothly over the given amount of time. Returns straight away; the
+      /// scroll is played on a background thread, and is merged with any scroll
+      /// that's still playing.
+      /// </summary>
+      public: static void Scroll(MouseScrollDirection scrollDirection, DWORD scrollDelta,
+                                 System::TimeSpan duration);
+
       public: static void SetPosition(int x, int y);
    };
 }
\ No newline at end of file
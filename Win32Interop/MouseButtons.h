@@ -19,5 +19,7 @@
 
 [System::Flags]
 public enum class MouseButtons : int {
-   Left, Right, Middle
+   Left   = 1,
+   Right  = 2,
+   Middle = 4
 };
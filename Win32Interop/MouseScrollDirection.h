@@ -17,7 +17,6 @@
 
 #pragma once
 
-[System::Flags]
 public enum class MouseScrollDirection : int {
-   Down, Up
+   Down, Up, Left, Right
 };
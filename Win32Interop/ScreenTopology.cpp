@@ -0,0 +1,133 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#include "stdafx.h"
+#include "ScreenTopology.h"
+
+#include <vector>
+
+using namespace System;
+using namespace System::Threading;
+
+using namespace Renfrew::Win32::Interop;
+
+#pragma managed(push, off)
+
+// From ShellScalingApi.h; loaded at run time, since it needs Windows 8.1
+typedef HRESULT (WINAPI *GetDpiForMonitorProc)(HMONITOR, int, UINT *, UINT *);
+
+static const int MDT_EFFECTIVE_DPI_VALUE = 0;
+
+static BOOL CALLBACK AddMonitor(HMONITOR hMonitor, HDC, LPRECT, LPARAM data) {
+   static auto getDpiForMonitor = reinterpret_cast<GetDpiForMonitorProc>(
+      GetProcAddress(LoadLibraryW(L"Shcore.dll"), "GetDpiForMonitor")
+   );
+
+   auto monitors = reinterpret_cast<std::vector<MonitorLayout> *>(data);
+
+   MONITORINFO info { sizeof(MONITORINFO) };
+
+   if (GetMonitorInfoW(hMonitor, &info) == FALSE)
+      return TRUE;
+
+   UINT dpiX = DesktopTopology::DefaultDpi, dpiY = DesktopTopology::DefaultDpi;
+
+   if (getDpiForMonitor != nullptr)
+      getDpiForMonitor(hMonitor, MDT_EFFECTIVE_DPI_VALUE, &dpiX, &dpiY);
+
+   monitors->push_back(MonitorLayout {
+      DesktopRect {
+         info.rcMonitor.left, info.rcMonitor.top,
+         info.rcMonitor.right, info.rcMonitor.bottom
+      },
+      dpiX
+   });
+
+   return TRUE;
+}
+
+#pragma managed(pop)
+
+int ScreenTopology::MonitorCount::get() {
+   Monitor::Enter(_lock);
+
+   try {
+      return static_cast<int>(GetTopology()->MonitorCount());
+   } finally {
+      Monitor::Exit(_lock);
+   }
+}
+
+double ScreenTopology::GetScale(int x, int y) {
+   Monitor::Enter(_lock);
+
+   try {
+      return GetTopology()->ScaleAt(x, y);
+   } finally {
+      Monitor::Exit(_lock);
+   }
+}
+
+void ScreenTopology::Invalidate() {
+   Monitor::Enter(_lock);
+
+   try {
+      delete _topology;
+      _topology = nullptr;
+   } finally {
+      Monitor::Exit(_lock);
+   }
+}
+
+AbsolutePoint ScreenTopology::ToAbsolute(int x, int y) {
+   Monitor::Enter(_lock);
+
+   try {
+      return GetTopology()->ToAbsolute(x, y);
+   } finally {
+      Monitor::Exit(_lock);
+   }
+}
+
+DesktopRect ScreenTopology::VirtualBounds() {
+   Monitor::Enter(_lock);
+
+   try {
+      return GetTopology()->VirtualBounds();
+   } finally {
+      Monitor::Exit(_lock);
+   }
+}
+
+// Must be called with the lock held
+DesktopTopology *ScreenTopology::GetTopology() {
+   if (_topology == nullptr)
+      _topology = ReadTopology();
+
+   return _topology;
+}
+
+DesktopTopology *ScreenTopology::ReadTopology() {
+   std::vector<MonitorLayout> monitors;
+
+   EnumDisplayMonitors(nullptr, nullptr, AddMonitor, reinterpret_cast<LPARAM>(&monitors));
+
+   return new DesktopTopology(monitors);
+}
+
+void ScreenTopology::OnDisplaySettingsChanged(Object ^sender, EventArgs ^e) {
+   Invalidate();
+}
@@ -0,0 +1,60 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include "DesktopTopology.h"
+
+namespace Renfrew::Win32::Interop {
+
+   /// <summary>
+   /// The current monitor layout and DPI of each monitor. The layout is read once
+   /// and cached until the display settings change.
+   /// </summary>
+   public ref class ScreenTopology abstract sealed {
+      private: static DesktopTopology *_topology;
+      private: static System::Object ^_lock;
+
+      static ScreenTopology() {
+         _lock = gcnew System::Object();
+
+         Microsoft::Win32::SystemEvents::DisplaySettingsChanged +=
+            gcnew System::EventHandler(&ScreenTopology::OnDisplaySettingsChanged);
+      }
+
+      public: static property int MonitorCount {
+         int get();
+      }
+
+      /// <summary>
+      /// Gets the DPI scale (1.0 at 96 DPI) of the monitor containing the point.
+      /// </summary>
+      public: static double GetScale(int x, int y);
+
+      /// <summary>
+      /// Discards the cached layout, so that it's read again on next use.
+      /// </summary>
+      public: static void Invalidate();
+
+      internal: static AbsolutePoint ToAbsolute(int x, int y);
+      internal: static DesktopRect VirtualBounds();
+
+      private: static DesktopTopology *GetTopology();
+      private: static DesktopTopology *ReadTopology();
+
+      private: static void OnDisplaySettingsChanged(System::Object ^sender, System::EventArgs ^e);
+   };
+}
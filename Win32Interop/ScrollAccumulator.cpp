@@ -0,0 +1,79 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#include "ScrollAccumulator.h"
+
+#include <cmath>
+
+using namespace Renfrew::Win32::Interop;
+
+ScrollAccumulator::ScrollAccumulator() {
+   _x = 0.0;
+   _y = 0.0;
+}
+
+void ScrollAccumulator::Add(double x, double y) {
+   _x += x;
+   _y += y;
+}
+
+WheelDelta ScrollAccumulator::Take() {
+   double x = std::trunc(_x);
+   double y = std::trunc(_y);
+
+   _x -= x;
+   _y -= y;
+
+   return WheelDelta { static_cast<int>(x), static_cast<int>(y) };
+}
+
+WheelDelta ScrollAccumulator::Flush() {
+   WheelDelta delta {
+      static_cast<int>(std::lround(_x)),
+      static_cast<int>(std::lround(_y))
+   };
+
+   _x = 0.0;
+   _y = 0.0;
+
+   return delta;
+}
+
+ScrollAnimation::ScrollAnimation(WheelDelta total, double startMs, double durationMs, Easing easing) {
+   _total = total;
+   _start = startMs;
+   _duration = durationMs > 0.0 ? durationMs : 0.0;
+   _easing = easing;
+   _delivered = 0.0;
+}
+
+bool ScrollAnimation::Advance(double nowMs, ScrollAccumulator &accumulator) {
+   double elapsed = nowMs - _start;
+
+   bool complete = elapsed >= _duration;
+
+   double progress = complete == true ?
+      1.0 : AnimationPath::Ease(_easing, elapsed / _duration);
+
+   double step = progress - _delivered;
+
+   if (step > 0.0) {
+      accumulator.Add(_total.X * step, _total.Y * step);
+      _delivered = progress;
+   }
+
+   return complete;
+}
@@ -0,0 +1,83 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include "AnimationPath.h"
+
+// Plain C++ (no Windows or CLR dependencies), so that it can be built and
+// tested on its own.
+
+namespace Renfrew::Win32::Interop {
+
+   /// <summary>
+   /// Wheel movement, in the same units as WHEEL_DELTA. X is the horizontal wheel
+   /// (positive is right), Y the vertical wheel (positive is up).
+   /// </summary>
+   struct WheelDelta {
+      int X;
+      int Y;
+
+      bool IsZero() const {
+         return X == 0 && Y == 0;
+      }
+   };
+
+   /// <summary>
+   /// Collects fractional wheel movement and hands it out in whole units, carrying
+   /// the remainder over, so nothing is lost to rounding.
+   /// </summary>
+   class ScrollAccumulator {
+      private: double _x;
+      private: double _y;
+
+      public: ScrollAccumulator();
+
+      public: void Add(double x, double y);
+
+      /// <summary>
+      /// Takes the whole units collected so far, keeping the remainder.
+      /// </summary>
+      public: WheelDelta Take();
+
+      /// <summary>
+      /// Takes everything that's left, rounded to the nearest unit.
+      /// </summary>
+      public: WheelDelta Flush();
+   };
+
+   /// <summary>
+   /// Spreads a scroll over a period of time.
+   /// </summary>
+   class ScrollAnimation {
+      private: WheelDelta _total;
+      private: double _start;
+      private: double _duration;
+      private: Easing _easing;
+
+      // Fraction of the total that's been handed out
+      private: double _delivered;
+
+      public: ScrollAnimation(WheelDelta total, double startMs, double durationMs,
+                              Easing easing = Easing::EaseOut);
+
+      /// <summary>
+      /// Adds the part of the scroll that's due by the given time.
+      /// </summary>
+      /// <returns>true once all of the scroll has been added.</returns>
+      public: bool Advance(double nowMs, ScrollAccumulator &accumulator);
+   };
+}
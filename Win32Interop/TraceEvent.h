@@ -0,0 +1,57 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include <cstdint>
+
+// Plain C++ (no Windows or CLR dependencies), so that it can be built and
+// tested on its own.
+
+namespace Renfrew::Win32::Interop {
+
+   enum class TraceEventKind : std::uint8_t {
+      Move, ButtonDown, ButtonUp, Wheel, HorizontalWheel
+   };
+
+   /// <summary>
+   /// What asked for the input to be injected.
+   /// </summary>
+   enum class TraceSource : std::uint8_t {
+      Sequence, MoveTo, Animate, Down, Up, Click, Scroll, SmoothScroll, Nudge, Replay
+   };
+
+   /// <summary>
+   /// A single injected input event. Moves are recorded in normalized (absolute)
+   /// coordinates, exactly as they were sent.
+   /// </summary>
+   struct TraceEvent {
+      // Microseconds, from a monotonic clock
+      std::int64_t Time;
+
+      TraceEventKind Kind;
+      TraceSource Source;
+
+      // MouseButtons flags, for button events
+      std::uint16_t Buttons;
+
+      std::int32_t X;
+      std::int32_t Y;
+
+      // Wheel delta, for wheel events
+      std::int32_t Data;
+   };
+}
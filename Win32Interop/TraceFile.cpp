@@ -0,0 +1,105 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#include "TraceFile.h"
+
+using namespace Renfrew::Win32::Interop;
+
+namespace {
+   template <typename T>
+   void Put(std::ostream &stream, T value) {
+      auto bits = static_cast<std::uint64_t>(value);
+
+      for (std::size_t i = 0; i < sizeof(T); i++)
+         stream.put(static_cast<char>((bits >> (8 * i)) & 0xFF));
+   }
+
+   template <typename T>
+   bool Get(std::istream &stream, T &value) {
+      std::uint64_t bits = 0;
+
+      for (std::size_t i = 0; i < sizeof(T); i++) {
+         auto c = stream.get();
+
+         if (c == std::istream::traits_type::eof())
+            return false;
+
+         bits |= static_cast<std::uint64_t>(c & 0xFF) << (8 * i);
+      }
+
+      value = static_cast<T>(bits);
+      return true;
+   }
+}
+
+bool TraceFile::Write(std::ostream &stream, const std::vector<TraceEvent> &events) {
+   Put(stream, Magic);
+   Put(stream, Version);
+   Put(stream, RecordSize);
+   Put(stream, static_cast<std::uint32_t>(events.size()));
+
+   for (auto &e : events) {
+      Put(stream, e.Time);
+      Put(stream, static_cast<std::uint8_t>(e.Kind));
+      Put(stream, static_cast<std::uint8_t>(e.Source));
+      Put(stream, e.Buttons);
+      Put(stream, e.X);
+      Put(stream, e.Y);
+      Put(stream, e.Data);
+   }
+
+   return stream.good();
+}
+
+bool TraceFile::Read(std::istream &stream, std::vector<TraceEvent> &events) {
+   std::uint32_t magic, count;
+   std::uint16_t version, recordSize;
+
+   if (Get(stream, magic) == false || magic != Magic)
+      return false;
+   if (Get(stream, version) == false || version != Version)
+      return false;
+   if (Get(stream, recordSize) == false || recordSize != RecordSize)
+      return false;
+   if (Get(stream, count) == false)
+      return false;
+
+   events.clear();
+
+   for (std::uint32_t i = 0; i < count; i++) {
+      TraceEvent e;
+      std::uint8_t kind, source;
+
+      bool ok =
+         Get(stream, e.Time) &&
+         Get(stream, kind) &&
+         Get(stream, source) &&
+         Get(stream, e.Buttons) &&
+         Get(stream, e.X) &&
+         Get(stream, e.Y) &&
+         Get(stream, e.Data);
+
+      if (ok == false)
+         return false;
+
+      e.Kind = static_cast<TraceEventKind>(kind);
+      e.Source = static_cast<TraceSource>(source);
+
+      events.push_back(e);
+   }
+
+   return true;
+}
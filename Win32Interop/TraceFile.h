@@ -0,0 +1,48 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include "TraceEvent.h"
+
+// Plain C++ (no Windows or CLR dependencies), so that it can be built and
+// tested on its own.
+
+namespace Renfrew::Win32::Interop {
+
+   /// <summary>
+   /// Reads and writes input traces. The file is a small header followed by
+   /// fixed-size little-endian records:
+   ///
+   ///    header:  magic "RNFT" (u32), version (u16), record size (u16), count (u32)
+   ///    record:  time (i64), kind (u8), source (u8), buttons (u16), x (i32), y (i32), data (i32)
+   /// </summary>
+   class TraceFile {
+      public: static constexpr std::uint32_t Magic = 0x54464E52;
+      public: static constexpr std::uint16_t Version = 1;
+      public: static constexpr std::uint16_t RecordSize = 24;
+
+      public: static bool Write(std::ostream &stream, const std::vector<TraceEvent> &events);
+
+      /// <returns>false if the stream isn't a trace, or is truncated.</returns>
+      public: static bool Read(std::istream &stream, std::vector<TraceEvent> &events);
+   };
+}
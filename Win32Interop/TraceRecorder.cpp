@@ -0,0 +1,84 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#include "TraceRecorder.h"
+#include "TraceRing.h"
+
+#include <chrono>
+
+using namespace Renfrew::Win32::Interop;
+
+// Rings are never freed, since another thread may be recording into one as it's
+// replaced. Restarting the trace with a bigger buffer is rare enough for this not
+// to matter.
+static std::atomic<TraceRing *> ring { nullptr };
+static std::atomic<bool> recording { false };
+
+void TraceRecorder::Start(std::size_t capacity) {
+   auto current = ring.load();
+
+   if (current == nullptr || current->Capacity() < capacity)
+      ring.store(new TraceRing(capacity));
+
+   recording.store(true);
+}
+
+void TraceRecorder::Stop() {
+   recording.store(false);
+}
+
+bool TraceRecorder::IsRecording() {
+   return recording.load(std::memory_order_relaxed);
+}
+
+std::int64_t TraceRecorder::Now() {
+   return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()
+   ).count();
+}
+
+void TraceRecorder::Record(std::int64_t time, TraceEventKind kind, TraceSource source,
+                           int buttons, int x, int y, int data) {
+   if (recording.load(std::memory_order_relaxed) == false)
+      return;
+
+   auto current = ring.load(std::memory_order_acquire);
+
+   if (current == nullptr)
+      return;
+
+   current->Push(TraceEvent {
+      time, kind, source, static_cast<std::uint16_t>(buttons), x, y, data
+   });
+}
+
+std::vector<TraceEvent> TraceRecorder::Snapshot() {
+   auto current = ring.load(std::memory_order_acquire);
+
+   if (current == nullptr)
+      return std::vector<TraceEvent>();
+
+   return current->Snapshot();
+}
+
+std::uint64_t TraceRecorder::Dropped() {
+   auto current = ring.load(std::memory_order_acquire);
+
+   if (current == nullptr)
+      return 0;
+
+   return current->Dropped();
+}
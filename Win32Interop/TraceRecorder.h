@@ -0,0 +1,52 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "TraceEvent.h"
+
+namespace Renfrew::Win32::Interop {
+
+   /// <summary>
+   /// The process-wide trace of injected input. Recording is off until started,
+   /// and costs a single check per event while it's off.
+   /// </summary>
+   class TraceRecorder {
+      public: static void Start(std::size_t capacity);
+      public: static void Stop();
+      public: static bool IsRecording();
+
+      /// <summary>
+      /// Gets the current trace time, in microseconds. Events sent together should
+      /// share a time, so that they're replayed together.
+      /// </summary>
+      public: static std::int64_t Now();
+
+      public: static void Record(std::int64_t time, TraceEventKind kind, TraceSource source,
+                                 int buttons, int x, int y, int data);
+
+      public: static std::vector<TraceEvent> Snapshot();
+
+      /// <summary>
+      /// Gets the number of events left out of the trace (see TraceRing::Push).
+      /// </summary>
+      public: static std::uint64_t Dropped();
+   };
+}
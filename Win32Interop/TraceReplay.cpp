@@ -0,0 +1,93 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#include "TraceReplay.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Renfrew::Win32::Interop;
+
+std::vector<std::vector<TraceEvent>> TraceReplay::Blocks(const std::vector<TraceEvent> &events) {
+   std::vector<std::vector<TraceEvent>> blocks;
+
+   for (auto &e : events) {
+      if (blocks.empty() == true || blocks.back().front().Time != e.Time)
+         blocks.emplace_back();
+
+      blocks.back().push_back(e);
+   }
+
+   return blocks;
+}
+
+TimingReport TraceReplay::MeasureTiming(const std::vector<double> &timesMs) {
+   TimingReport report { timesMs.size(), 0.0, 0.0, 0.0, 0.0 };
+
+   if (timesMs.size() < 2)
+      return report;
+
+   std::vector<double> intervals;
+
+   for (std::size_t i = 1; i < timesMs.size(); i++)
+      intervals.push_back(timesMs[i] - timesMs[i - 1]);
+
+   report.DurationMs = timesMs.back() - timesMs.front();
+   report.MeanIntervalMs = report.DurationMs / intervals.size();
+
+   double squares = 0.0;
+
+   for (auto interval : intervals) {
+      double deviation = interval - report.MeanIntervalMs;
+
+      squares += deviation * deviation;
+      report.MaxJitterMs = std::max(report.MaxJitterMs, std::abs(deviation));
+   }
+
+   report.JitterMs = std::sqrt(squares / intervals.size());
+
+   return report;
+}
+
+ReplayReport TraceReplay::Replay(const std::vector<TraceEvent> &events, InjectionBackend &backend) {
+   auto blocks = Blocks(events);
+
+   std::vector<double> recorded, replayed;
+   double maxDrift = 0.0;
+
+   double start = backend.Now();
+
+   for (auto &block : blocks) {
+      double offset = (block.front().Time - blocks.front().front().Time) / 1000.0;
+
+      backend.WaitUntil(start + offset);
+      backend.Inject(block);
+
+      double actual = backend.Now() - start;
+
+      recorded.push_back(offset);
+      replayed.push_back(actual);
+
+      maxDrift = std::max(maxDrift, std::abs(actual - offset));
+   }
+
+   return ReplayReport {
+      events.size(),
+      MeasureTiming(recorded),
+      MeasureTiming(replayed),
+      maxDrift
+   };
+}
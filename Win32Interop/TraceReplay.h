@@ -0,0 +1,89 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "TraceEvent.h"
+
+// Plain C++ (no Windows or CLR dependencies), so that it can be built and
+// tested on its own.
+
+namespace Renfrew::Win32::Interop {
+
+   /// <summary>
+   /// Where replayed input goes: the real system, or a stand-in for simulating.
+   /// </summary>
+   class InjectionBackend {
+      public: virtual ~InjectionBackend() = default;
+
+      /// <summary>
+      /// Gets the current time in milliseconds, from a monotonic clock.
+      /// </summary>
+      public: virtual double Now() = 0;
+
+      public: virtual void WaitUntil(double timeMs) = 0;
+
+      /// <summary>
+      /// Injects events that were originally sent together.
+      /// </summary>
+      public: virtual void Inject(const std::vector<TraceEvent> &events) = 0;
+   };
+
+   /// <summary>
+   /// Timing of a run of injections. Jitter is measured on the gaps between
+   /// injections, against their average.
+   /// </summary>
+   struct TimingReport {
+      std::size_t Injections;
+
+      double DurationMs;
+      double MeanIntervalMs;
+
+      // Standard deviation, and largest deviation, of the intervals
+      double JitterMs;
+      double MaxJitterMs;
+   };
+
+   struct ReplayReport {
+      std::size_t Events;
+
+      TimingReport Recorded;
+      TimingReport Replayed;
+
+      // The furthest any injection strayed from its recorded time
+      double MaxDriftMs;
+   };
+
+   class TraceReplay {
+
+      /// <summary>
+      /// Splits a trace into the blocks that were injected together (those with
+      /// the same timestamp).
+      /// </summary>
+      public: static std::vector<std::vector<TraceEvent>> Blocks(const std::vector<TraceEvent> &events);
+
+      public: static TimingReport MeasureTiming(const std::vector<double> &timesMs);
+
+      /// <summary>
+      /// Plays the trace into the backend, keeping the original spacing between
+      /// injections.
+      /// </summary>
+      public: static ReplayReport Replay(const std::vector<TraceEvent> &events, InjectionBackend &backend);
+   };
+}
@@ -0,0 +1,113 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#include "TraceRing.h"
+
+#include <cstring>
+
+using namespace Renfrew::Win32::Interop;
+
+static_assert(sizeof(TraceEvent) % sizeof(std::uint64_t) == 0, "TraceEvent must be a whole number of words");
+
+TraceRing::TraceRing(std::size_t capacity) {
+   std::size_t size = 1;
+
+   while (size < capacity)
+      size <<= 1;
+
+   _slots.reset(new Slot[size]);
+   _mask = size - 1;
+
+   for (std::size_t i = 0; i < size; i++)
+      _slots[i].Sequence.store(0, std::memory_order_relaxed);
+
+   _next.store(0, std::memory_order_relaxed);
+   _dropped.store(0, std::memory_order_relaxed);
+}
+
+std::size_t TraceRing::Capacity() const {
+   return _mask + 1;
+}
+
+void TraceRing::Push(const TraceEvent &event) {
+   auto n = _next.fetch_add(1, std::memory_order_relaxed);
+   auto &slot = _slots[n & _mask];
+
+   // Claim the slot, unless a writer a lap (or more) behind is still filling it,
+   // or a later one has already claimed it; only possible when the ring is lapped
+   // while a write is under way. Rather than wait, which would block on a writer
+   // that's been preempted, drop the event. Any older, finished event can be
+   // overwritten, even if the one just before it in the slot was dropped.
+   auto current = slot.Sequence.load(std::memory_order_relaxed);
+
+   for (;;) {
+      if ((current & 1) != 0 || current > 2 * n) {
+         _dropped.fetch_add(1, std::memory_order_relaxed);
+         return;
+      }
+
+      if (slot.Sequence.compare_exchange_weak(current, 2 * n + 1, std::memory_order_relaxed) == true)
+         break;
+   }
+
+   std::uint64_t words[EventWords];
+   std::memcpy(words, &event, sizeof(words));
+
+   // Release, so that a reader that sees any of the new words also sees the
+   // sequence go odd
+   for (std::size_t i = 0; i < EventWords; i++)
+      slot.Words[i].store(words[i], std::memory_order_release);
+
+   slot.Sequence.store(2 * (n + 1), std::memory_order_release);
+}
+
+std::uint64_t TraceRing::Dropped() const {
+   return _dropped.load(std::memory_order_relaxed);
+}
+
+std::vector<TraceEvent> TraceRing::Snapshot() const {
+   auto end = _next.load(std::memory_order_acquire);
+   auto start = end > Capacity() ? end - Capacity() : 0;
+
+   std::vector<TraceEvent> events;
+   events.reserve(static_cast<std::size_t>(end - start));
+
+   for (auto n = start; n < end; n++) {
+      auto &slot = _slots[n & _mask];
+
+      auto before = slot.Sequence.load(std::memory_order_acquire);
+
+      // Not written yet, or already overwritten by a later event
+      if (before != 2 * (n + 1))
+         continue;
+
+      std::uint64_t words[EventWords];
+
+      for (std::size_t i = 0; i < EventWords; i++)
+         words[i] = slot.Words[i].load(std::memory_order_acquire);
+
+      // Overwritten while it was being copied
+      if (slot.Sequence.load(std::memory_order_relaxed) != before)
+         continue;
+
+      TraceEvent event;
+      std::memcpy(&event, words, sizeof(event));
+
+      events.push_back(event);
+   }
+
+   return events;
+}
@@ -0,0 +1,79 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "TraceEvent.h"
+
+// Plain C++ (no Windows or CLR dependencies), so that it can be built and
+// tested on its own. Not usable from managed code (<atomic> isn't supported
+// under /clr); see TraceRecorder.
+
+namespace Renfrew::Win32::Interop {
+
+   /// <summary>
+   /// A fixed-size, lock-free ring buffer of trace events. Any number of threads
+   /// can record at once; once full, the oldest events are overwritten. Push never
+   /// waits: if the ring wraps onto a slot that another thread is still writing,
+   /// the new event is dropped (and counted) instead.
+   /// </summary>
+   class TraceRing {
+      private: static constexpr std::size_t EventWords = sizeof(TraceEvent) / sizeof(std::uint64_t);
+
+      private: struct Slot {
+
+         // Odd while the slot is being written; 2 * (n + 1) once event n is in it.
+         std::atomic<std::uint64_t> Sequence;
+
+         // The event, copied in and out a word at a time so that a reader can
+         // overlap a writer safely (it sees the sequence change, and drops it).
+         std::atomic<std::uint64_t> Words[EventWords];
+      };
+
+      private: std::unique_ptr<Slot[]> _slots;
+      private: std::size_t _mask;
+
+      private: std::atomic<std::uint64_t> _next;
+      private: std::atomic<std::uint64_t> _dropped;
+
+      /// <summary>
+      /// Capacity is rounded up to a power of two.
+      /// </summary>
+      public: explicit TraceRing(std::size_t capacity);
+
+      public: std::size_t Capacity() const;
+
+      public: void Push(const TraceEvent &event);
+
+      /// <summary>
+      /// Gets the number of events dropped because their slot was still being
+      /// written when the ring wrapped onto it.
+      /// </summary>
+      public: std::uint64_t Dropped() const;
+
+      /// <summary>
+      /// Copies out the events currently in the buffer, oldest first. Events being
+      /// written while the copy is made are skipped.
+      /// </summary>
+      public: std::vector<TraceEvent> Snapshot() const;
+   };
+}
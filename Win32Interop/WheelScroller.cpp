@@ -0,0 +1,165 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#include "stdafx.h"
+#include "FrameTimer.h"
+#include "InputThread.h"
+#include "WheelScroller.h"
+#include "Win32InteropException.h"
+
+using namespace System;
+using namespace System::Diagnostics;
+using namespace System::Threading;
+
+using namespace Renfrew::Win32::Interop;
+
+WheelScroller::WheelScroller() {
+   _lock = gcnew Object();
+   _wake = gcnew AutoResetEvent(false);
+
+   _sequence = gcnew InputSequence(2);
+
+   _animations = new std::vector<ScrollAnimation>();
+   _accumulator = new ScrollAccumulator();
+}
+
+void WheelScroller::Scroll(WheelDelta delta) {
+   if (delta.IsZero() == true)
+      return;
+
+   Monitor::Enter(_lock);
+
+   try {
+      _scrollX += delta.X;
+      _scrollY += delta.Y;
+   } finally {
+      Monitor::Exit(_lock);
+   }
+
+   InputThread::Default->InvokeAndWait(gcnew Action(this, &WheelScroller::SendScroll));
+}
+
+void WheelScroller::Scroll(WheelDelta delta, TimeSpan duration) {
+   if (delta.IsZero() == true)
+      return;
+
+   Monitor::Enter(_lock);
+
+   try {
+      _animations->push_back(
+         ScrollAnimation(delta, FrameTimer::Now(), duration.TotalMilliseconds)
+      );
+
+      if (_thread == nullptr) {
+         _thread = gcnew Thread(gcnew ThreadStart(this, &WheelScroller::Run));
+         _thread->Name = "Wheel Scroller";
+         _thread->IsBackground = true;
+         _thread->Start();
+      }
+   } finally {
+      Monitor::Exit(_lock);
+   }
+
+   _wake->Set();
+}
+
+void WheelScroller::Run() {
+   FrameTimer timer;
+
+   for (;;) {
+      _wake->WaitOne();
+
+      bool active = true;
+
+      while (active == true) {
+         WheelDelta delta;
+
+         Monitor::Enter(_lock);
+
+         try {
+            double now = FrameTimer::Now();
+
+            for (auto i = _animations->begin(); i != _animations->end(); ) {
+               if (i->Advance(now, *_accumulator) == true)
+                  i = _animations->erase(i);
+               else
+                  ++i;
+            }
+
+            active = _animations->empty() == false;
+
+            // Once the last scroll is done, send whatever is left over.
+            delta = active == true ? _accumulator->Take() : _accumulator->Flush();
+
+            _frameX += delta.X;
+            _frameY += delta.Y;
+         } finally {
+            Monitor::Exit(_lock);
+         }
+
+         if (delta.IsZero() == false)
+            InputThread::Default->InvokeAndWait(gcnew Action(this, &WheelScroller::SendFrame));
+
+         if (active == true)
+            timer.Wait(FrameTimer::DefaultInterval);
+      }
+   }
+}
+
+// Runs on the input thread. Scrolls queued behind a gesture are sent together by
+// the first one to run.
+void WheelScroller::SendScroll() {
+   Send(Take(_scrollX, _scrollY), TraceSource::Scroll);
+}
+
+// Runs on the input thread
+void WheelScroller::SendFrame() {
+   try {
+      Send(Take(_frameX, _frameY), TraceSource::SmoothScroll);
+   } catch (Win32InteropException ^e) {
+      Debug::WriteLine("WheelScroller: Could not send input: " + e->Message);
+   }
+}
+
+WheelDelta WheelScroller::Take(int %x, int %y) {
+   Monitor::Enter(_lock);
+
+   try {
+      WheelDelta delta { x, y };
+
+      x = 0;
+      y = 0;
+
+      return delta;
+   } finally {
+      Monitor::Exit(_lock);
+   }
+}
+
+// Must be called on the input thread
+void WheelScroller::Send(WheelDelta delta, TraceSource source) {
+   if (delta.IsZero() == true)
+      return;
+
+   _sequence->Clear();
+
+   if (delta.Y != 0)
+      _sequence->Wheel(delta.Y);
+   if (delta.X != 0)
+      _sequence->HorizontalWheel(delta.X);
+
+   _sequence->Send(source);
+}
@@ -0,0 +1,79 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include <vector>
+
+#include "InputSequence.h"
+#include "ScrollAccumulator.h"
+
+namespace Renfrew::Win32::Interop {
+
+   /// <summary>
+   /// Plays smooth scrolls on a background thread. Scrolls that overlap are merged,
+   /// and each frame is sent as a single wheel event per axis. Wheel events, smooth
+   /// or not, are sent from the <see cref="InputThread"/>, so that they wait for any
+   /// gesture that's playing.
+   /// </summary>
+   ref class WheelScroller sealed {
+      private: static WheelScroller ^_default;
+
+      private: System::Object ^_lock;
+      private: System::Threading::Thread ^_thread;
+      private: System::Threading::AutoResetEvent ^_wake;
+
+      // Only used on the input thread
+      private: InputSequence ^_sequence;
+
+      // Guarded by _lock
+      private: std::vector<ScrollAnimation> *_animations;
+      private: ScrollAccumulator *_accumulator;
+
+      // Waiting to be sent by the input thread (guarded by _lock)
+      private: int _scrollX;
+      private: int _scrollY;
+      private: int _frameX;
+      private: int _frameY;
+
+      static WheelScroller() {
+         _default = gcnew WheelScroller();
+      }
+
+      private: WheelScroller();
+
+      public: static property WheelScroller ^Default {
+         WheelScroller ^get() {
+            return _default;
+         }
+      }
+
+      /// <summary>
+      /// Scrolls straight away, waiting until the wheel event has been sent.
+      /// </summary>
+      public: void Scroll(WheelDelta delta);
+
+      public: void Scroll(WheelDelta delta, System::TimeSpan duration);
+
+      private: void Run();
+
+      private: void SendScroll();
+      private: void SendFrame();
+
+      private: WheelDelta Take(int %x, int %y);
+      private: void Send(WheelDelta delta, TraceSource source);
+   };
+}
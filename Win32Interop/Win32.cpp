@@ -20,6 +20,7 @@
 #include "WindowHandle.h"
 #include "Win32.h"
 #include "Win32InteropException.h"
+#include "WindowTracker.h"
 
 using namespace System;
 using namespace Renfrew::Win32::Interop;
@@ -55,12 +56,38 @@ void Win32::SetForegroundWindow(WindowHandle ^handle) {
 }
 
 WindowHandle ^Win32::WindowFromPoint(int x, int y) {
-   POINT p = { x, y };
+   HWND hWnd = WindowTracker::Instance().WindowFromPoint(x, y);
 
-   HWND hWnd = ::WindowFromPoint(p);
+   // Nothing tracked there (the desktop, most likely); ask the system.
+   if (hWnd == nullptr) {
+      POINT p = { x, y };
+      hWnd = ::WindowFromPoint(p);
+   }
 
    if (hWnd == nullptr)
       return nullptr;
 
-   return gcnew WindowHandle(hWnd);
+   return GetHandle(hWnd);
+}
+
+array<WindowHandle ^> ^Win32::WindowsInRectangle(int x, int y, int width, int height) {
+   auto windows = WindowTracker::Instance().WindowsInRect(
+      DesktopRect { x, y, x + width, y + height }
+   );
+
+   auto handles = gcnew array<WindowHandle ^>(static_cast<int>(windows.size()));
+
+   for (int i = 0; i < handles->Length; i++)
+      handles[i] = GetHandle(windows[i]);
+
+   return handles;
+}
+
+WindowHandle ^Win32::GetHandle(HWND hWnd) {
+   auto last = _lastWindow;
+
+   if (last != nullptr && last->Hwnd == hWnd)
+      return last;
+
+   return _lastWindow = gcnew WindowHandle(hWnd);
 }
@@ -19,10 +19,25 @@
 
 namespace Renfrew::Win32::Interop {
    public ref class Win32 abstract {
+      // The last window handed out, so repeated hit tests over the same window
+      // don't allocate a new handle every time
+      private: static WindowHandle ^_lastWindow;
+
       public: static void BringWindowToTop(WindowHandle ^handle);
       public: static void SetActiveWindow(WindowHandle ^handle);
       public: static void SetForegroundWindow(WindowHandle ^handle);
 
+      /// <summary>
+      /// Gets the top-level window at the given point. Other windows belonging to
+      /// this application are ignored.
+      /// </summary>
       public: static WindowHandle ^WindowFromPoint(int x, int y);
+
+      /// <summary>
+      /// Gets the top-level windows that overlap the given rectangle, topmost first.
+      /// </summary>
+      public: static array<WindowHandle ^> ^WindowsInRectangle(int x, int y, int width, int height);
+
+      private: static WindowHandle ^GetHandle(HWND hWnd);
    };
 }
\ No newline at end of file
@@ -0,0 +1,178 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#include "WindowIndex.h"
+
+#include <algorithm>
+
+using namespace Renfrew::Win32::Interop;
+
+WindowIndex::WindowIndex(int cellSize) {
+   _cellSize = cellSize > 0 ? cellSize : DefaultCellSize;
+}
+
+void WindowIndex::Rebuild(const std::vector<Entry> &windows) {
+   _slots.clear();
+   _slotsById.clear();
+   _cells.clear();
+
+   for (auto &window : windows) {
+
+      // Only the topmost copy of a window counts
+      if (_slotsById.count(window.Id) != 0)
+         continue;
+
+      _slots.push_back(Slot { window.Id, window.Bounds, _slots.size() });
+      _slotsById[window.Id] = _slots.size() - 1;
+
+      Insert(_slots.size() - 1);
+   }
+}
+
+bool WindowIndex::Update(WindowId id, const DesktopRect &bounds) {
+   auto i = _slotsById.find(id);
+
+   if (i == _slotsById.end())
+      return false;
+
+   Erase(i->second);
+   _slots[i->second].Bounds = bounds;
+   Insert(i->second);
+
+   return true;
+}
+
+bool WindowIndex::Remove(WindowId id) {
+   auto i = _slotsById.find(id);
+
+   if (i == _slotsById.end())
+      return false;
+
+   // The slot itself is left in place (so the others keep their indexes) until
+   // the next rebuild; it just can't be found any more.
+   Erase(i->second);
+   _slotsById.erase(i);
+
+   return true;
+}
+
+std::size_t WindowIndex::Count() const {
+   return _slotsById.size();
+}
+
+WindowIndex::WindowId WindowIndex::TopmostAt(int x, int y) const {
+   auto cell = _cells.find(CellKey(CellOf(x), CellOf(y)));
+
+   if (cell == _cells.end())
+      return 0;
+
+   const Slot *topmost = nullptr;
+
+   for (auto index : cell->second) {
+      auto &slot = _slots[index];
+
+      if (slot.Bounds.Contains(x, y) == true && (topmost == nullptr || slot.ZOrder < topmost->ZOrder))
+         topmost = &slot;
+   }
+
+   return topmost != nullptr ? topmost->Id : 0;
+}
+
+std::vector<WindowIndex::WindowId> WindowIndex::Intersecting(const DesktopRect &rect) const {
+   std::vector<std::size_t> found;
+
+   if (rect.Right <= rect.Left || rect.Bottom <= rect.Top)
+      return std::vector<WindowId>();
+
+   for (int row = CellOf(rect.Top); row <= CellOf(rect.Bottom - 1); row++) {
+      for (int column = CellOf(rect.Left); column <= CellOf(rect.Right - 1); column++) {
+         auto cell = _cells.find(CellKey(column, row));
+
+         if (cell == _cells.end())
+            continue;
+
+         for (auto index : cell->second) {
+            if (Overlaps(_slots[index].Bounds, rect) == true)
+               found.push_back(index);
+         }
+      }
+   }
+
+   // Slots are numbered in z-order, and a window spanning several cells is found
+   // once per cell.
+   std::sort(found.begin(), found.end(), [this](std::size_t a, std::size_t b) {
+      return _slots[a].ZOrder < _slots[b].ZOrder;
+   });
+   found.erase(std::unique(found.begin(), found.end()), found.end());
+
+   std::vector<WindowId> ids;
+   ids.reserve(found.size());
+
+   for (auto index : found)
+      ids.push_back(_slots[index].Id);
+
+   return ids;
+}
+
+void WindowIndex::Insert(std::size_t slot) {
+   auto &bounds = _slots[slot].Bounds;
+
+   if (bounds.Right <= bounds.Left || bounds.Bottom <= bounds.Top)
+      return;
+
+   for (int row = CellOf(bounds.Top); row <= CellOf(bounds.Bottom - 1); row++) {
+      for (int column = CellOf(bounds.Left); column <= CellOf(bounds.Right - 1); column++)
+         _cells[CellKey(column, row)].push_back(slot);
+   }
+}
+
+void WindowIndex::Erase(std::size_t slot) {
+   auto &bounds = _slots[slot].Bounds;
+
+   if (bounds.Right <= bounds.Left || bounds.Bottom <= bounds.Top)
+      return;
+
+   for (int row = CellOf(bounds.Top); row <= CellOf(bounds.Bottom - 1); row++) {
+      for (int column = CellOf(bounds.Left); column <= CellOf(bounds.Right - 1); column++) {
+         auto cell = _cells.find(CellKey(column, row));
+
+         if (cell == _cells.end())
+            continue;
+
+         auto &slots = cell->second;
+         slots.erase(std::remove(slots.begin(), slots.end(), slot), slots.end());
+
+         if (slots.empty() == true)
+            _cells.erase(cell);
+      }
+   }
+}
+
+int WindowIndex::CellOf(int coordinate) const {
+
+   // Round towards negative infinity, for monitors left of or above the primary
+   return coordinate >= 0 ?
+      coordinate / _cellSize :
+      -((-coordinate + _cellSize - 1) / _cellSize);
+}
+
+std::int64_t WindowIndex::CellKey(int column, int row) {
+   return (static_cast<std::int64_t>(column) << 32) | static_cast<std::uint32_t>(row);
+}
+
+bool WindowIndex::Overlaps(const DesktopRect &a, const DesktopRect &b) {
+   return a.Left < b.Right && b.Left < a.Right && a.Top < b.Bottom && b.Top < a.Bottom;
+}
@@ -0,0 +1,92 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "DesktopTopology.h"
+
+// Plain C++ (no Windows or CLR dependencies), so that it can be built and
+// tested on its own.
+
+namespace Renfrew::Win32::Interop {
+
+   /// <summary>
+   /// A spatial index of window rectangles, for answering "which window is at this
+   /// point" without asking the system. Windows are bucketed into a uniform grid,
+   /// and each keeps its place in the z-order so overlaps resolve to the topmost.
+   /// </summary>
+   class WindowIndex {
+      public: using WindowId = std::uintptr_t;
+
+      public: struct Entry {
+         WindowId Id;
+         DesktopRect Bounds;
+      };
+
+      public: static constexpr int DefaultCellSize = 256;
+
+      private: struct Slot {
+         WindowId Id;
+         DesktopRect Bounds;
+         std::size_t ZOrder;
+      };
+
+      private: int _cellSize;
+
+      private: std::vector<Slot> _slots;
+      private: std::unordered_map<WindowId, std::size_t> _slotsById;
+      private: std::unordered_map<std::int64_t, std::vector<std::size_t>> _cells;
+
+      public: explicit WindowIndex(int cellSize = DefaultCellSize);
+
+      /// <summary>
+      /// Replaces the contents of the index. Windows are given topmost first.
+      /// </summary>
+      public: void Rebuild(const std::vector<Entry> &windows);
+
+      /// <summary>
+      /// Moves or resizes a window, keeping its place in the z-order.
+      /// </summary>
+      /// <returns>false if the window isn't in the index.</returns>
+      public: bool Update(WindowId id, const DesktopRect &bounds);
+
+      public: bool Remove(WindowId id);
+
+      public: std::size_t Count() const;
+
+      /// <summary>
+      /// Gets the topmost window containing the point, or 0 if there isn't one.
+      /// </summary>
+      public: WindowId TopmostAt(int x, int y) const;
+
+      /// <summary>
+      /// Gets the windows that overlap the rectangle, topmost first.
+      /// </summary>
+      public: std::vector<WindowId> Intersecting(const DesktopRect &rect) const;
+
+      private: void Insert(std::size_t slot);
+      private: void Erase(std::size_t slot);
+
+      private: int CellOf(int coordinate) const;
+      private: static std::int64_t CellKey(int column, int row);
+      private: static bool Overlaps(const DesktopRect &a, const DesktopRect &b);
+   };
+}
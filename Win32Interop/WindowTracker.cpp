@@ -0,0 +1,213 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#include "stdafx.h"
+#include "WindowTracker.h"
+
+#include <thread>
+
+using namespace Renfrew::Win32::Interop;
+
+// From dwmapi.h; loaded at run time, so that the library doesn't need linking in
+typedef HRESULT (WINAPI *DwmGetWindowAttributeProc)(HWND, DWORD, PVOID, DWORD);
+
+static const DWORD DWMWA_CLOAKED_VALUE = 14;
+
+WindowTracker::WindowTracker() {
+   InitializeSRWLock(&_lock);
+
+   _threadId = 0;
+   _refreshPending = 0;
+
+   // Take the first snapshot up front, so the index is usable straight away.
+   Refresh();
+
+   std::thread(&WindowTracker::Run, this).detach();
+}
+
+WindowTracker &WindowTracker::Instance() {
+   static WindowTracker tracker;
+   return tracker;
+}
+
+HWND WindowTracker::WindowFromPoint(int x, int y) {
+   AcquireSRWLockShared(&_lock);
+   auto id = _index.TopmostAt(x, y);
+   ReleaseSRWLockShared(&_lock);
+
+   return reinterpret_cast<HWND>(id);
+}
+
+std::vector<HWND> WindowTracker::WindowsInRect(const DesktopRect &rect) {
+   AcquireSRWLockShared(&_lock);
+   auto ids = _index.Intersecting(rect);
+   ReleaseSRWLockShared(&_lock);
+
+   std::vector<HWND> windows;
+   windows.reserve(ids.size());
+
+   for (auto id : ids)
+      windows.push_back(reinterpret_cast<HWND>(id));
+
+   return windows;
+}
+
+void WindowTracker::Run() {
+   _threadId = GetCurrentThreadId();
+
+   // Make sure the thread has a message queue before anything is posted to it
+   MSG msg;
+   PeekMessageW(&msg, nullptr, WM_USER, WM_USER, PM_NOREMOVE);
+
+   HWINEVENTHOOK hooks[] = {
+      SetWinEventHook(EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_FOREGROUND,
+                      nullptr, OnWinEvent, 0, 0, WINEVENT_OUTOFCONTEXT),
+      SetWinEventHook(EVENT_SYSTEM_MINIMIZESTART, EVENT_SYSTEM_MINIMIZEEND,
+                      nullptr, OnWinEvent, 0, 0, WINEVENT_OUTOFCONTEXT),
+      SetWinEventHook(EVENT_OBJECT_DESTROY, EVENT_OBJECT_HIDE,
+                      nullptr, OnWinEvent, 0, 0, WINEVENT_OUTOFCONTEXT),
+      SetWinEventHook(EVENT_OBJECT_REORDER, EVENT_OBJECT_REORDER,
+                      nullptr, OnWinEvent, 0, 0, WINEVENT_OUTOFCONTEXT),
+      SetWinEventHook(EVENT_OBJECT_LOCATIONCHANGE, EVENT_OBJECT_LOCATIONCHANGE,
+                      nullptr, OnWinEvent, 0, 0, WINEVENT_OUTOFCONTEXT),
+      SetWinEventHook(EVENT_OBJECT_CLOAKED, EVENT_OBJECT_UNCLOAKED,
+                      nullptr, OnWinEvent, 0, 0, WINEVENT_OUTOFCONTEXT)
+   };
+
+   // Anything that changed between the first snapshot and the hooks going in
+   RequestRefresh();
+
+   while (GetMessageW(&msg, nullptr, 0, 0) > 0) {
+      if (msg.hwnd == nullptr && msg.message == WM_REFRESH) {
+         InterlockedExchange(&_refreshPending, 0);
+         Refresh();
+         continue;
+      }
+
+      TranslateMessage(&msg);
+      DispatchMessageW(&msg);
+   }
+
+   for (auto hook : hooks) {
+      if (hook != nullptr)
+         UnhookWinEvent(hook);
+   }
+}
+
+void WindowTracker::Refresh() {
+   std::vector<WindowIndex::Entry> windows;
+
+   // EnumWindows lists top-level windows in z-order, topmost first.
+   EnumWindows([](HWND hWnd, LPARAM data) -> BOOL {
+      DesktopRect bounds;
+
+      if (IsTracked(hWnd) == true && GetBounds(hWnd, bounds) == true) {
+         reinterpret_cast<std::vector<WindowIndex::Entry> *>(data)->push_back(
+            WindowIndex::Entry { reinterpret_cast<WindowIndex::WindowId>(hWnd), bounds }
+         );
+      }
+
+      return TRUE;
+   }, reinterpret_cast<LPARAM>(&windows));
+
+   AcquireSRWLockExclusive(&_lock);
+   _index.Rebuild(windows);
+   ReleaseSRWLockExclusive(&_lock);
+}
+
+void WindowTracker::RequestRefresh() {
+
+   // Bursts of events (a window being dragged about, say) collapse into a single
+   // refresh, done once the thread has caught up with its message queue.
+   if (InterlockedExchange(&_refreshPending, 1) == 0)
+      PostThreadMessageW(_threadId, WM_REFRESH, 0, 0);
+}
+
+void WindowTracker::UpdateWindow(HWND hWnd) {
+   DesktopRect bounds;
+
+   if (GetBounds(hWnd, bounds) == false) {
+      RequestRefresh();
+      return;
+   }
+
+   AcquireSRWLockExclusive(&_lock);
+   bool updated = _index.Update(reinterpret_cast<WindowIndex::WindowId>(hWnd), bounds);
+   ReleaseSRWLockExclusive(&_lock);
+
+   // A window we weren't tracking may have just become visible
+   if (updated == false && IsTracked(hWnd) == true)
+      RequestRefresh();
+}
+
+bool WindowTracker::IsTracked(HWND hWnd) {
+   static auto getWindowAttribute = reinterpret_cast<DwmGetWindowAttributeProc>(
+      GetProcAddress(LoadLibraryW(L"dwmapi.dll"), "DwmGetWindowAttribute")
+   );
+
+   if (IsWindowVisible(hWnd) == FALSE || IsIconic(hWnd) == TRUE)
+      return false;
+
+   // Clicks go straight through transparent windows, so they can't be hit.
+   if ((GetWindowLongW(hWnd, GWL_EXSTYLE) & WS_EX_TRANSPARENT) != 0)
+      return false;
+
+   DWORD processId = 0;
+   GetWindowThreadProcessId(hWnd, &processId);
+
+   if (processId == GetCurrentProcessId())
+      return false;
+
+   // Suspended store apps and windows on other virtual desktops are "cloaked":
+   // visible as far as the window manager goes, but not on screen.
+   DWORD cloaked = 0;
+
+   if (getWindowAttribute != nullptr)
+      getWindowAttribute(hWnd, DWMWA_CLOAKED_VALUE, &cloaked, sizeof(cloaked));
+
+   return cloaked == 0;
+}
+
+bool WindowTracker::GetBounds(HWND hWnd, DesktopRect &bounds) {
+   RECT rect;
+
+   if (GetWindowRect(hWnd, &rect) == FALSE)
+      return false;
+
+   bounds = DesktopRect { rect.left, rect.top, rect.right, rect.bottom };
+   return true;
+}
+
+void CALLBACK WindowTracker::OnWinEvent(HWINEVENTHOOK hook, DWORD event, HWND hWnd,
+                                        LONG idObject, LONG idChild,
+                                        DWORD eventThread, DWORD eventTime) {
+
+   // Only the windows themselves, not the controls and cursors inside them
+   if (idObject != OBJID_WINDOW || idChild != CHILDID_SELF || hWnd == nullptr)
+      return;
+
+   if (GetAncestor(hWnd, GA_ROOT) != hWnd)
+      return;
+
+   auto &tracker = Instance();
+
+   // A plain move or resize can be patched in place; anything else may have
+   // changed the z-order, so take a fresh snapshot.
+   if (event == EVENT_OBJECT_LOCATIONCHANGE)
+      tracker.UpdateWindow(hWnd);
+   else
+      tracker.RequestRefresh();
+}
@@ -0,0 +1,61 @@
+// Project Renfrew
+// Copyright(C) 2018 Stephen Workman (workman.stephen@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.If not, see<http://www.gnu.org/licenses/>.
+//
+#pragma once
+
+#include <vector>
+
+#include "WindowIndex.h"
+
+namespace Renfrew::Win32::Interop {
+
+   /// <summary>
+   /// Keeps a <see cref="WindowIndex"/> of the visible top-level windows up to date,
+   /// using WinEvent hooks on a thread of its own. Windows belonging to this process
+   /// (the plot grid and friends) are left out.
+   /// </summary>
+   class WindowTracker {
+      private: static const UINT WM_REFRESH = WM_APP + 1;
+
+      private: SRWLOCK _lock;
+      private: WindowIndex _index;
+
+      private: DWORD _threadId;
+      private: volatile LONG _refreshPending;
+
+      private: WindowTracker();
+
+      public: WindowTracker(const WindowTracker &) = delete;
+      public: WindowTracker &operator =(const WindowTracker &) = delete;
+
+      public: static WindowTracker &Instance();
+
+      public: HWND WindowFromPoint(int x, int y);
+      public: std::vector<HWND> WindowsInRect(const DesktopRect &rect);
+
+      private: void Run();
+      private: void Refresh();
+      private: void RequestRefresh();
+      private: void UpdateWindow(HWND hWnd);
+
+      private: static bool IsTracked(HWND hWnd);
+      private: static bool GetBounds(HWND hWnd, DesktopRect &bounds);
+
+      private: static void CALLBACK OnWinEvent(HWINEVENTHOOK hook, DWORD event, HWND hWnd,
+                                               LONG idObject, LONG idChild,
+                                               DWORD eventThread, DWORD eventTime);
+   };
+}